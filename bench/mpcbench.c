@@ -0,0 +1,421 @@
+/* mpcbench -- measure the speed of the GNU MPC functions
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* For each selected function, precision and input distribution, mpcbench
+   draws a number of random inputs with test_default_random, measures the
+   processor time of one call on each of them, and prints the mean, minimum
+   and maximum over the inputs, in nanoseconds, as CSV or JSON.
+   Run "mpcbench -h" for the options; the random seed may be changed
+   through GMP_CHECK_RANDOMIZE as in the test suite.                     */
+
+#include <string.h>
+#include <time.h>
+#include "mpc-tests.h"
+
+#define MAX_FUNCTIONS 64
+#define MAX_PRECISIONS 32
+
+static const char *default_precisions = "53,113,1000,10000,100000";
+static const char *default_distributions = "unit";
+
+/* input distributions, given by the parameters of test_default_random;
+   the imaginary parts are then divided by 2^spread, and if orthogonal is
+   non-zero, the second operand is replaced by i times the first one with
+   its real part changed by one ulp, so that the real part of the first
+   operand times the conjugate of the second one nearly cancels, as in the
+   numerator of a division */
+typedef struct {
+   const char *name;
+   mpfr_exp_t emin, emax;
+   unsigned int zero_probability;
+   mpfr_exp_t spread;
+   int orthogonal;
+} distribution_t;
+
+static const distribution_t distributions [] = {
+   {"unit", -1, 1, 0, 0, 0},      /* exponents of both parts in [-1, 1] */
+   {"wide", -100, 100, 0, 0, 0},  /* exponents of both parts in [-100, 100] */
+   {"zero", -1, 1, 64, 0, 0},     /* a zero part with probability 1/4 */
+   {"spread10", -1, 1, 0, 10, 0}, /* parts differing by about 2^10 */
+   {"spread100", -1, 1, 0, 100, 0},
+   {"spread1000", -1, 1, 0, 1000, 0},
+   {"orthogonal", -1, 1, 0, 0, 1} /* nearly cancelling x*conj(y) */
+};
+#define N_DISTRIBUTIONS \
+   ((int) (sizeof (distributions) / sizeof (distributions [0])))
+
+static mpc_function functions [MAX_FUNCTIONS];
+static int n_functions;
+
+/* the string read by bench_strtoc */
+static char *bench_string;
+
+
+/* wrappers for functions without a type of mpc-tests.h */
+static int
+bench_pow_ui (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   return mpc_pow_ui (rop, op, 1234567ul, rnd);
+}
+
+static int
+bench_fmma (mpc_ptr rop, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+            mpc_rnd_t rnd)
+{
+   return mpc_fmma (rop, a, b, c, a, rnd);
+}
+
+/* a+b+c and a*b+c*a with a single rounding, to be compared with add and
+   with fma and fmma */
+static int
+bench_sum (mpc_ptr rop, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+           mpc_rnd_t rnd)
+{
+   mpc_ptr t [3];
+
+   t [0] = (mpc_ptr) a;
+   t [1] = (mpc_ptr) b;
+   t [2] = (mpc_ptr) c;
+   return mpc_sum (rop, t, 3, rnd);
+}
+
+static int
+bench_dot (mpc_ptr rop, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+           mpc_rnd_t rnd)
+{
+   mpc_ptr t [2], u [2];
+
+   t [0] = (mpc_ptr) a;
+   t [1] = (mpc_ptr) c;
+   u [0] = (mpc_ptr) b;
+   u [1] = (mpc_ptr) a;
+   return mpc_dot (rop, t, u, 2, rnd);
+}
+
+static int
+bench_get_str (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   char *s = mpc_get_str (10, 0, op, rnd);
+
+   (void) rop;
+   mpc_free_str (s);
+   return 0;
+}
+
+static int
+bench_strtoc (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   (void) op;
+   return mpc_strtoc (rop, bench_string, NULL, 10, rnd);
+}
+
+
+#define BENCH_FUNC(_ftype, _func, _name)                 \
+   do {                                                  \
+      functions [n_functions].pointer._ftype = _func;    \
+      functions [n_functions].type = _ftype;             \
+      functions [n_functions].name = _name;              \
+      functions [n_functions].properties = FUNC_PROP_NONE; \
+      n_functions++;                                     \
+   } while (0)
+
+static void
+init_functions (void)
+{
+   n_functions = 0;
+   BENCH_FUNC (C_CC, mpc_add, "add");
+   BENCH_FUNC (C_CC, mpc_sub, "sub");
+   BENCH_FUNC (C_CC, mpc_mul, "mul");
+   BENCH_FUNC (CC, mpc_sqr, "sqr");
+   BENCH_FUNC (C_CC, mpc_div, "div");
+   BENCH_FUNC (CC, mpc_inv, "inv");
+   BENCH_FUNC (CCCC, mpc_fma, "fma");
+   BENCH_FUNC (CCCC, bench_fmma, "fmma");
+   BENCH_FUNC (CCCC, bench_sum, "sum");
+   BENCH_FUNC (CCCC, bench_dot, "dot");
+   BENCH_FUNC (FC, mpc_norm, "norm");
+   BENCH_FUNC (FC, mpc_abs, "abs");
+   BENCH_FUNC (FC, mpc_arg, "arg");
+   BENCH_FUNC (CC, mpc_sqrt, "sqrt");
+   BENCH_FUNC (CC, mpc_exp, "exp");
+   BENCH_FUNC (CC, mpc_log, "log");
+   BENCH_FUNC (CC, mpc_log10, "log10");
+   BENCH_FUNC (C_CC, mpc_pow, "pow");
+   BENCH_FUNC (CC, bench_pow_ui, "pow_ui");
+   BENCH_FUNC (CC, mpc_sin, "sin");
+   BENCH_FUNC (CC, mpc_cos, "cos");
+   BENCH_FUNC (CC_C, mpc_sin_cos, "sin_cos");
+   BENCH_FUNC (CC, mpc_tan, "tan");
+   BENCH_FUNC (CC, mpc_sinh, "sinh");
+   BENCH_FUNC (CC, mpc_cosh, "cosh");
+   BENCH_FUNC (CC, mpc_tanh, "tanh");
+   BENCH_FUNC (CC, mpc_asin, "asin");
+   BENCH_FUNC (CC, mpc_acos, "acos");
+   BENCH_FUNC (CC, mpc_atan, "atan");
+   BENCH_FUNC (CC, mpc_asinh, "asinh");
+   BENCH_FUNC (CC, mpc_acosh, "acosh");
+   BENCH_FUNC (CC, mpc_atanh, "atanh");
+   BENCH_FUNC (C_CC, mpc_agm, "agm");
+   BENCH_FUNC (CC, mpc_agm1, "agm1");
+   BENCH_FUNC (CC, mpc_elliptic_k, "elliptic_k");
+   BENCH_FUNC (CC, mpc_elliptic_e, "elliptic_e");
+   BENCH_FUNC (CC, bench_get_str, "get_str");
+   BENCH_FUNC (CC, bench_strtoc, "strtoc");
+}
+
+
+static void
+usage (void)
+{
+   int i;
+
+   printf ("Usage: mpcbench [options]\n");
+   printf ("  -f f1,f2,...  functions to measure (default: all)\n");
+   printf ("  -p p1,p2,...  precisions in bits (default: %s)\n",
+           default_precisions);
+   printf ("  -d d1,d2,...  input distributions (default: %s)\n",
+           default_distributions);
+   printf ("  -s n          number of random inputs (default: 5)\n");
+   printf ("  -t seconds    minimal measuring time per input (default: 0.01)\n");
+   printf ("  -o csv|json   output format (default: csv)\n");
+   printf ("Functions:");
+   for (i = 0; i < n_functions; i++)
+      printf (" %s", functions [i].name);
+   printf ("\nDistributions:");
+   for (i = 0; i < N_DISTRIBUTIONS; i++)
+      printf (" %s", distributions [i].name);
+   printf ("\n");
+}
+
+
+/* returns non-zero if name occurs in the comma separated list */
+static int
+in_list (const char *name, const char *list)
+{
+   size_t len = strlen (name);
+   const char *p = list;
+
+   while (p != NULL) {
+      if (strncmp (p, name, len) == 0 && (p [len] == ',' || p [len] == '\0'))
+         return 1;
+      p = strchr (p, ',');
+      if (p != NULL)
+         p++;
+   }
+   return 0;
+}
+
+
+/* calls f once on the given variables */
+static void
+call (const mpc_function *f, mpc_ptr z, mpc_ptr z2, mpfr_ptr r,
+      mpc_srcptr x, mpc_srcptr y, mpc_srcptr w)
+{
+   switch (f->type) {
+   case FC:
+      f->pointer.FC (r, x, MPFR_RNDN);
+      break;
+   case CC:
+      f->pointer.CC (z, x, MPC_RNDNN);
+      break;
+   case C_CC:
+      f->pointer.C_CC (z, x, y, MPC_RNDNN);
+      break;
+   case CCCC:
+      f->pointer.CCCC (z, x, y, w, MPC_RNDNN);
+      break;
+   case CC_C:
+      f->pointer.CC_C (z, z2, x, MPC_RNDNN, MPC_RNDNN);
+      break;
+   default:
+      fprintf (stderr, "mpcbench: unhandled function type\n");
+      exit (1);
+   }
+}
+
+
+/* returns the processor time in nanoseconds of one call of f */
+static double
+time_call (const mpc_function *f, double min_time, mpc_ptr z, mpc_ptr z2,
+           mpfr_ptr r, mpc_srcptr x, mpc_srcptr y, mpc_srcptr w)
+{
+   clock_t start, elapsed;
+   long n, i;
+
+   for (n = 1; ; n *= 2) {
+      start = clock ();
+      for (i = 0; i < n; i++)
+         call (f, z, z2, r, x, y, w);
+      elapsed = clock () - start;
+      if ((double) elapsed >= min_time * CLOCKS_PER_SEC)
+         return 1e9 * (double) elapsed / CLOCKS_PER_SEC / (double) n;
+   }
+}
+
+
+static void
+bench (const mpc_function *f, mpfr_prec_t prec, const distribution_t *d,
+       int samples, double min_time, int json, int *first)
+{
+   mpc_t x, y, w, z, z2;
+   mpfr_t r;
+   double t, sum, min, max;
+   int i;
+
+   mpc_init2 (x, prec);
+   mpc_init2 (y, prec);
+   mpc_init2 (w, prec);
+   mpc_init2 (z, prec);
+   mpc_init2 (z2, prec);
+   mpfr_init2 (r, prec);
+
+   sum = max = 0;
+   min = -1;
+   for (i = 0; i < samples; i++) {
+      test_default_random (x, d->emin, d->emax, 128, d->zero_probability);
+      test_default_random (y, d->emin, d->emax, 128, d->zero_probability);
+      test_default_random (w, d->emin, d->emax, 128, d->zero_probability);
+      if (d->spread != 0) {
+         mpfr_div_2si (mpc_imagref (x), mpc_imagref (x), d->spread, MPFR_RNDN);
+         mpfr_div_2si (mpc_imagref (y), mpc_imagref (y), d->spread, MPFR_RNDN);
+         mpfr_div_2si (mpc_imagref (w), mpc_imagref (w), d->spread, MPFR_RNDN);
+      }
+      if (d->orthogonal) {
+         mpc_mul_i (y, x, 1, MPC_RNDNN);
+         mpfr_nextabove (mpc_realref (y));
+      }
+      if (f->pointer.CC == bench_strtoc)
+         bench_string = mpc_get_str (10, 0, x, MPC_RNDNN);
+      t = time_call (f, min_time, z, z2, r, x, y, w);
+      if (f->pointer.CC == bench_strtoc)
+         mpc_free_str (bench_string);
+      sum += t;
+      if (min < 0 || t < min)
+         min = t;
+      if (t > max)
+         max = t;
+   }
+
+   if (json)
+      printf ("%s\n    {\"function\": \"%s\", \"precision\": %lu, "
+              "\"distribution\": \"%s\", \"samples\": %i, "
+              "\"mean_ns\": %.1f, \"min_ns\": %.1f, \"max_ns\": %.1f}",
+              (*first ? "" : ","), f->name, (unsigned long) prec, d->name,
+              samples, sum / samples, min, max);
+   else
+      printf ("%s,%s,%s,%s,%lu,%s,%i,%.1f,%.1f,%.1f\n",
+              mpc_get_version (), gmp_version, mpfr_get_version (),
+              f->name, (unsigned long) prec, d->name, samples,
+              sum / samples, min, max);
+   fflush (stdout);
+   *first = 0;
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+   mpc_clear (z);
+   mpc_clear (z2);
+   mpfr_clear (r);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+   const char *function_list = NULL, *precision_list = default_precisions,
+      *distribution_list = default_distributions, *p;
+   mpfr_prec_t precisions [MAX_PRECISIONS];
+   int n_precisions, samples = 5, json = 0, first = 1, i, j, k;
+   double min_time = 0.01;
+
+   init_functions ();
+
+   for (i = 1; i < argc; i++) {
+      if (strcmp (argv [i], "-h") == 0) {
+         usage ();
+         return 0;
+      }
+      else if (i + 1 < argc && strcmp (argv [i], "-f") == 0)
+         function_list = argv [++i];
+      else if (i + 1 < argc && strcmp (argv [i], "-p") == 0)
+         precision_list = argv [++i];
+      else if (i + 1 < argc && strcmp (argv [i], "-d") == 0)
+         distribution_list = argv [++i];
+      else if (i + 1 < argc && strcmp (argv [i], "-s") == 0)
+         samples = atoi (argv [++i]);
+      else if (i + 1 < argc && strcmp (argv [i], "-t") == 0)
+         min_time = atof (argv [++i]);
+      else if (i + 1 < argc && strcmp (argv [i], "-o") == 0) {
+         i++;
+         if (strcmp (argv [i], "json") == 0)
+            json = 1;
+         else if (strcmp (argv [i], "csv") != 0) {
+            usage ();
+            return 1;
+         }
+      }
+      else {
+         usage ();
+         return 1;
+      }
+   }
+
+   n_precisions = 0;
+   for (p = precision_list; p != NULL && n_precisions < MAX_PRECISIONS; ) {
+      long prec = atol (p);
+      if (prec < MPFR_PREC_MIN || prec > MPFR_PREC_MAX) {
+         fprintf (stderr, "mpcbench: invalid precision %ld\n", prec);
+         return 1;
+      }
+      precisions [n_precisions++] = (mpfr_prec_t) prec;
+      p = strchr (p, ',');
+      if (p != NULL)
+         p++;
+   }
+   if (samples < 1 || min_time < 0) {
+      usage ();
+      return 1;
+   }
+
+   test_start ();
+
+   if (json)
+      printf ("{\"mpc\": \"%s\", \"gmp\": \"%s\", \"mpfr\": \"%s\", "
+              "\"results\": [", mpc_get_version (), gmp_version,
+              mpfr_get_version ());
+   else
+      printf ("mpc,gmp,mpfr,function,precision,distribution,samples,"
+              "mean_ns,min_ns,max_ns\n");
+
+   for (i = 0; i < n_functions; i++)
+      if (function_list == NULL || in_list (functions [i].name, function_list))
+         for (j = 0; j < n_precisions; j++)
+            for (k = 0; k < N_DISTRIBUTIONS; k++)
+               if (in_list (distributions [k].name, distribution_list))
+                  bench (functions + i, precisions [j], distributions + k,
+                         samples, min_time, json, &first);
+
+   if (json)
+      printf ("\n]}\n");
+
+   test_end ();
+
+   return 0;
+}
@@ -0,0 +1,184 @@
+/* mpcreplay -- re-execute the calls of a binary trace
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* "mpcreplay file" calls each function of a trace written with
+   MPC_LOG_TRACE (see src/logging.c) again with the same arguments,
+   precisions and rounding modes, checks that the results and return
+   values are identical to the recorded ones and measures the time of
+   each call. Differences are reported on stderr. On stdout, it prints
+   for each function as CSV the number of calls, the number of differing
+   results, the total time recorded in the trace, the total time of the
+   replay, both in nanoseconds, and their quotient; a quotient above 1
+   means that the current library is faster than the traced one.
+   With "-t seconds", each call is repeated for at least the given time,
+   which gives more accurate timings for fast functions.
+   The exit status is 1 if some result differs.                         */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "trace.h"
+#include "mpc-tests.h"
+
+typedef struct {
+   const char *name;
+   const char *type;
+   int (*f) (trace_arg_t *, const trace_call_t *);
+      /* calls the function with the arguments of the trace call and the
+         given results */
+} replay_func_t;
+
+/* replay_funcs, generated by tools/logging like the logging wrappers */
+#include "replay-func.h"
+
+#define N_FUNCS (sizeof (replay_funcs) / sizeof (replay_func_t))
+
+/* returns the index of the function called name with the given trace
+   type in replay_funcs, or -1 */
+static int
+find_function (const char *name, const char *type)
+{
+   int i;
+
+   for (i = 0; i < (int) N_FUNCS; i++)
+      if (   strcmp (replay_funcs [i].name, name) == 0
+          && strcmp (replay_funcs [i].type, type) == 0)
+         return i;
+   return -1;
+}
+
+/* returns a time stamp in nanoseconds */
+static double
+time_ns (void)
+{
+#if defined (HAVE_CLOCK_GETTIME) && defined (CLOCK_MONOTONIC)
+   struct timespec t;
+
+   clock_gettime (CLOCK_MONOTONIC, &t);
+   return 1e9 * (double) t.tv_sec + (double) t.tv_nsec;
+#else
+   return 1e9 * (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
+
+/* re-executes c, stores the time of one call in nanoseconds in *t and
+   returns 1 if the results are the recorded ones, 0 otherwise */
+static int
+replay (const replay_func_t *f, trace_call_t *c, trace_arg_t *z,
+        double min_time, double *t)
+{
+   known_signs_t ks = {1, 1};
+   double start, elapsed;
+   long n, i;
+   int inex, k, ok;
+
+   for (k = 0; k < c->nout; k++) {
+      z [k].kind = c->out [k].kind;
+      if (z [k].kind == 'f')
+         mpfr_set_prec (z [k].f, mpfr_get_prec (c->out [k].f));
+      else {
+         mpfr_set_prec (mpc_realref (z [k].c),
+                        mpfr_get_prec (mpc_realref (c->out [k].c)));
+         mpfr_set_prec (mpc_imagref (z [k].c),
+                        mpfr_get_prec (mpc_imagref (c->out [k].c)));
+      }
+   }
+
+   start = time_ns ();
+   inex = f->f (z, c);
+   elapsed = time_ns () - start;
+   for (n = 1; elapsed < min_time * 1e9; ) {
+      n *= 2;
+      start = time_ns ();
+      for (i = 0; i < n; i++)
+         f->f (z, c);
+      elapsed = time_ns () - start;
+   }
+   *t = elapsed / n;
+
+   ok = (inex == c->inex);
+   for (k = 0; k < c->nout; k++)
+      if (z [k].kind == 'f')
+         ok = ok && same_mpfr_value (z [k].f, c->out [k].f, 1);
+      else
+         ok = ok && same_mpc_value (z [k].c, c->out [k].c, ks);
+   return ok;
+}
+
+int
+main (int argc, char *argv[])
+{
+   trace_t t;
+   trace_arg_t z [MPC_TRACE_MAX_OUT];
+   double min_time = 0, time;
+   double trace_ns [N_FUNCS], replay_ns [N_FUNCS];
+   unsigned long calls [N_FUNCS], bad [N_FUNCS], n = 0;
+   int ret, i, k, errors = 0;
+
+   if (argc == 4 && strcmp (argv [1], "-t") == 0)
+      min_time = atof (argv [2]);
+   else if (argc != 2 || argv [1][0] == '-') {
+      fprintf (stderr, "Usage: mpcreplay [-t seconds] file\n");
+      return 1;
+   }
+
+   for (i = 0; i < (int) N_FUNCS; i++) {
+      calls [i] = bad [i] = 0;
+      trace_ns [i] = replay_ns [i] = 0;
+   }
+   for (k = 0; k < MPC_TRACE_MAX_OUT; k++)
+      trace_arg_init (&(z [k]));
+
+   if (trace_open (&t, argv [argc - 1]) != 0)
+      return 1;
+   while ((ret = trace_read (&t)) == 1) {
+      n++;
+      i = find_function (t.call.name, t.call.type);
+      if (i < 0) {
+         fprintf (stderr, "mpcreplay: call %lu: unknown function %s %s\n",
+                  n, t.call.name, t.call.type);
+         errors = 1;
+         continue;
+      }
+      calls [i]++;
+      trace_ns [i] += (double) t.call.time;
+      if (!replay (replay_funcs + i, &t.call, z, min_time, &time)) {
+         fprintf (stderr, "mpcreplay: call %lu: %s gives a different "
+                  "result\n", n, t.call.name);
+         bad [i]++;
+         errors = 1;
+      }
+      replay_ns [i] += time;
+   }
+   trace_close (&t);
+
+   printf ("function,calls,differences,trace_ns,replay_ns,speedup\n");
+   for (i = 0; i < (int) N_FUNCS; i++)
+      if (calls [i] > 0)
+         printf ("%s,%lu,%lu,%.0f,%.0f,%.3f\n", replay_funcs [i].name,
+                 calls [i], bad [i], trace_ns [i], replay_ns [i],
+                 replay_ns [i] > 0 ? trace_ns [i] / replay_ns [i] : 0);
+
+   for (k = 0; k < MPC_TRACE_MAX_OUT; k++)
+      trace_arg_clear (&(z [k]));
+   mpc_free_scratch ();
+
+   return (ret != 0 || errors);
+}
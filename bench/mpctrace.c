@@ -0,0 +1,155 @@
+/* mpctrace -- print the binary call traces written by the logging library
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* "mpctrace file" prints each call of a trace written with MPC_LOG_TRACE
+   (see src/logging.c) on one line, in the format of the logging to
+   stderr, that is, function name, type, precisions of the results and
+   precisions and values of the arguments, followed by the rounding modes,
+   the return value, the values of the results and the time of the call
+   in nanoseconds. "mpctrace -s file" prints instead, for each function,
+   the number of calls and their total and mean time.                   */
+
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+static void
+usage (void)
+{
+   fprintf (stderr, "Usage: mpctrace [-s] file\n");
+   exit (1);
+}
+
+static void
+print_prec (const trace_arg_t *a)
+{
+   if (a->kind == 'f')
+      printf (" %li", (long) mpfr_get_prec (a->f));
+   else
+      printf (" %li %li", (long) mpfr_get_prec (mpc_realref (a->c)),
+              (long) mpfr_get_prec (mpc_imagref (a->c)));
+}
+
+static void
+print_value (const trace_arg_t *a)
+{
+   printf (" ");
+   switch (a->kind) {
+   case 'c':
+      mpc_out_str (stdout, 16, 0, a->c, MPC_RNDNN);
+      break;
+   case 'f':
+      mpfr_out_str (stdout, 16, 0, a->f, MPFR_RNDN);
+      break;
+   case 'z':
+      mpz_out_str (stdout, 16, a->z);
+      break;
+   case 'd':
+      printf ("%a", a->d);
+      break;
+   case 'u':
+      printf ("%lu", a->u);
+      break;
+   default:
+      printf ("%li", a->s);
+   }
+}
+
+static void
+print_call (const trace_call_t *c)
+{
+   int k;
+
+   printf ("%s %s", c->name, c->type);
+   for (k = 0; k < c->nout; k++)
+      print_prec (&(c->out [k]));
+   for (k = 0; k < c->nin; k++) {
+      if (c->in [k].kind == 'c' || c->in [k].kind == 'f')
+         print_prec (&(c->in [k]));
+      print_value (&(c->in [k]));
+   }
+   for (k = 0; k < c->nout; k++)
+      if (c->out [k].kind == 'f')
+         printf (" (%s)", mpfr_print_rnd_mode ((mpfr_rnd_t) c->rnd [k]));
+      else
+         printf (" (%s,%s)",
+                 mpfr_print_rnd_mode (MPC_RND_RE ((mpc_rnd_t) c->rnd [k])),
+                 mpfr_print_rnd_mode (MPC_RND_IM ((mpc_rnd_t) c->rnd [k])));
+   printf (" -> %i", c->inex);
+   for (k = 0; k < c->nout; k++)
+      print_value (&(c->out [k]));
+   printf (" %.0f ns\n", (double) c->time);
+}
+
+int
+main (int argc, char *argv[])
+{
+   trace_t t;
+   int summary = 0, ret, k;
+   unsigned long *calls = NULL;
+   double *total = NULL;
+   int alloc = 0;
+
+   if (argc == 3 && strcmp (argv [1], "-s") == 0)
+      summary = 1;
+   else if (argc != 2 || argv [1][0] == '-')
+      usage ();
+
+   if (trace_open (&t, argv [argc - 1]) != 0)
+      return 1;
+
+   while ((ret = trace_read (&t)) == 1) {
+      if (!summary)
+         print_call (&t.call);
+      else {
+         if (t.n_funcs > alloc) {
+            calls = (unsigned long *) realloc (calls,
+                                      t.n_funcs * sizeof (unsigned long));
+            total = (double *) realloc (total, t.n_funcs * sizeof (double));
+            if (calls == NULL || total == NULL) {
+               fprintf (stderr, "mpctrace: not enough memory\n");
+               return 1;
+            }
+            for (k = alloc; k < t.n_funcs; k++) {
+               calls [k] = 0;
+               total [k] = 0;
+            }
+            alloc = t.n_funcs;
+         }
+         calls [t.call.id]++;
+         total [t.call.id] += (double) t.call.time;
+      }
+   }
+
+   if (summary) {
+      printf ("function,calls,total_ns,mean_ns\n");
+      for (k = 0; k < alloc; k++)
+         if (calls [k] > 0)
+            printf ("%s,%lu,%.0f,%.0f\n", t.names [k], calls [k], total [k],
+                    total [k] / calls [k]);
+      free (calls);
+      free (total);
+   }
+
+   trace_close (&t);
+   mpc_free_scratch ();
+
+   return (ret == 0 ? 0 : 1);
+}
@@ -0,0 +1,575 @@
+/* replay-func.h -- Calls of the functions of a trace for mpcreplay.
+
+Copyright (C) 2011, 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* generated by tools/logging from mpc.h, do not edit */
+
+static int
+replay_mpc_add (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_add (z [0].c, c->in [0].c, c->in [1].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_add_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_add_fr (z [0].c, c->in [0].c, c->in [1].f,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_add_si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_add_si (z [0].c, c->in [0].c, c->in [1].s,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_add_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_add_ui (z [0].c, c->in [0].c, c->in [1].u,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sub (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sub (z [0].c, c->in [0].c, c->in [1].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sub_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sub_fr (z [0].c, c->in [0].c, c->in [1].f,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_fr_sub (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_fr_sub (z [0].c, c->in [0].f, c->in [1].c,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sub_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sub_ui (z [0].c, c->in [0].c, c->in [1].u,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_ui_ui_sub (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_ui_ui_sub (z [0].c, c->in [0].u, c->in [1].u, c->in [2].c,
+                         (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul (z [0].c, c->in [0].c, c->in [1].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul_fr (z [0].c, c->in [0].c, c->in [1].f,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul_ui (z [0].c, c->in [0].c, c->in [1].u,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul_si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul_si (z [0].c, c->in [0].c, c->in [1].s,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul_i (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul_i (z [0].c, c->in [0].c, (int) c->in [1].s,
+                     (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sqr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sqr (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_div (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_div (z [0].c, c->in [0].c, c->in [1].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_inv (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_inv (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_pow (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_pow (z [0].c, c->in [0].c, c->in [1].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_pow_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_pow_fr (z [0].c, c->in [0].c, c->in [1].f,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_pow_d (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_pow_d (z [0].c, c->in [0].c, c->in [1].d,
+                     (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_pow_si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_pow_si (z [0].c, c->in [0].c, c->in [1].s,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_pow_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_pow_ui (z [0].c, c->in [0].c, c->in [1].u,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_pow_z (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_pow_z (z [0].c, c->in [0].c, c->in [1].z,
+                     (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_div_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_div_fr (z [0].c, c->in [0].c, c->in [1].f,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_fr_div (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_fr_div (z [0].c, c->in [0].f, c->in [1].c,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_div_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_div_ui (z [0].c, c->in [0].c, c->in [1].u,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_ui_div (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_ui_div (z [0].c, c->in [0].u, c->in [1].c,
+                      (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_div_2ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_div_2ui (z [0].c, c->in [0].c, c->in [1].u,
+                       (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul_2ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul_2ui (z [0].c, c->in [0].c, c->in [1].u,
+                       (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_div_2si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_div_2si (z [0].c, c->in [0].c, c->in [1].s,
+                       (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_mul_2si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_mul_2si (z [0].c, c->in [0].c, c->in [1].s,
+                       (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_conj (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_conj (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_neg (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_neg (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_norm (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_norm (z [0].f, c->in [0].c, (mpfr_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_abs (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_abs (z [0].f, c->in [0].c, (mpfr_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sqrt (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sqrt (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_d (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_d (z [0].c, c->in [0].d, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_d_d (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_d_d (z [0].c, c->in [0].d, c->in [1].d,
+                       (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_fr (z [0].c, c->in [0].f, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_fr_fr (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_fr_fr (z [0].c, c->in [0].f, c->in [1].f,
+                         (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_si (z [0].c, c->in [0].s, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_si_si (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_si_si (z [0].c, c->in [0].s, c->in [1].s,
+                         (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_ui (z [0].c, c->in [0].u, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_ui_ui (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_ui_ui (z [0].c, c->in [0].u, c->in [1].u,
+                         (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_z (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_z (z [0].c, c->in [0].z, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_set_z_z (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_set_z_z (z [0].c, c->in [0].z, c->in [1].z,
+                       (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_fma (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_fma (z [0].c, c->in [0].c, c->in [1].c, c->in [2].c,
+                   (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_fmma (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_fmma (z [0].c, c->in [0].c, c->in [1].c, c->in [2].c,
+                    c->in [3].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_fmms (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_fmms (z [0].c, c->in [0].c, c->in [1].c, c->in [2].c,
+                    c->in [3].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_real (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_real (z [0].f, c->in [0].c, (mpfr_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_imag (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_imag (z [0].f, c->in [0].c, (mpfr_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_arg (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_arg (z [0].f, c->in [0].c, (mpfr_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_proj (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_proj (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_exp (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_exp (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_log (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_log (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_log10 (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_log10 (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sin (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sin (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_cos (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_cos (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sin_cos (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sin_cos (z [0].c, z [1].c, c->in [0].c, (mpc_rnd_t) c->rnd [0],
+                       (mpc_rnd_t) c->rnd [1]);
+}
+
+static int
+replay_mpc_tan (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_tan (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_sinh (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_sinh (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_cosh (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_cosh (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_tanh (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_tanh (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_asin (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_asin (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_acos (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_acos (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_atan (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_atan (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_asinh (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_asinh (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_acosh (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_acosh (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_atanh (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_atanh (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_agm (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_agm (z [0].c, c->in [0].c, c->in [1].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_agm1 (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_agm1 (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_elliptic_k (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_elliptic_k (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static int
+replay_mpc_elliptic_e (trace_arg_t *z, const trace_call_t *c)
+{
+   return mpc_elliptic_e (z [0].c, c->in [0].c, (mpc_rnd_t) c->rnd [0]);
+}
+
+static const replay_func_t replay_funcs [] = {
+   {"mpc_add", "c_cc", replay_mpc_add},
+   {"mpc_add_fr", "c_cf", replay_mpc_add_fr},
+   {"mpc_add_si", "c_cs", replay_mpc_add_si},
+   {"mpc_add_ui", "c_cu", replay_mpc_add_ui},
+   {"mpc_sub", "c_cc", replay_mpc_sub},
+   {"mpc_sub_fr", "c_cf", replay_mpc_sub_fr},
+   {"mpc_fr_sub", "c_fc", replay_mpc_fr_sub},
+   {"mpc_sub_ui", "c_cu", replay_mpc_sub_ui},
+   {"mpc_ui_ui_sub", "c_uuc", replay_mpc_ui_ui_sub},
+   {"mpc_mul", "c_cc", replay_mpc_mul},
+   {"mpc_mul_fr", "c_cf", replay_mpc_mul_fr},
+   {"mpc_mul_ui", "c_cu", replay_mpc_mul_ui},
+   {"mpc_mul_si", "c_cs", replay_mpc_mul_si},
+   {"mpc_mul_i", "c_ci", replay_mpc_mul_i},
+   {"mpc_sqr", "c_c", replay_mpc_sqr},
+   {"mpc_div", "c_cc", replay_mpc_div},
+   {"mpc_inv", "c_c", replay_mpc_inv},
+   {"mpc_pow", "c_cc", replay_mpc_pow},
+   {"mpc_pow_fr", "c_cf", replay_mpc_pow_fr},
+   {"mpc_pow_d", "c_cd", replay_mpc_pow_d},
+   {"mpc_pow_si", "c_cs", replay_mpc_pow_si},
+   {"mpc_pow_ui", "c_cu", replay_mpc_pow_ui},
+   {"mpc_pow_z", "c_cz", replay_mpc_pow_z},
+   {"mpc_div_fr", "c_cf", replay_mpc_div_fr},
+   {"mpc_fr_div", "c_fc", replay_mpc_fr_div},
+   {"mpc_div_ui", "c_cu", replay_mpc_div_ui},
+   {"mpc_ui_div", "c_uc", replay_mpc_ui_div},
+   {"mpc_div_2ui", "c_cu", replay_mpc_div_2ui},
+   {"mpc_mul_2ui", "c_cu", replay_mpc_mul_2ui},
+   {"mpc_div_2si", "c_cs", replay_mpc_div_2si},
+   {"mpc_mul_2si", "c_cs", replay_mpc_mul_2si},
+   {"mpc_conj", "c_c", replay_mpc_conj},
+   {"mpc_neg", "c_c", replay_mpc_neg},
+   {"mpc_norm", "f_c", replay_mpc_norm},
+   {"mpc_abs", "f_c", replay_mpc_abs},
+   {"mpc_sqrt", "c_c", replay_mpc_sqrt},
+   {"mpc_set", "c_c", replay_mpc_set},
+   {"mpc_set_d", "c_d", replay_mpc_set_d},
+   {"mpc_set_d_d", "c_dd", replay_mpc_set_d_d},
+   {"mpc_set_fr", "c_f", replay_mpc_set_fr},
+   {"mpc_set_fr_fr", "c_ff", replay_mpc_set_fr_fr},
+   {"mpc_set_si", "c_s", replay_mpc_set_si},
+   {"mpc_set_si_si", "c_ss", replay_mpc_set_si_si},
+   {"mpc_set_ui", "c_u", replay_mpc_set_ui},
+   {"mpc_set_ui_ui", "c_uu", replay_mpc_set_ui_ui},
+   {"mpc_set_z", "c_z", replay_mpc_set_z},
+   {"mpc_set_z_z", "c_zz", replay_mpc_set_z_z},
+   {"mpc_fma", "c_ccc", replay_mpc_fma},
+   {"mpc_fmma", "c_cccc", replay_mpc_fmma},
+   {"mpc_fmms", "c_cccc", replay_mpc_fmms},
+   {"mpc_real", "f_c", replay_mpc_real},
+   {"mpc_imag", "f_c", replay_mpc_imag},
+   {"mpc_arg", "f_c", replay_mpc_arg},
+   {"mpc_proj", "c_c", replay_mpc_proj},
+   {"mpc_exp", "c_c", replay_mpc_exp},
+   {"mpc_log", "c_c", replay_mpc_log},
+   {"mpc_log10", "c_c", replay_mpc_log10},
+   {"mpc_sin", "c_c", replay_mpc_sin},
+   {"mpc_cos", "c_c", replay_mpc_cos},
+   {"mpc_sin_cos", "cc_c", replay_mpc_sin_cos},
+   {"mpc_tan", "c_c", replay_mpc_tan},
+   {"mpc_sinh", "c_c", replay_mpc_sinh},
+   {"mpc_cosh", "c_c", replay_mpc_cosh},
+   {"mpc_tanh", "c_c", replay_mpc_tanh},
+   {"mpc_asin", "c_c", replay_mpc_asin},
+   {"mpc_acos", "c_c", replay_mpc_acos},
+   {"mpc_atan", "c_c", replay_mpc_atan},
+   {"mpc_asinh", "c_c", replay_mpc_asinh},
+   {"mpc_acosh", "c_c", replay_mpc_acosh},
+   {"mpc_atanh", "c_c", replay_mpc_atanh},
+   {"mpc_agm", "c_cc", replay_mpc_agm},
+   {"mpc_agm1", "c_c", replay_mpc_agm1},
+   {"mpc_elliptic_k", "c_c", replay_mpc_elliptic_k},
+   {"mpc_elliptic_e", "c_c", replay_mpc_elliptic_e}
+};
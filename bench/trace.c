@@ -0,0 +1,379 @@
+/* trace.c -- Reading the binary call traces written by the logging library
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+/* The functions return 0 on success and -1 after printing an error
+   message to stderr; trace_read returns 1 when a call has been read and
+   0 at the end of the trace. */
+
+static int
+trace_error (trace_t *t, const char *msg)
+{
+   fprintf (stderr, "%s: %s\n", t->filename, msg);
+   return -1;
+}
+
+static int
+read_bytes (trace_t *t, void *p, size_t size)
+{
+   if (fread (p, 1, size, t->f) != size)
+      return trace_error (t, "truncated trace");
+   return 0;
+}
+
+static int
+read_int (trace_t *t, int64_t *i)
+{
+   return read_bytes (t, i, sizeof (int64_t));
+}
+
+static int
+read_byte (trace_t *t, int *c)
+{
+   *c = getc (t->f);
+   if (*c == EOF)
+      return trace_error (t, "truncated trace");
+   *c = (signed char) *c;
+   return 0;
+}
+
+/* reads a string given by its length and its characters */
+static int
+read_string (trace_t *t, char **s)
+{
+   int n;
+
+   if (read_byte (t, &n) != 0)
+      return -1;
+   n = (unsigned char) n;
+   *s = (char *) malloc (n + 1);
+   if (*s == NULL)
+      return trace_error (t, "not enough memory");
+   (*s) [n] = '\0';
+   return read_bytes (t, *s, n);
+}
+
+static int
+read_prec (trace_t *t, mpfr_prec_t *p)
+{
+   int64_t i;
+
+   if (read_int (t, &i) != 0)
+      return -1;
+   if (i < MPFR_PREC_MIN || i > MPFR_PREC_MAX)
+      return trace_error (t, "invalid precision");
+   *p = (mpfr_prec_t) i;
+   return 0;
+}
+
+static int
+read_fr (trace_t *t, mpfr_ptr x)
+{
+   mpfr_prec_t p;
+   int kind, sign;
+   int64_t e;
+
+   if (read_prec (t, &p) != 0 || read_byte (t, &kind) != 0)
+      return -1;
+   mpfr_set_prec (x, p);
+   sign = (kind < 0 ? -1 : 1);
+   switch (kind * sign) {
+   case MPFR_NAN_KIND:
+      mpfr_set_nan (x);
+      break;
+   case MPFR_INF_KIND:
+      mpfr_set_inf (x, sign);
+      break;
+   case MPFR_ZERO_KIND:
+      mpfr_set_zero (x, sign);
+      break;
+   case MPFR_REGULAR_KIND:
+      /* make x a regular number, then overwrite its significand */
+      mpfr_set_si (x, sign, MPFR_RNDN);
+      if (read_int (t, &e) != 0
+          || read_bytes (t, mpfr_custom_get_significand (x),
+                         mpfr_custom_get_size (p)) != 0)
+         return -1;
+      if (mpfr_set_exp (x, (mpfr_exp_t) e) != 0)
+         return trace_error (t, "exponent out of the current range");
+      break;
+   default:
+      return trace_error (t, "invalid kind of number");
+   }
+   return 0;
+}
+
+static int
+read_c (trace_t *t, mpc_ptr z)
+{
+   if (read_fr (t, mpc_realref (z)) != 0 || read_fr (t, mpc_imagref (z)) != 0)
+      return -1;
+   return 0;
+}
+
+static int
+read_z (trace_t *t, mpz_ptr z)
+{
+   int64_t size;
+   size_t n;
+   mp_limb_t *limbs;
+
+   if (read_int (t, &size) != 0)
+      return -1;
+   n = (size_t) (size < 0 ? -size : size);
+   limbs = (mp_limb_t *) malloc (n * sizeof (mp_limb_t) + 1);
+   if (limbs == NULL)
+      return trace_error (t, "not enough memory");
+   if (read_bytes (t, limbs, n * sizeof (mp_limb_t)) != 0) {
+      free (limbs);
+      return -1;
+   }
+   mpz_import (z, n, -1, sizeof (mp_limb_t), 0, 0, limbs);
+   if (size < 0)
+      mpz_neg (z, z);
+   free (limbs);
+   return 0;
+}
+
+/* reads the value of an argument or a result of the given kind */
+static int
+read_arg (trace_t *t, trace_arg_t *a)
+{
+   int64_t i;
+
+   switch (a->kind) {
+   case 'c':
+      return read_c (t, a->c);
+   case 'f':
+      return read_fr (t, a->f);
+   case 'z':
+      return read_z (t, a->z);
+   case 'd':
+      return read_bytes (t, &(a->d), sizeof (double));
+   case 'u':
+      if (read_int (t, &i) != 0)
+         return -1;
+      a->u = (unsigned long) i;
+      return 0;
+   default: /* 's' and 'i' */
+      if (read_int (t, &i) != 0)
+         return -1;
+      a->s = (long) i;
+      return 0;
+   }
+}
+
+/* sets the kinds of the arguments and results of c from its type and
+   returns 0, or returns -1 if the type is not supported */
+static int
+set_kinds (trace_call_t *c)
+{
+   const char *s;
+
+   for (c->nout = 0, s = c->type; *s == 'c' || *s == 'f'; s++) {
+      if (c->nout == MPC_TRACE_MAX_OUT)
+         return -1;
+      c->out [c->nout++].kind = *s;
+   }
+   if (*s != '_')
+      return -1;
+   for (c->nin = 0, s++; *s != '\0'; s++) {
+      if (c->nin == MPC_TRACE_MAX_IN || strchr ("cfusidz", *s) == NULL)
+         return -1;
+      c->in [c->nin++].kind = *s;
+   }
+   return 0;
+}
+
+/* reads the definition of a function identifier */
+static int
+read_func (trace_t *t)
+{
+   int64_t id;
+
+   if (read_int (t, &id) != 0)
+      return -1;
+   if (id != t->n_funcs)
+      return trace_error (t, "unexpected function identifier");
+   if (t->n_funcs == t->alloc) {
+      t->alloc = 2 * t->alloc + 16;
+      t->names = (char **) realloc (t->names, t->alloc * sizeof (char *));
+      t->types = (char **) realloc (t->types, t->alloc * sizeof (char *));
+      if (t->names == NULL || t->types == NULL)
+         return trace_error (t, "not enough memory");
+   }
+   t->names [t->n_funcs] = t->types [t->n_funcs] = NULL;
+   t->n_funcs++;
+   if (   read_string (t, &(t->names [id])) != 0
+       || read_string (t, &(t->types [id])) != 0)
+      return -1;
+   return 0;
+}
+
+/* reads a call record after its tag */
+static int
+read_call (trace_t *t)
+{
+   trace_call_t *c = &(t->call);
+   int64_t i;
+   int k, rnd;
+
+   if (read_int (t, &i) != 0)
+      return -1;
+   if (i < 0 || i >= t->n_funcs)
+      return trace_error (t, "undefined function identifier");
+   c->id = (int) i;
+   c->name = t->names [i];
+   c->type = t->types [i];
+   if (set_kinds (c) != 0)
+      return trace_error (t, "unsupported function type");
+
+   for (k = 0; k < c->nout; k++) {
+      mpfr_prec_t pre, pim;
+
+      if (read_prec (t, &pre) != 0)
+         return -1;
+      if (c->out [k].kind == 'f')
+         mpfr_set_prec (c->out [k].f, pre);
+      else {
+         if (read_prec (t, &pim) != 0)
+            return -1;
+         mpfr_set_prec (mpc_realref (c->out [k].c), pre);
+         mpfr_set_prec (mpc_imagref (c->out [k].c), pim);
+      }
+   }
+   for (k = 0; k < c->nin; k++)
+      if (read_arg (t, &(c->in [k])) != 0)
+         return -1;
+   for (k = 0; k < c->nout; k++) {
+      if (read_byte (t, &rnd) != 0)
+         return -1;
+      c->rnd [k] = rnd;
+   }
+   if (read_int (t, &(c->time)) != 0 || read_int (t, &i) != 0)
+      return -1;
+   c->inex = (int) i;
+   for (k = 0; k < c->nout; k++)
+      if (read_arg (t, &(c->out [k])) != 0)
+         return -1;
+   return 0;
+}
+
+void
+trace_arg_init (trace_arg_t *a)
+{
+   a->kind = 'c';
+   mpc_init2 (a->c, MPFR_PREC_MIN);
+   mpfr_init2 (a->f, MPFR_PREC_MIN);
+   mpz_init (a->z);
+   a->s = 0;
+   a->u = 0;
+   a->d = 0;
+}
+
+void
+trace_arg_clear (trace_arg_t *a)
+{
+   mpc_clear (a->c);
+   mpfr_clear (a->f);
+   mpz_clear (a->z);
+}
+
+int
+trace_open (trace_t *t, const char *filename)
+{
+   char magic [8];
+   int64_t version, order, int_size, limb_size;
+   int k;
+
+   t->filename = filename;
+   t->n_funcs = 0;
+   t->alloc = 0;
+   t->names = NULL;
+   t->types = NULL;
+   t->f = fopen (filename, "rb");
+   if (t->f == NULL)
+      return trace_error (t, "cannot open file");
+
+   if (   fread (magic, 1, 8, t->f) != 8
+       || memcmp (magic, MPC_TRACE_MAGIC, 8) != 0
+       || fread (&version, sizeof (int64_t), 1, t->f) != 1
+       || fread (&order, sizeof (int64_t), 1, t->f) != 1
+       || fread (&int_size, sizeof (int64_t), 1, t->f) != 1
+       || fread (&limb_size, sizeof (int64_t), 1, t->f) != 1) {
+      fclose (t->f);
+      return trace_error (t, "not a trace of GNU MPC");
+   }
+   if (   version != MPC_TRACE_VERSION
+       || order != (int64_t) 0x0102030405060708
+       || int_size != sizeof (int64_t)
+       || limb_size != sizeof (mp_limb_t)) {
+      fclose (t->f);
+      return trace_error (t, "trace written by a different version "
+                          "or on a different machine");
+   }
+
+   for (k = 0; k < MPC_TRACE_MAX_OUT; k++)
+      trace_arg_init (&(t->call.out [k]));
+   for (k = 0; k < MPC_TRACE_MAX_IN; k++)
+      trace_arg_init (&(t->call.in [k]));
+   return 0;
+}
+
+int
+trace_read (trace_t *t)
+{
+   int tag;
+
+   for (;;) {
+      tag = getc (t->f);
+      if (tag == EOF)
+         return 0;
+      else if (tag == MPC_TRACE_FUNC) {
+         if (read_func (t) != 0)
+            return -1;
+      }
+      else if (tag == MPC_TRACE_CALL)
+         return (read_call (t) == 0 ? 1 : -1);
+      else
+         return trace_error (t, "invalid record");
+   }
+}
+
+void
+trace_close (trace_t *t)
+{
+   int k;
+
+   for (k = 0; k < MPC_TRACE_MAX_OUT; k++)
+      trace_arg_clear (&(t->call.out [k]));
+   for (k = 0; k < MPC_TRACE_MAX_IN; k++)
+      trace_arg_clear (&(t->call.in [k]));
+   for (k = 0; k < t->n_funcs; k++) {
+      free (t->names [k]);
+      free (t->types [k]);
+   }
+   free (t->names);
+   free (t->types);
+   fclose (t->f);
+}
@@ -0,0 +1,112 @@
+/* trace.h -- Reading the binary call traces written by the logging library
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#ifndef __MPC_TRACE_H
+#define __MPC_TRACE_H
+
+/* A trace is written by src/logging.c when GNU MPC has been configured
+   with --enable-logging and the environment variable MPC_LOG_TRACE names
+   a file. It is meant to be read on the machine that has written it: all
+   integers are int64_t in the byte order of the machine, except for the
+   one byte fields marked (byte), and significands are copied from memory.
+
+   header:     "MPCTRACE", version (1), 0x0102030405060708,
+               sizeof (int64_t), sizeof (mp_limb_t)
+   then a sequence of records, each starting with a tag (byte):
+   'F' record: identifier, length (byte) and characters of the function
+               name, for instance "mpc_mul", length (byte) and characters
+               of the type, for instance "c_cf", the letters before the
+               underscore describing the results, the ones after it the
+               arguments, see below
+   'C' record: identifier of a function defined before, the precisions of
+               each result (two for a complex one), the value of each
+               argument, a rounding mode (byte) per result, the time of the
+               call in nanoseconds, its return value, and finally the value
+               of each result
+
+   The letters of a type and the corresponding values are
+      c  complex number: its real part followed by its imaginary part
+      f  real number: its precision, its kind (byte) as returned by
+         mpfr_custom_get_kind, and for a regular number its exponent and
+         its significand of mpfr_custom_get_size (precision) bytes
+      u  unsigned long, s  long, i  int: as an integer
+      d  double: its sizeof (double) bytes
+      z  mpz_t: its signed number of limbs as for the _mp_size field,
+         followed by its limbs, least significant first               */
+
+#include <stdio.h>
+#include "config.h"
+#ifdef HAVE_INTTYPES_H
+#include <inttypes.h>
+#endif
+#ifdef HAVE_STDINT_H
+#include <stdint.h>
+#endif
+#include "mpc.h"
+#include "mpc-trace.h"
+
+#define MPC_TRACE_MAX_OUT 2
+#define MPC_TRACE_MAX_IN  4
+
+/* an argument or a result of a call; only the field given by kind,
+   a letter of the type of the function, is meaningful */
+typedef struct {
+   char          kind;
+   mpc_t         c;
+   mpfr_t        f;
+   mpz_t         z;
+   long          s;
+   unsigned long u;
+   double        d;
+} trace_arg_t;
+
+/* one call read from a trace */
+typedef struct {
+   int         id;        /* identifier of the function */
+   const char *name;      /* name of the function, for instance "mpc_mul" */
+   const char *type;      /* type of the function, for instance "c_cc" */
+   int         nout, nin; /* numbers of results and arguments */
+   trace_arg_t out [MPC_TRACE_MAX_OUT];
+      /* results, with the precisions of the call */
+   trace_arg_t in [MPC_TRACE_MAX_IN];
+      /* arguments */
+   int         rnd [MPC_TRACE_MAX_OUT];
+      /* rounding modes, mpc_rnd_t or mpfr_rnd_t depending on the result */
+   int64_t     time;      /* time of the call in nanoseconds */
+   int         inex;      /* return value */
+} trace_call_t;
+
+typedef struct {
+   FILE        *f;
+   const char  *filename;
+   int          n_funcs;  /* number of defined function identifiers */
+   int          alloc;    /* size of names and types */
+   char       **names;
+   char       **types;
+   trace_call_t call;     /* the last call read */
+} trace_t;
+
+extern int  trace_open (trace_t *, const char *);
+extern int  trace_read (trace_t *);
+extern void trace_close (trace_t *);
+extern void trace_arg_init (trace_arg_t *);
+extern void trace_arg_clear (trace_arg_t *);
+
+#endif /* __MPC_TRACE_H */
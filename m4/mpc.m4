@@ -60,6 +60,36 @@ AC_DEFUN([MPC_COMPLEX_H], [
 ])
 
 
+
+#
+# SYNOPSIS
+#
+#
+# MPC_TLS
+#
+# DESCRIPTION
+#
+# Check whether the compiler supports thread-local storage through the
+# __thread keyword; if yes, define MPC_THREAD_ATTR to it.
+#
+AC_DEFUN([MPC_TLS], [
+   AC_MSG_CHECKING([for thread-local storage])
+   AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM(
+         [[static __thread int x = 17;]],
+         [[x++; return x != 18;]]
+      )],
+      [
+         AC_MSG_RESULT([yes])
+         AC_DEFINE([MPC_THREAD_ATTR], [__thread],
+                   [Storage class of thread-local variables])
+      ],
+      [
+         AC_MSG_RESULT([no, build without scratch space reuse])
+      ]
+   )
+])
+
 #
 # SYNOPSIS
 #
@@ -1,6 +1,6 @@
 /* mpc_abs -- Absolute value of a complex number.
 
-Copyright (C) 2008, 2009, 2011 INRIA
+Copyright (C) 2008, 2009, 2011, 2012 INRIA
 
 This file is part of GNU MPC.
 
@@ -24,5 +24,9 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 int
 mpc_abs (mpfr_ptr a, mpc_srcptr b, mpfr_rnd_t rnd)
 {
-   return mpfr_hypot (a, mpc_realref(b), mpc_imagref(b), rnd);
+   if (!mpc_fin_p (b))
+      return mpfr_hypot (a, mpc_realref(b), mpc_imagref(b), rnd);
+   else
+      /* the square root of the exact norm, see norm.c */
+      return mpc_sum_sqr (a, b, 1, rnd);
 }
@@ -35,6 +35,8 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   inex_re = 0;
   inex_im = 0;
 
+  MPC_STATS_CALL (ACOS);
+
   /* special values */
   if (mpfr_nan_p (mpc_realref (op)) || mpfr_nan_p (mpc_imagref (op)))
     {
@@ -88,7 +90,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
                     {
                       p += mpc_ceil_log2 (p);
                       mpfr_set_prec (x, p);
-                      mpfr_const_pi (x, MPFR_RNDD);
+                      mpc_const_pi (x, MPFR_RNDD);
                       mpfr_mul_ui (x, x, 3, MPFR_RNDD);
                       ok =
                         mpfr_can_round (x, p - 1, MPFR_RNDD, MPC_RND_RE (rnd),
@@ -105,7 +107,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
               if (mpfr_sgn (mpc_realref (op)) > 0)
                 mpfr_set_ui (mpc_realref (rop), 0, MPFR_RNDN);
               else
-                inex_re = mpfr_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
+                inex_re = mpc_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
             }
         }
       else
@@ -145,7 +147,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
           else
             inex_im = -mpfr_acosh (mpc_imagref (rop), minus_op_re,
                                    INV_RND (MPC_RND_IM (rnd)));
-          inex_re = mpfr_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
+          inex_re = mpc_const_pi (mpc_realref (rop), MPC_RND_RE (rnd));
         }
       else
         {
@@ -191,6 +193,7 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   for (;;)
     {
       p += mpc_ceil_log2 (p) + 3;
+      MPC_STATS_LOOP (ACOS, p);
 
       mpfr_set_prec (mpc_realref(z1), p);
       mpfr_set_prec (pi_over_2, p);
@@ -214,12 +217,11 @@ mpc_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
           /* the error on x is bounded by 2^e1 * ulp(x) */
           mpfr_neg (mpc_imagref(z1), mpc_imagref(z1), MPFR_RNDN); /* exact */
           inex_im = -inex_im;
-          if (mpfr_can_round (mpc_realref(z1), p - e1, MPFR_RNDN, MPFR_RNDZ,
-                              p_re + (MPC_RND_RE(rnd) == MPFR_RNDN)))
+          if (MPC_CAN_ROUND (mpc_realref(z1), p - e1, p_re, MPC_RND_RE(rnd)))
             break;
         }
     }
-  inex = mpc_set (rop, z1, rnd);
+  inex = mpc_set (rop, z1, MPC_RND_FTON_C (rnd));
   inex_re = MPC_INEX_RE(inex);
   mpc_clear (z1);
   mpfr_clear (pi_over_2);
@@ -31,3 +31,16 @@ mpc_add (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
 
   return MPC_INEX(inex_re, inex_im);
 }
+
+/* a[i] <- b[i] + c[i] for 0 <= i < n; return 0 iff all results are exact */
+int
+mpc_add_vec (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, size_t n, mpc_rnd_t rnd)
+{
+  size_t i;
+  int inex = 0;
+
+  for (i = 0; i < n; i++)
+    inex |= mpc_add (a + i, b + i, c + i, rnd);
+
+  return inex;
+}
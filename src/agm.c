@@ -0,0 +1,501 @@
+/* mpc_agm, mpc_agm1 -- Arithmetic-geometric mean of complex numbers.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* The iteration a, b <- (a+b)/2, sqrt (a*b) runs at a fixed working
+   precision p+3 and follows the error analysis of algorithms.tex for
+   AGM (1, z), which only needs a complex relative error of at most 2^(1-p)
+   for each operation. So the steps are not correctly rounded: the product
+   uses three real multiplications and the square root a single real
+   square root and division, without Ziv loops. In the first quadrant, the
+   square root of the product is the optimal choice of the AGM. */
+
+/* returns the larger exponent of the non-zero parts of x, or the smallest
+   possible exponent if x is zero */
+static mpfr_exp_t
+emax_c (mpc_srcptr x)
+{
+   mpfr_exp_t e = mpfr_get_emin_min ();
+
+   if (!mpfr_zero_p (mpc_realref (x)))
+      e = mpfr_get_exp (mpc_realref (x));
+   if (!mpfr_zero_p (mpc_imagref (x)))
+      e = MPC_MAX (e, mpfr_get_exp (mpc_imagref (x)));
+   return e;
+}
+
+/* sets d to a*b with |d - a*b| <= 12 * 2^(-w) |a*b| for the precision w
+   of d, computed as (ar*br - ai*bi) + i ((ar+ai)(br+bi) - ar*br - ai*bi);
+   u is a temporary variable of precision w, and d must differ from a and
+   b */
+static void
+mul_fq (mpc_ptr d, mpc_srcptr a, mpc_srcptr b, mpfr_ptr u)
+{
+   mpfr_add (u, mpc_realref (a), mpc_imagref (a), MPFR_RNDN);
+   mpfr_add (mpc_imagref (d), mpc_realref (b), mpc_imagref (b), MPFR_RNDN);
+   mpfr_mul (mpc_imagref (d), mpc_imagref (d), u, MPFR_RNDN);
+   mpfr_mul (u, mpc_realref (a), mpc_realref (b), MPFR_RNDN);
+   mpfr_sub (mpc_imagref (d), mpc_imagref (d), u, MPFR_RNDN);
+   mpfr_mul (mpc_realref (d), mpc_imagref (a), mpc_imagref (b), MPFR_RNDN);
+   mpfr_sub (mpc_imagref (d), mpc_imagref (d), mpc_realref (d), MPFR_RNDN);
+   mpfr_sub (mpc_realref (d), u, mpc_realref (d), MPFR_RNDN);
+}
+
+/* sets b to the square root in the first quadrant of x + i*|y| for d =
+   x + i*y non-zero, with a relative error of at most 4 * 2^(-w) for the
+   precision w of b: with r = |d|, one part is sqrt ((r + |x|) / 2) and the
+   other one |y| divided by twice the first one; taking |y| keeps b in the
+   first quadrant when a rounding error has made y slightly negative. u is
+   a temporary variable of precision w, and b must differ from d. */
+static void
+sqrt_fq (mpc_ptr b, mpc_srcptr d, mpfr_ptr u)
+{
+   mpfr_ptr w, v;
+
+   if (mpfr_signbit (mpc_realref (d))) {
+      w = mpc_imagref (b);
+      v = mpc_realref (b);
+   }
+   else {
+      w = mpc_realref (b);
+      v = mpc_imagref (b);
+   }
+   mpfr_hypot (u, mpc_realref (d), mpc_imagref (d), MPFR_RNDN);
+   if (mpfr_signbit (mpc_realref (d)))
+      mpfr_sub (u, u, mpc_realref (d), MPFR_RNDN);
+   else
+      mpfr_add (u, u, mpc_realref (d), MPFR_RNDN);
+   mpfr_div_2ui (u, u, 1, MPFR_RNDN);
+   mpfr_sqrt (w, u, MPFR_RNDN);
+   mpfr_div (v, mpc_imagref (d), w, MPFR_RNDN);
+   mpfr_abs (v, v, MPFR_RNDN);
+   mpfr_div_2ui (v, v, 1, MPFR_RNDN);
+}
+
+/* Returns the number n = B (N, z) of AGM steps of algorithms.tex after
+   which AGM (1, z) is approximated with a relative error of at most
+   2^(-N), for z non-zero with Re (z) >= 0, and sets p to the working
+   precision N + n + 5, or 2n + 4 if this is larger. The bound on
+   |log_2 |z|| is taken from the exponents, so that it also holds for the
+   exact value of which z is an approximation. */
+int
+mpc_agm_steps (mpfr_prec_t *p, mpc_srcptr z, mpfr_prec_t N)
+{
+   mpfr_exp_t e;
+   int n;
+
+   /* |log_2 |z|| <= |e| + 1 since 2^(e-1) <= |z| < 2^(e+1/2) */
+   e = emax_c (z);
+   if (e < 0)
+      e = -e;
+   n = (int) (MPC_MAX (1, mpc_ceil_log2 ((mpfr_prec_t) e + 1))
+              + mpc_ceil_log2 (N + 4) + 2);
+   *p = MPC_MAX (N + n + 5, 2 * (mpfr_prec_t) n + 4);
+   return n;
+}
+
+/* Sets a to an approximation of AGM (1, z), obtained after n steps at
+   precision p+3, to which the precision of a is set; z must be given with
+   a relative error of at most 2^(1-p) and have a non-negative real part,
+   or one that is small compared to its imaginary part. For n and p from
+   mpc_agm_steps, the relative error of a is at most 2^(-N). a must differ
+   from z.
+   If s is not NULL, it contains m with z^2 = 1 - m on entry, and receives
+   the sum S of the 2^(k-1) c_k^2 for k from 0 to n, with c_0^2 = m and
+   c_k^2 = c_(k-1)^4 / (16 a_k^2), so that E (m) = K (m) (1 - S) for the
+   complete elliptic integrals; err then receives an exponent such that
+   S differs from the infinite sum for the exact AGM by at most 2^err. */
+void
+mpc_agm_loop (mpc_ptr a, mpc_srcptr z, int n, mpfr_prec_t p, mpc_ptr s,
+              mpfr_exp_t *err)
+{
+   mpfr_prec_t w = p + 3;
+   mpc_t t, b, d, q;
+   mpfr_t u;
+   mpfr_exp_t e, et, ea;
+   int k, conj, terms = 0;
+
+   /* t = conj (z) if Im (z) < 0 shares the significands of z; since all
+      roundings are to nearest, the computation for z is the conjugate of
+      the one for t */
+   t [0] = z [0];
+   conj = mpfr_signbit (mpc_imagref (t));
+   if (conj)
+      MPFR_CHANGE_SIGN (mpc_imagref (t));
+
+   mpc_set_prec (a, w);
+   mpc_init2 (b, w);
+   mpc_init2 (d, w);
+   mpfr_init2 (u, w);
+
+   /* the first step from a_0 = 1 and b_0 = t needs no product */
+   mpfr_add_ui (mpc_realref (a), mpc_realref (t), 1, MPFR_RNDN);
+   mpfr_set (mpc_imagref (a), mpc_imagref (t), MPFR_RNDN);
+   mpc_div_2ui (a, a, 1, MPC_RNDNN);
+   sqrt_fq (b, t, u);
+
+   e = mpfr_get_emin_min ();
+   if (s != NULL) {
+      mpc_init2 (q, w);
+      mpc_set (q, s, MPC_RNDNN);
+      if (conj)
+         mpc_conj (q, q, MPC_RNDNN);
+      mpc_set_prec (s, w);
+      mpc_div_2ui (s, q, 1, MPC_RNDNN);
+      if (!mpc_zero_p (s))
+         e = emax_c (s) + 10 - w;
+      terms = 1;
+   }
+
+   for (k = 1; ; k++) {
+      if (s != NULL) {
+         /* With the relative errors of at most 2^(k+6-w) of a_k from
+            algorithms.tex, the relative error of c_k^2 is at most
+            (k+1) 2^(k+8-w) by induction, and that of the term
+            T_k = 2^(k-1) c_k^2 less than 2^(2k+9-w), up to second order
+            terms. Each addition adds an error of 2^(-w) |S|. */
+         mpc_sqr (q, q, MPC_RNDNN);
+         mpc_sqr (d, a, MPC_RNDNN);
+         mpc_div (q, q, d, MPC_RNDNN);
+         mpc_div_2ui (q, q, 4, MPC_RNDNN);
+         mpc_mul_2ui (d, q, (unsigned long) k - 1, MPC_RNDNN);
+         if (!mpc_zero_p (d)) {
+            e = MPC_MAX (e, emax_c (d) + 2 * k + 10 - w);
+            mpc_add (s, s, d, MPC_RNDNN);
+            e = MPC_MAX (e, emax_c (s) + 1 - w);
+            terms += 2;
+         }
+      }
+      if (k == n)
+         break;
+      mul_fq (d, a, b, u);
+      mpc_add (a, a, b, MPC_RNDNN);
+      mpc_div_2ui (a, a, 1, MPC_RNDNN);
+      sqrt_fq (b, d, u);
+   }
+
+   if (s != NULL) {
+      /* T_(k+1) = 2^(-k-2) T_k^2 / a_(k+1)^2 with |a_(k+1)| >= |a_k| / 2,
+         so that |T_(n+1)| < 2^(2 et - 2 ea - n + 3); if this is at most
+         |a_n|^2 / 8, the following terms decrease at least by a factor 4
+         and the tail of the sum is at most 2^(2 et - 2 ea - n + 4) */
+      if (!mpc_zero_p (d)) {
+         et = emax_c (d);
+         ea = emax_c (a);
+         if (2 * et - 2 * ea - n + 3 <= 2 * ea - 5)
+            e = MPC_MAX (e, 2 * et - 2 * ea - n + 4);
+         else
+            e = MPC_MAX (e, emax_c (s) + 2);
+         terms++;
+      }
+      *err = e + mpc_ceil_log2 (terms);
+      if (conj)
+         mpc_conj (s, s, MPC_RNDNN);
+      mpc_clear (q);
+   }
+   if (conj)
+      mpc_conj (a, a, MPC_RNDNN);
+
+   mpc_clear (b);
+   mpc_clear (d);
+   mpfr_clear (u);
+}
+
+/* Returns 0 if the approximation x of a complex number X with
+   |x - X| <= 2^(-e) |x| can be rounded to the precision of rop in the
+   direction rnd, and otherwise a positive number of bits by which e
+   should grow. A part whose bit is set in zero, 1 for the real and 2 for
+   the imaginary part, is known to be zero and is not checked. */
+mpfr_exp_t
+mpc_agm_check (mpc_srcptr x, mpfr_exp_t e, int zero, mpc_srcptr rop,
+               mpc_rnd_t rnd)
+{
+   mpfr_exp_t ex, err, lost = 0;
+
+   /* the error of each part is less than 2^(ex+1-e) */
+   ex = emax_c (x);
+   if (!(zero & 1)) {
+      if (!mpfr_regular_p (mpc_realref (x)))
+         return MPC_MAX (e, 1);
+      err = mpfr_get_exp (mpc_realref (x)) - (ex + 1 - e);
+      if (!MPC_CAN_ROUND (mpc_realref (x), err, MPC_PREC_RE (rop),
+                          MPC_RND_RE (rnd)))
+         lost = MPC_MAX (1, MPC_PREC_RE (rop) + 2 - err);
+   }
+   if (!(zero & 2)) {
+      if (!mpfr_regular_p (mpc_imagref (x)))
+         return MPC_MAX (e, 1);
+      err = mpfr_get_exp (mpc_imagref (x)) - (ex + 1 - e);
+      if (!MPC_CAN_ROUND (mpc_imagref (x), err, MPC_PREC_IM (rop),
+                          MPC_RND_IM (rnd)))
+         lost = MPC_MAX (lost, MPC_MAX (1, MPC_PREC_IM (rop) + 2 - err));
+   }
+   return lost;
+}
+
+/* Sets rop to x rounded in the direction rnd after a successful
+   mpc_agm_check in the extended exponent range, and returns the ternary
+   value; the parts whose bit is set in zero are set to +0. Must be called
+   in the exponent range of the caller. */
+int
+mpc_agm_round (mpc_ptr rop, mpc_srcptr x, int zero, mpc_rnd_t rnd)
+{
+   int inex_re = 0, inex_im = 0;
+
+   if (zero & 1)
+      mpfr_set_ui (mpc_realref (rop), 0, MPFR_RNDN);
+   else {
+      inex_re = mpfr_set (mpc_realref (rop), mpc_realref (x),
+                          MPC_RND_FTON (MPC_RND_RE (rnd)));
+      inex_re = mpfr_check_range (mpc_realref (rop), inex_re,
+                                  MPC_RND_RE (rnd));
+   }
+   if (zero & 2)
+      mpfr_set_ui (mpc_imagref (rop), 0, MPFR_RNDN);
+   else {
+      inex_im = mpfr_set (mpc_imagref (rop), mpc_imagref (x),
+                          MPC_RND_FTON (MPC_RND_IM (rnd)));
+      inex_im = mpfr_check_range (mpc_imagref (rop), inex_im,
+                                  MPC_RND_IM (rnd));
+   }
+   return MPC_INEX (inex_re, inex_im);
+}
+
+/* returns 1 if x = -y */
+static int
+opposite_p (mpfr_srcptr x, mpfr_srcptr y)
+{
+   return mpfr_cmpabs (x, y) == 0
+          && (mpfr_zero_p (x) || mpfr_signbit (x) != mpfr_signbit (y));
+}
+
+/* sets z to b/a; for a real, the sign of a zero imaginary part of b is
+   kept, so that AGM (1, b) is the same as mpc_agm1 (b) on the negative
+   real axis */
+static void
+quotient (mpc_ptr z, mpc_srcptr b, mpc_srcptr a)
+{
+   if (mpfr_zero_p (mpc_imagref (a)))
+      mpc_div_fr (z, b, mpc_realref (a), MPC_RNDNN);
+   else
+      mpc_div (z, b, a, MPC_RNDNN);
+}
+
+/* sets x to an approximation of AGM (a, b) with a relative error of at
+   most 2^(1-N), for a and b finite and non-zero with b != -a; a may be
+   NULL, meaning 1. Let z = b/a. If Re (z) >= 0, then AGM (a, b) =
+   a AGM (1, z). Otherwise the first step a_1 = (a+b)/2, b_1 = a sqrt (z),
+   with the optimal choice of the square root, is done with the exact
+   operands to avoid the loss of accuracy in 1 + z, and
+   AGM (a, b) = a_1 AGM (1, b_1/a_1) with Re (b_1/a_1) >= 0. */
+static void
+agm_approx (mpc_ptr x, mpc_srcptr a, mpc_srcptr b, mpfr_prec_t N)
+{
+   mpc_t z, c, d;
+   mpfr_prec_t p, wp;
+   int n, neg;
+
+   /* a first guess of the working precision, p+3 for the p of
+      mpc_agm_steps */
+   wp = N + mpc_ceil_log2 (N) + 10;
+   mpc_init2 (z, 2);
+   mpc_init2 (c, 2);
+   mpc_init2 (d, 2);
+
+   if (a == NULL)
+      neg = mpfr_signbit (mpc_realref (b)) && !mpfr_zero_p (mpc_realref (b));
+   else {
+      /* Re (b/a) has the sign of Re (b conj (a)), which the correctly
+         rounded quotient preserves */
+      mpc_set_prec (z, 2);
+      quotient (z, b, a);
+      neg = mpfr_signbit (mpc_realref (z)) && !mpfr_zero_p (mpc_realref (z));
+   }
+
+   for (;;) {
+      MPC_STATS_LOOP (AGM, wp);
+      if (!neg) {
+         if (a == NULL) {
+            n = mpc_agm_steps (&p, b, N);
+            mpc_agm_loop (x, b, n, p, NULL, NULL);
+            break;
+         }
+         mpc_set_prec (z, wp);
+         quotient (z, b, a);
+      }
+      else {
+         /* The relative errors of d = a_1, of c = b_1 and of z = b_1/a_1
+            are at most 2^(-wp), 3 * 2^(-wp) and 5 * 2^(-wp). */
+         mpc_set_prec (z, wp);
+         mpc_set_prec (c, wp);
+         mpc_set_prec (d, wp);
+         if (a == NULL) {
+            mpc_add_ui (d, b, 1, MPC_RNDNN);
+            mpc_sqrt (c, b, MPC_RNDNN);
+         }
+         else {
+            mpc_add (d, a, b, MPC_RNDNN);
+            quotient (z, b, a);
+            mpc_sqrt (c, z, MPC_RNDNN);
+            mpc_mul (c, c, a, MPC_RNDNN);
+         }
+         mpc_div_2ui (d, d, 1, MPC_RNDNN);
+         mpc_div (z, c, d, MPC_RNDNN);
+      }
+      n = mpc_agm_steps (&p, z, N);
+      if (p + 3 > wp) {
+         wp = p + 3;
+         continue;
+      }
+      /* The relative error of x is at most 2^(-N) + 3 * 2^(-wp) with
+         wp >= N + 9, including second order terms. */
+      mpc_agm_loop (c, z, n, p, NULL, NULL);
+      mpc_set_prec (x, wp);
+      mpc_mul (x, c, neg ? d : a, MPC_RNDNN);
+      break;
+   }
+
+   mpc_clear (z);
+   mpc_clear (c);
+   mpc_clear (d);
+}
+
+/* returns the sign bit of the sum of two zeros rounded to nearest */
+static int
+zero_sign (mpfr_srcptr x, mpfr_srcptr y)
+{
+   return mpfr_signbit (x) && mpfr_signbit (y);
+}
+
+/* sets rop to AGM (a, b), where a may be NULL, meaning 1 */
+static int
+agm (mpc_ptr rop, mpc_srcptr a, mpc_srcptr b, mpc_rnd_t rnd)
+{
+   mpc_t one, x;
+   mp_limb_t s [2];
+   mpc_srcptr a1;
+   mpfr_exp_t emin, emax, lost;
+   mpfr_prec_t prec, N;
+   int zero, sign_re, sign_im, inex_re;
+
+   MPC_STATS_CALL (AGM);
+
+   if (a == NULL) {
+      /* one = 1 + 0*i on the stack */
+      mpc_real_c (one, s, NULL);
+      a1 = one;
+   }
+   else
+      a1 = a;
+
+   sign_re = zero_sign (mpc_realref (a1), mpc_realref (b));
+   sign_im = zero_sign (mpc_imagref (a1), mpc_imagref (b));
+
+   /* real non-negative operands, including infinities, are handled by
+      mpfr_agm */
+   if (   mpfr_zero_p (mpc_imagref (a1)) && mpfr_zero_p (mpc_imagref (b))
+       && !mpfr_nan_p (mpc_realref (a1)) && !mpfr_nan_p (mpc_realref (b))
+       && (mpfr_zero_p (mpc_realref (a1)) || !mpfr_signbit (mpc_realref (a1)))
+       && (mpfr_zero_p (mpc_realref (b)) || !mpfr_signbit (mpc_realref (b)))) {
+      inex_re = mpfr_agm (mpc_realref (rop), mpc_realref (a1),
+                          mpc_realref (b), MPC_RND_RE (rnd));
+      mpfr_set_ui (mpc_imagref (rop), 0, MPFR_RNDN);
+      mpfr_setsign (mpc_imagref (rop), mpc_imagref (rop), sign_im,
+                    MPFR_RNDN);
+      return MPC_INEX (inex_re, 0);
+   }
+
+   if (!mpc_fin_p (a1) || !mpc_fin_p (b)) {
+      mpc_set_nan (rop);
+      return MPC_INEX (0, 0);
+   }
+
+   if (   mpc_zero_p (a1) || mpc_zero_p (b)
+       || (   opposite_p (mpc_realref (a1), mpc_realref (b))
+           && opposite_p (mpc_imagref (a1), mpc_imagref (b)))) {
+      mpfr_set_ui (mpc_realref (rop), 0, MPFR_RNDN);
+      mpfr_setsign (mpc_realref (rop), mpc_realref (rop), sign_re,
+                    MPFR_RNDN);
+      mpfr_set_ui (mpc_imagref (rop), 0, MPFR_RNDN);
+      mpfr_setsign (mpc_imagref (rop), mpc_imagref (rop), sign_im,
+                    MPFR_RNDN);
+      return MPC_INEX (0, 0);
+   }
+
+   if (mpc_cmp (a1, b) == 0)
+      return mpc_set (rop, b, rnd);
+
+   /* If both operands are purely imaginary with imaginary parts of the
+      same sign, or real with real parts of the same sign, then the result
+      is a multiple of them by a positive real number, and its real,
+      respectively imaginary part is an exact zero. */
+   zero = 0;
+   if (   mpfr_zero_p (mpc_realref (a1)) && mpfr_zero_p (mpc_realref (b))
+       && mpfr_signbit (mpc_imagref (a1)) == mpfr_signbit (mpc_imagref (b)))
+      zero = 1;
+   else if (   mpfr_zero_p (mpc_imagref (a1)) && mpfr_zero_p (mpc_imagref (b))
+            && mpfr_signbit (mpc_realref (a1))
+               == mpfr_signbit (mpc_realref (b)))
+      zero = 2;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   prec = MPC_MAX_PREC (rop);
+   N = prec + mpc_ceil_log2 (prec) + 10;
+   mpc_init2 (x, 2);
+   for (;;) {
+      agm_approx (x, a, b, N);
+      /* |x - AGM (a, b)| <= 2^(1-N) |AGM (a, b)| <= 2^(2-N) |x| */
+      lost = mpc_agm_check (x, N - 2, zero, rop, rnd);
+      if (lost == 0)
+         break;
+      N += lost + mpc_ceil_log2 (N) + 10;
+   }
+
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+   inex_re = mpc_agm_round (rop, x, zero, rnd);
+   if (zero & 1)
+      mpfr_setsign (mpc_realref (rop), mpc_realref (rop), sign_re,
+                    MPFR_RNDN);
+   if (zero & 2)
+      mpfr_setsign (mpc_imagref (rop), mpc_imagref (rop), sign_im,
+                    MPFR_RNDN);
+
+   mpc_clear (x);
+
+   return inex_re;
+}
+
+int
+mpc_agm (mpc_ptr rop, mpc_srcptr a, mpc_srcptr b, mpc_rnd_t rnd)
+{
+   return agm (rop, a, b, rnd);
+}
+
+int
+mpc_agm1 (mpc_ptr rop, mpc_srcptr z, mpc_rnd_t rnd)
+{
+   return agm (rop, NULL, z, rnd);
+}
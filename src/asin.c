@@ -28,6 +28,8 @@ mpc_asin (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   mpc_t z1;
   int inex;
 
+  MPC_STATS_CALL (ASIN);
+
   /* special values */
   if (mpfr_nan_p (mpc_realref (op)) || mpfr_nan_p (mpc_imagref (op)))
     {
@@ -149,6 +151,7 @@ mpc_asin (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     mpfr_exp_t ex, ey, err;
 
     p += mpc_ceil_log2 (p) + 3 + incr_p; /* incr_p is zero initially */
+    MPC_STATS_LOOP (ASIN, p);
     incr_p = p / 2;
     mpfr_set_prec (mpc_realref(z1), p);
     mpfr_set_prec (mpc_imagref(z1), p);
@@ -212,14 +215,12 @@ mpc_asin (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     /* z1 <- -i*z1 */
     mpfr_swap (mpc_realref(z1), mpc_imagref(z1));
     mpfr_neg (mpc_imagref(z1), mpc_imagref(z1), MPFR_RNDN);
-    if (mpfr_can_round (mpc_realref(z1), p - err, MPFR_RNDN, MPFR_RNDZ,
-                        p_re + (rnd_re == MPFR_RNDN)) &&
-        mpfr_can_round (mpc_imagref(z1), p - err, MPFR_RNDN, MPFR_RNDZ,
-                        p_im + (rnd_im == MPFR_RNDN)))
+    if (MPC_CAN_ROUND (mpc_realref(z1), p - err, p_re, rnd_re) &&
+        MPC_CAN_ROUND (mpc_imagref(z1), p - err, p_im, rnd_im))
       break;
   }
 
-  inex = mpc_set (rop, z1, rnd);
+  inex = mpc_set (rop, z1, MPC_RND_FTON_C (rnd));
   mpc_clear (z1);
 
   return inex;
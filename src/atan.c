@@ -31,7 +31,7 @@ set_pi_over_2 (mpfr_ptr rop, int s, mpfr_rnd_t rnd)
 {
   int inex;
 
-  inex = mpfr_const_pi (rop, s < 0 ? INV_RND (rnd) : rnd);
+  inex = mpc_const_pi (rop, s < 0 ? INV_RND (rnd) : rnd);
   mpfr_div_2ui (rop, rop, 1, MPFR_RNDN);
   if (s < 0)
     {
@@ -51,6 +51,8 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   int inex_im;
   int inex;
 
+  MPC_STATS_CALL (ATAN);
+
   inex_re = 0;
   inex_im = 0;
   s_re = mpfr_signbit (mpc_realref (op));
@@ -232,6 +234,7 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     do
       {
         p += mpc_ceil_log2 (p) + 2;
+        MPC_STATS_LOOP (ATAN, p);
         mpfr_set_prec (a, p);
         mpfr_set_prec (b, p);
         mpfr_set_prec (x, p);
@@ -277,8 +280,10 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 
         /* Note: using RND2=RNDD guarantees that if x is exactly representable
            on prec + ... bits, mpfr_can_round will return 0 */
-        ok = mpfr_can_round (x, p - err, MPFR_RNDU, MPFR_RNDD,
-                             prec + (MPC_RND_RE (rnd) == MPFR_RNDN));
+        ok = MPC_IS_LIKE_RNDF (MPC_RND_RE (rnd))
+          ? MPC_CAN_ROUND (x, p - err, prec, MPC_RND_RE (rnd))
+          : mpfr_can_round (x, p - err, MPFR_RNDU, MPFR_RNDD,
+                            prec + (MPC_RND_RE (rnd) == MPFR_RNDN));
       } while (ok == 0);
 
     /* Imaginary part
@@ -308,6 +313,7 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     do
       {
         p += mpc_ceil_log2 (p) + err;
+        MPC_STATS_LOOP (ATAN, p);
         mpfr_set_prec (a, p);
         mpfr_set_prec (b, p);
         mpfr_set_prec (y, p);
@@ -354,12 +360,14 @@ mpc_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
                   should be true. This needs a proof, or better yet,
                   special code.                                              */
 
-            ok = mpfr_can_round (y, p - err, MPFR_RNDU, MPFR_RNDD,
-                                 prec + (MPC_RND_IM (rnd) == MPFR_RNDN));
+            ok = MPC_IS_LIKE_RNDF (MPC_RND_IM (rnd))
+              ? MPC_CAN_ROUND (y, p - err, prec, MPC_RND_IM (rnd))
+              : mpfr_can_round (y, p - err, MPFR_RNDU, MPFR_RNDD,
+                                prec + (MPC_RND_IM (rnd) == MPFR_RNDN));
           }
       } while (ok == 0);
 
-    inex = mpc_set_fr_fr (rop, x, y, rnd);
+    inex = mpc_set_fr_fr (rop, x, y, MPC_RND_FTON_C (rnd));
 
     mpfr_clears (a, b, x, y, (mpfr_ptr) 0);
     return inex;
@@ -0,0 +1,383 @@
+/* mpc_const_pi, mpc_const_log2, mpc_const_log10, mpc_free_cache,
+   mpc_cache_save, mpc_cache_load -- Cached mathematical constants
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdio.h>
+#include <string.h> /* for memcmp */
+#include "mpc-impl.h"
+
+/* Each constant is kept, rounded down, at the largest precision computed
+   so far in the calling thread. Since the constants are irrational, the
+   exact value c lies in the open interval (x, x + ulp(x)) for the cached
+   value x, and a request at a smaller precision is served by rounding x
+   as soon as this determines the rounding of c; otherwise, and for
+   requests at a larger precision, the constant is computed again at a
+   precision increased by at least one half. Without thread-local
+   storage, the cache only lives for the duration of one call. */
+
+#define MPC_CONST_PI    0
+#define MPC_CONST_LOG2  1
+#define MPC_CONST_LOG10 2
+#define MPC_CONST_NUMBER 3
+
+#define MPC_CONST_MIN_PREC 64
+   /* smallest precision of a cached value */
+
+typedef struct {
+   mpfr_prec_t prec;
+      /* precision of x, or 0 if x is not initialised */
+   __mpfr_struct x;
+}
+__mpc_const_struct;
+
+#ifdef MPC_THREAD_ATTR
+static MPC_THREAD_ATTR __mpc_const_struct mpc_const_cache [MPC_CONST_NUMBER];
+#endif
+
+/* sets x to the constant number i rounded down, for a precision of x of
+   at least 4 */
+static void
+const_value (mpfr_ptr x, int i)
+{
+   mpfr_exp_t emin = mpfr_get_emin ();
+   mpfr_exp_t emax = mpfr_get_emax ();
+
+   /* the constants do not depend on the exponent range of the caller */
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+   if (i == MPC_CONST_PI)
+      mpfr_const_pi (x, MPFR_RNDD);
+   else if (i == MPC_CONST_LOG2)
+      mpfr_const_log2 (x, MPFR_RNDD);
+   else {
+      mpfr_set_ui (x, 10, MPFR_RNDN); /* exact */
+      mpfr_log (x, x, MPFR_RNDD);
+   }
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+}
+
+/* sets the value of the cache entry c for constant number i to at least
+   prec bits, rounded down */
+static void
+const_compute (__mpc_const_struct *c, int i, mpfr_prec_t prec)
+{
+   prec = MPC_MAX (prec, c->prec + c->prec / 2);
+   prec = MPC_MAX (prec, MPC_CONST_MIN_PREC);
+   if (c->prec == 0)
+      mpfr_init2 (&(c->x), prec);
+   else
+      mpfr_set_prec (&(c->x), prec);
+   c->prec = prec;
+   const_value (&(c->x), i);
+}
+
+/* sets rop to the constant number i rounded in the direction rnd, using
+   and updating the cache entry c */
+static int
+const_get (mpfr_ptr rop, __mpc_const_struct *c, int i, mpfr_rnd_t rnd)
+{
+   mpfr_prec_t prec = mpfr_get_prec (rop);
+   int inex;
+
+   if (c->prec < prec + GMP_NUMB_BITS / 2)
+      const_compute (c, i, prec + GMP_NUMB_BITS / 2);
+   while (!MPC_CAN_ROUND (&(c->x), c->prec, prec, rnd))
+      const_compute (c, i, c->prec + GMP_NUMB_BITS);
+
+   inex = mpfr_set (rop, &(c->x), MPC_RND_FTON (rnd));
+   /* If x is representable in the precision of rop, then the exact
+      constant is larger than rop. */
+   return (inex != 0 ? inex : -1);
+}
+
+static int
+mpc_const (mpfr_ptr rop, int i, mpfr_rnd_t rnd)
+{
+#ifdef MPC_THREAD_ATTR
+   return const_get (rop, &(mpc_const_cache [i]), i, rnd);
+#else
+   __mpc_const_struct c;
+   int inex;
+
+   c.prec = 0;
+   inex = const_get (rop, &c, i, rnd);
+   mpfr_clear (&(c.x));
+   return inex;
+#endif
+}
+
+int
+mpc_const_pi (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return mpc_const (rop, MPC_CONST_PI, rnd);
+}
+
+int
+mpc_const_log2 (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return mpc_const (rop, MPC_CONST_LOG2, rnd);
+}
+
+int
+mpc_const_log10 (mpfr_ptr rop, mpfr_rnd_t rnd)
+{
+   return mpc_const (rop, MPC_CONST_LOG10, rnd);
+}
+
+void
+mpc_free_cache (void)
+{
+#ifdef MPC_THREAD_ATTR
+   int i;
+
+   for (i = 0; i < MPC_CONST_NUMBER; i++)
+      if (mpc_const_cache [i].prec != 0) {
+         mpfr_clear (&(mpc_const_cache [i].x));
+         mpc_const_cache [i].prec = 0;
+      }
+#endif
+}
+
+
+/* A constant file starts with a header of MPC_CONST_MAGIC_SIZE characters,
+   the format version, the value 0x01020304 to recognise the byte order,
+   GMP_NUMB_BITS and MPC_CONST_NUMBER, all as unsigned int. For each
+   constant, it contains its precision and its exponent as long, followed
+   by the limbs of its significand, least significant first. A checksum of
+   all these numbers, as an mp_limb_t, ends the file. The numbers are
+   written in the binary representation of the machine, so that a file
+   can only be read on a machine and with a build of GMP of the same kind
+   as the one which has written it. */
+
+#define MPC_CONST_MAGIC "GNU MPC constants\n"
+#define MPC_CONST_MAGIC_SIZE 18
+#define MPC_CONST_VERSION 1
+
+/* updates the checksum with the n limbs of p */
+static mp_limb_t
+const_checksum (mp_limb_t sum, const mp_limb_t *p, size_t n)
+{
+   size_t i;
+
+   for (i = 0; i < n; i++)
+      sum = ((sum << 1) | (sum >> (GMP_NUMB_BITS - 1))) ^ p [i];
+   return sum;
+}
+
+static size_t
+const_limbs (mpfr_prec_t prec)
+{
+   return (size_t) ((prec - 1) / GMP_NUMB_BITS + 1);
+}
+
+static int
+const_write (FILE *f, __mpc_const_struct *c)
+{
+   unsigned int h [4] = {MPC_CONST_VERSION, 0x01020304, GMP_NUMB_BITS,
+                         MPC_CONST_NUMBER};
+   mp_limb_t sum = 0, t [2];
+   long l [2];
+   int i;
+
+   if (fwrite (MPC_CONST_MAGIC, 1, MPC_CONST_MAGIC_SIZE, f)
+          != MPC_CONST_MAGIC_SIZE
+       || fwrite (h, sizeof (unsigned int), 4, f) != 4)
+      return -1;
+   for (i = 0; i < MPC_CONST_NUMBER; i++) {
+      const mp_limb_t *p = (const mp_limb_t *)
+         mpfr_custom_get_significand (&(c [i].x));
+      size_t n = const_limbs (c [i].prec);
+
+      l [0] = (long) c [i].prec;
+      l [1] = (long) mpfr_get_exp (&(c [i].x));
+      t [0] = (mp_limb_t) l [0];
+      t [1] = (mp_limb_t) l [1];
+      sum = const_checksum (sum, t, 2);
+      sum = const_checksum (sum, p, n);
+      if (fwrite (l, sizeof (long), 2, f) != 2
+          || fwrite (p, sizeof (mp_limb_t), n, f) != n)
+         return -1;
+   }
+   if (fwrite (&sum, sizeof (mp_limb_t), 1, f) != 1)
+      return -1;
+   return 0;
+}
+
+/* reads the constants of f into the variables x, which have to be
+   initialised; returns 0 on success and -1 if f is not a valid constant
+   file */
+static int
+const_read (FILE *f, __mpfr_struct *x)
+{
+   char magic [MPC_CONST_MAGIC_SIZE];
+   unsigned int h [4];
+   mp_limb_t sum = 0, t [2], s, *p;
+   long l [2];
+   mpfr_t y, z, w;
+   size_t n, avail;
+   long pos, end;
+   int i, ok;
+   void * (*allocfunc) (size_t);
+   void (*freefunc) (void *, size_t);
+
+   if (fread (magic, 1, MPC_CONST_MAGIC_SIZE, f) != MPC_CONST_MAGIC_SIZE
+       || memcmp (magic, MPC_CONST_MAGIC, MPC_CONST_MAGIC_SIZE) != 0
+       || fread (h, sizeof (unsigned int), 4, f) != 4
+       || h [0] != MPC_CONST_VERSION || h [1] != 0x01020304
+       || h [2] != GMP_NUMB_BITS || h [3] != MPC_CONST_NUMBER)
+      return -1;
+
+   /* The significands cannot be longer than the rest of the file, which
+      bounds the memory allocated for a corrupted precision. */
+   if (   (pos = ftell (f)) < 0 || fseek (f, 0, SEEK_END) != 0
+       || (end = ftell (f)) < pos || fseek (f, pos, SEEK_SET) != 0)
+      return -1;
+   avail = (size_t) (end - pos);
+
+   mp_get_memory_functions (&allocfunc, NULL, &freefunc);
+   mpfr_init2 (z, MPC_CONST_MIN_PREC);
+   mpfr_init2 (w, MPC_CONST_MIN_PREC);
+   ok = 1;
+   for (i = 0; ok && i < MPC_CONST_NUMBER; i++) {
+      const_value (z, i);
+      if (fread (l, sizeof (long), 2, f) != 2
+          || l [0] < MPC_CONST_MIN_PREC || l [0] > MPFR_PREC_MAX
+          || l [1] != mpfr_get_exp (z)) {
+         ok = 0;
+         break;
+      }
+      n = const_limbs ((mpfr_prec_t) l [0]);
+      if (avail < 2 * sizeof (long)
+          || n > (avail - 2 * sizeof (long)) / sizeof (mp_limb_t)) {
+         ok = 0;
+         break;
+      }
+      avail -= 2 * sizeof (long) + n * sizeof (mp_limb_t);
+      p = (mp_limb_t *) (*allocfunc) (n * sizeof (mp_limb_t));
+      /* The significand has to be normalised, with its bits beyond the
+         precision set to 0. */
+      ok =    fread (p, sizeof (mp_limb_t), n, f) == n
+           && (p [n - 1] >> (GMP_NUMB_BITS - 1)) == 1
+           && ((p [0] << (((mpfr_prec_t) l [0] - 1) % GMP_NUMB_BITS)) << 1)
+              == 0;
+      if (ok) {
+         t [0] = (mp_limb_t) l [0];
+         t [1] = (mp_limb_t) l [1];
+         sum = const_checksum (sum, t, 2);
+         sum = const_checksum (sum, p, n);
+         /* the value rounded down to MPC_CONST_MIN_PREC bits has to be
+            the constant rounded down */
+         mpfr_custom_init_set (y, MPFR_REGULAR_KIND, (mpfr_exp_t) l [1],
+                               (mpfr_prec_t) l [0], p);
+         mpfr_set (w, y, MPFR_RNDD);
+         ok = mpfr_equal_p (w, z);
+         mpfr_set_prec (&(x [i]), (mpfr_prec_t) l [0]);
+         mpfr_set (&(x [i]), y, MPFR_RNDN); /* exact */
+      }
+      (*freefunc) (p, n * sizeof (mp_limb_t));
+   }
+   mpfr_clear (z);
+   mpfr_clear (w);
+
+   if (!ok || fread (&s, sizeof (mp_limb_t), 1, f) != 1 || s != sum)
+      return -1;
+   return 0;
+}
+
+/* Writes the constants into the file of the given name, with enough bits
+   for the first two iterations of the Ziv loops of the functions at
+   precision prec, which ask for their precision increased by its
+   logarithm and a few bits each. Returns 0 on success and -1 on error. */
+int
+mpc_cache_save (const char *filename, mpfr_prec_t prec)
+{
+   __mpc_const_struct *c;
+   FILE *f;
+   int i, ret;
+#ifdef MPC_THREAD_ATTR
+   c = mpc_const_cache;
+#else
+   __mpc_const_struct d [MPC_CONST_NUMBER];
+
+   c = d;
+   for (i = 0; i < MPC_CONST_NUMBER; i++)
+      c [i].prec = 0;
+#endif
+
+   prec += 2 * (mpc_ceil_log2 (prec) + GMP_NUMB_BITS);
+   for (i = 0; i < MPC_CONST_NUMBER; i++)
+      if (c [i].prec < prec)
+         const_compute (&(c [i]), i, prec);
+
+   f = fopen (filename, "wb");
+   if (f == NULL)
+      ret = -1;
+   else {
+      ret = const_write (f, c);
+      if (fclose (f) != 0)
+         ret = -1;
+   }
+
+#ifndef MPC_THREAD_ATTR
+   for (i = 0; i < MPC_CONST_NUMBER; i++)
+      mpfr_clear (&(c [i].x));
+#endif
+
+   return ret;
+}
+
+/* Reads the constants from the file of the given name into the cache of
+   the calling thread, where they replace the values of smaller precision.
+   Returns 0 on success and -1 if the file cannot be read, if it is not a
+   valid constant file, or without thread-local storage. */
+int
+mpc_cache_load (const char *filename)
+{
+#ifdef MPC_THREAD_ATTR
+   __mpfr_struct x [MPC_CONST_NUMBER];
+   FILE *f;
+   int i, ret;
+
+   f = fopen (filename, "rb");
+   if (f == NULL)
+      return -1;
+   for (i = 0; i < MPC_CONST_NUMBER; i++)
+      mpfr_init2 (&(x [i]), MPC_CONST_MIN_PREC);
+   ret = const_read (f, x);
+   fclose (f);
+
+   for (i = 0; i < MPC_CONST_NUMBER; i++) {
+      __mpc_const_struct *c = &(mpc_const_cache [i]);
+
+      if (ret == 0 && mpfr_get_prec (&(x [i])) > c->prec) {
+         if (c->prec != 0)
+            mpfr_clear (&(c->x));
+         c->x = x [i];
+         c->prec = mpfr_get_prec (&(x [i]));
+      }
+      else
+         mpfr_clear (&(x [i]));
+   }
+   return ret;
+#else
+   return -1;
+#endif
+}
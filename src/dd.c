@@ -0,0 +1,497 @@
+/* dd -- Fast paths in double precision for mpc_mul, mpc_sqr, mpc_div, mpc_fma
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include "mpc-impl.h"
+
+/* When the parts of the operands have a precision of at most 53 bits and
+   the parts of the result a precision of exactly 53 bits, the functions
+   of this file compute the result with the error-free transformations
+   TwoSum and TwoProduct in hardware double precision arithmetic: the
+   exact result is obtained as a sum of doubles, whose correct rounding
+   is determined together with the ternary value from an error bound on
+   the last approximation, as in a Ziv loop. They return MPC_DD_FAIL
+   without modifying the result if an operand is not a double or is too
+   large or too small, if an exact result is zero, which would need the
+   rules for the sign of zero, or if the rounding cannot be decided; the
+   caller then uses the usual algorithm.
+
+   This requires IEEE 754 double precision arithmetic without extended
+   precision for intermediate results, and the rounding to nearest for
+   the hardware operations, which is checked at each call. */
+
+#if defined (FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0 \
+   && FLT_RADIX == 2 && DBL_MANT_DIG == 53 && DBL_MAX_EXP == 1024 \
+   && DBL_MIN_EXP == -1021
+#define MPC_DD 1
+#endif
+
+#ifdef MPC_DD
+
+/* bounds on the exponents of the operands such that no intermediate
+   result overflows or underflows */
+#define DD_EMAX_MUL 400
+#define DD_EMAX_DIV 250
+
+/* returned by the functions for real results instead of a ternary value,
+   which may be -1 like MPC_DD_FAIL */
+#define DD_FAIL 2
+
+/* bounds on the absolute value of a result in double precision that keep
+   it far from the subnormal numbers and from the overflow threshold */
+#define DD_MIN 0x1p-900
+#define DD_MAX 0x1p1000
+
+/* With limbs of 64 bits, a double and a number of precision at most 53
+   are converted into each other through their bits instead of mpfr_get_d
+   and mpfr_set_d, which take most of the time otherwise. */
+#if GMP_NUMB_BITS == 64 && GMP_NAIL_BITS == 0
+#define DD_BITS 1
+#define DD_MANT_MASK ((((mp_limb_t) 1) << 52) - 1)
+#endif
+
+/* the hardware rounding mode may only be checked at run time */
+static volatile double dd_one = 1.0, dd_tiny = 0x1p-54;
+
+/* returns 1 if the hardware rounds to nearest and if the current exponent
+   range of MPFR contains all double precision numbers */
+static int
+dd_ok_p (void)
+{
+#ifdef DD_BITS
+   /* the bits of a double are in the order of those of an integer */
+   const double one = 1.0;
+   mp_limb_t bits;
+
+   memcpy (&bits, &one, sizeof (double));
+   if (sizeof (double) != sizeof (mp_limb_t)
+       || bits != ((mp_limb_t) 1023) << 52)
+      return 0;
+#endif
+
+   /* 1 + 3/4 ulp is rounded to 1 + ulp towards +infinity and to nearest,
+      -1 - 3/4 ulp to -1 - ulp towards -infinity and to nearest */
+   return    dd_one + 3 * dd_tiny == 1.0 + 0x1p-52
+          && -dd_one - 3 * dd_tiny == -1.0 - 0x1p-52
+          && mpfr_get_emin () <= DBL_MIN_EXP - DBL_MANT_DIG
+          && mpfr_get_emax () >= DBL_MAX_EXP;
+}
+
+/* s + e = a + b exactly with s = fl(a + b) */
+#define TWO_SUM(s,e,a,b)                                        \
+   do {                                                         \
+      double _a = (a), _b = (b), _bb;                           \
+      s = _a + _b;                                              \
+      _bb = s - _a;                                             \
+      e = (_a - (s - _bb)) + (_b - _bb);                        \
+   } while (0)
+
+/* p + e = a * b exactly with p = fl(a * b), if there is no underflow */
+static void
+two_prod (double *p, double *e, double a, double b)
+{
+#ifdef FP_FAST_FMA
+   *p = a * b;
+   *e = fma (a, b, -*p);
+#else
+   /* Dekker's product with Veltkamp's splitting */
+   double c, ah, al, bh, bl;
+
+   c = 134217729.0 * a; /* 2^27 + 1 */
+   ah = c - (c - a);
+   al = a - ah;
+   c = 134217729.0 * b;
+   bh = c - (c - b);
+   bl = b - bh;
+   *p = a * b;
+   *e = ((ah * bh - *p) + ah * bl + al * bh) + al * bl;
+#endif
+}
+
+/* If x is a zero or a regular number of precision at most 53 with an
+   exponent between -emax and emax, stores it in *d and returns 1,
+   otherwise returns 0. */
+static int
+dd_get (double *d, mpfr_srcptr x, mpfr_exp_t emax)
+{
+   if (mpfr_get_prec (x) > DBL_MANT_DIG)
+      return 0;
+   else if (mpfr_zero_p (x))
+      *d = 0.0;
+   else if (!mpfr_regular_p (x) || mpfr_get_exp (x) > emax
+            || mpfr_get_exp (x) < -emax)
+      return 0;
+   else {
+#ifdef DD_BITS
+      /* x = 0.1m * 2^e is 1.m * 2^(e-1), with a biased exponent of
+         e - 1 + 1023 in the double */
+      mp_limb_t m = *(mp_limb_t *) mpfr_custom_get_significand ((mpfr_ptr) x);
+      mp_limb_t bits = (((mp_limb_t) (mpfr_get_exp (x) + 1022)) << 52)
+                       | ((m >> 11) & DD_MANT_MASK);
+
+      if (mpfr_signbit (x))
+         bits |= ((mp_limb_t) 1) << 63;
+      memcpy (d, &bits, sizeof (double));
+#else
+      *d = mpfr_get_d (x, MPFR_RNDN); /* exact */
+#endif
+   }
+   return 1;
+}
+
+/* returns 1 if the parts of z are doubles as for dd_get, 0 otherwise */
+static int
+dd_get_c (double *re, double *im, mpc_srcptr z, mpfr_exp_t emax)
+{
+   return dd_get (re, mpc_realref (z), emax) && dd_get (im, mpc_imagref (z), emax);
+}
+
+/* returns 1 if both parts of z have the precision of a double */
+static int
+dd_prec_p (mpc_srcptr z)
+{
+   return MPC_PREC_RE (z) == DBL_MANT_DIG && MPC_PREC_IM (z) == DBL_MANT_DIG;
+}
+
+/* Stores in *h, *t and *err an approximation of the exact sum of the n
+   doubles of x such that this sum is h + t + eps with |eps| <= err; err
+   is zero if the sum is exactly h + t. The terms should be given by
+   decreasing order of magnitude, roughly. */
+static void
+dd_sum (double *h, double *t, double *err, const double *x, int n)
+{
+   double s, e, tail = 0.0, abs_tail = 0.0;
+   int i;
+
+   s = x [0];
+   for (i = 1; i < n; i++) {
+      TWO_SUM (s, e, s, x [i]);
+      tail += e;
+      abs_tail += fabs (e);
+   }
+   *h = s;
+   *t = tail;
+   /* the n - 2 roundings in the sum of the errors yield an error of at
+      most (n - 2) * 2^-53 * abs_tail, up to second order terms */
+   *err = abs_tail * (n - 2) * 0x1p-52;
+}
+
+/* Given an exact value v = h + t + eps with |eps| <= err, stores in *r
+   the rounding of v to a double in the direction rnd and returns the
+   ternary value, or returns DD_FAIL if this cannot be decided. */
+static int
+dd_round (double *r, double h, double t, double err, mpfr_rnd_t rnd)
+{
+   double l, c, up, down, dup, ddown, err2;
+   int sign;
+
+   TWO_SUM (h, l, h, t);
+   if (!(fabs (h) >= DD_MIN && fabs (h) <= DD_MAX))
+      return DD_FAIL;
+   if (l == 0.0 && err == 0.0) {
+      *r = h;
+      return 0;
+   }
+
+   /* successor and predecessor of h, see Rump, Zimmermann, Boldo and
+      Melquiond, Computing predecessor and successor in rounding to
+      nearest, BIT Numerical Mathematics 49(2), 2009; the differences are
+      exact */
+   c = (0x1p-53 + 0x1p-105) * fabs (h);
+   up = h + c;
+   down = h - c;
+   dup = up - h;
+   ddown = h - down;
+
+   /* v - h = l + eps lies in [l - err, l + err]; err2 additionally covers
+      the rounding errors in the comparisons below */
+   err2 = err + (fabs (l) + dup + ddown) * 0x1p-52;
+   if (l > err)
+      sign = 1;
+   else if (l < -err)
+      sign = -1;
+   else
+      return DD_FAIL;
+
+   if (rnd == MPFR_RNDZ)
+      rnd = (h > 0 ? MPFR_RNDD : MPFR_RNDU);
+   switch (rnd) {
+   case MPFR_RNDN:
+      if (l + err2 < 0.5 * dup && l - err2 > -0.5 * ddown) {
+         *r = h;
+         return -sign;
+      }
+      return DD_FAIL;
+   case MPFR_RNDU:
+   case MPFR_RNDD:
+      if (sign > 0 && l + err2 < dup) {
+         /* h < v < up */
+         *r = (rnd == MPFR_RNDU ? up : h);
+         return (rnd == MPFR_RNDU ? 1 : -1);
+      }
+      else if (sign < 0 && l - err2 > -ddown) {
+         /* down < v < h */
+         *r = (rnd == MPFR_RNDU ? h : down);
+         return (rnd == MPFR_RNDU ? 1 : -1);
+      }
+      return DD_FAIL;
+   default:
+      return DD_FAIL;
+   }
+}
+
+/* rounds the exact sum of the n doubles of x as dd_round */
+static int
+dd_round_sum (double *r, const double *x, int n, mpfr_rnd_t rnd)
+{
+   double h, t, err;
+
+   dd_sum (&h, &t, &err, x, n);
+   return dd_round (r, h, t, err, rnd);
+}
+
+/* sets x of precision 53 to the non-zero normal double d */
+static void
+dd_set_fr (mpfr_ptr x, double d)
+{
+#ifdef DD_BITS
+   mp_limb_t bits;
+
+   mp_limb_t *m = (mp_limb_t *) mpfr_custom_get_significand (x);
+
+   memcpy (&bits, &d, sizeof (double));
+   *m = ((bits & DD_MANT_MASK) | (((mp_limb_t) 1) << 52)) << 11;
+   /* set the kind, exponent and sign of x while keeping its significand,
+      which avoids function calls since mpfr_custom_init_set is a macro */
+   mpfr_custom_init_set (x, d < 0 ? -MPFR_REGULAR_KIND : MPFR_REGULAR_KIND,
+                         (mpfr_exp_t) ((bits >> 52) & 2047) - 1022,
+                         DBL_MANT_DIG, m);
+#else
+   mpfr_set_d (x, d, MPFR_RNDN); /* exact */
+#endif
+}
+
+/* sets z to re + i*im and returns the ternary value of inex_re and inex_im */
+static int
+dd_set (mpc_ptr z, double re, double im, int inex_re, int inex_im)
+{
+   dd_set_fr (mpc_realref (z), re);
+   dd_set_fr (mpc_imagref (z), im);
+   if (inex_re != 0 || inex_im != 0)
+      mpfr_set_inexflag ();
+   return MPC_INEX (inex_re, inex_im);
+}
+
+#endif /* MPC_DD */
+
+
+int
+mpc_mul_dd (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
+{
+#ifdef MPC_DD
+   double a, b, c, d, re, im, s [4];
+   int inex_re, inex_im;
+
+   if (   !dd_prec_p (z)
+       || !dd_get_c (&a, &b, x, DD_EMAX_MUL)
+       || !dd_get_c (&c, &d, y, DD_EMAX_MUL)
+       || !dd_ok_p ())
+      return MPC_DD_FAIL;
+
+   /* re = a*c - b*d */
+   two_prod (&s [0], &s [2], a, c);
+   two_prod (&s [1], &s [3], -b, d);
+   inex_re = dd_round_sum (&re, s, 4, MPC_RND_RE (rnd));
+   if (inex_re == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   /* im = a*d + b*c */
+   two_prod (&s [0], &s [2], a, d);
+   two_prod (&s [1], &s [3], b, c);
+   inex_im = dd_round_sum (&im, s, 4, MPC_RND_IM (rnd));
+   if (inex_im == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   return dd_set (z, re, im, inex_re, inex_im);
+#else
+   return MPC_DD_FAIL;
+#endif
+}
+
+
+int
+mpc_sqr_dd (mpc_ptr z, mpc_srcptr x, mpc_rnd_t rnd)
+{
+#ifdef MPC_DD
+   double a, b, re, im, s [4];
+   int inex_re, inex_im;
+
+   if (   !dd_prec_p (z)
+       || !dd_get_c (&a, &b, x, DD_EMAX_MUL)
+       || !dd_ok_p ())
+      return MPC_DD_FAIL;
+
+   /* re = a^2 - b^2 */
+   two_prod (&s [0], &s [2], a, a);
+   two_prod (&s [1], &s [3], -b, b);
+   inex_re = dd_round_sum (&re, s, 4, MPC_RND_RE (rnd));
+   if (inex_re == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   /* im = 2*a*b */
+   two_prod (&s [0], &s [1], 2 * a, b);
+   inex_im = dd_round_sum (&im, s, 2, MPC_RND_IM (rnd));
+   if (inex_im == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   return dd_set (z, re, im, inex_re, inex_im);
+#else
+   return MPC_DD_FAIL;
+#endif
+}
+
+
+int
+mpc_fma_dd (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_srcptr w,
+            mpc_rnd_t rnd)
+{
+#ifdef MPC_DD
+   double a, b, c, d, e, f, re, im, s [5];
+   int inex_re, inex_im;
+
+   if (   !dd_prec_p (z)
+       || !dd_get_c (&a, &b, x, DD_EMAX_MUL)
+       || !dd_get_c (&c, &d, y, DD_EMAX_MUL)
+       || !dd_get_c (&e, &f, w, DD_EMAX_MUL)
+       || !dd_ok_p ())
+      return MPC_DD_FAIL;
+
+   /* re = a*c - b*d + e */
+   two_prod (&s [0], &s [3], a, c);
+   two_prod (&s [1], &s [4], -b, d);
+   s [2] = e;
+   inex_re = dd_round_sum (&re, s, 5, MPC_RND_RE (rnd));
+   if (inex_re == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   /* im = a*d + b*c + f */
+   two_prod (&s [0], &s [3], a, d);
+   two_prod (&s [1], &s [4], b, c);
+   s [2] = f;
+   inex_im = dd_round_sum (&im, s, 5, MPC_RND_IM (rnd));
+   if (inex_im == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   return dd_set (z, re, im, inex_re, inex_im);
+#else
+   return MPC_DD_FAIL;
+#endif
+}
+
+
+#ifdef MPC_DD
+/* Rounds the quotient of the exact sums of the 4 doubles of n and of
+   the 4 positive doubles of d as dd_round. */
+static int
+dd_round_quo (double *r, const double *n, const double *d, mpfr_rnd_t rnd)
+{
+   double nh, nl, nerr, dh, dl, derr, q, p, pe, s, rem, err, t;
+
+   /* n = nh + nl +- nerr, d = dh + dl +- derr with nl and dl at most half
+      an ulp of nh and dh */
+   dd_sum (&nh, &nl, &nerr, n, 4);
+   TWO_SUM (nh, nl, nh, nl);
+   dd_sum (&dh, &dl, &derr, d, 4);
+   TWO_SUM (dh, dl, dh, dl);
+   if (nh == 0.0)
+      return DD_FAIL;
+
+   q = nh / dh;
+   if (!(fabs (q) >= DD_MIN && fabs (q) <= DD_MAX))
+      return DD_FAIL;
+
+   /* The remainder n - q*d is approximated by rem; nh - p is exact by
+      Sterbenz's lemma, and the three other operations in rem each
+      introduce an error of at most 2^-53 times the sum of the absolute
+      values of the terms. */
+   two_prod (&p, &pe, q, dh);
+   s = nh - p;
+   rem = (s - pe) + (nl - q * dl);
+   err = (fabs (s) + fabs (pe) + fabs (nl) + fabs (q * dl)) * 0x1p-50
+         + nerr + fabs (q) * derr * 2;
+
+   /* n/d - q = (n - q*d)/d, with d = dh*(1 + delta), |delta| < 2^-50 */
+   t = rem / dh;
+   err = (err + fabs (rem) * 0x1p-48) / dh * 2 + fabs (t) * 0x1p-50;
+   if (nerr == 0.0 && derr == 0.0 && nl == 0.0 && dl == 0.0 && s == pe) {
+      /* exact quotient */
+      t = 0.0;
+      err = 0.0;
+   }
+   else if (!(err >= DBL_MIN) || (rem != 0.0 && !(fabs (t) >= DBL_MIN)))
+      /* For parts of very different exponents, the terms of the
+         remainder may be so small compared to the quotient that t or err
+         underflow, and an inexact quotient would be taken as exact. */
+      return DD_FAIL;
+
+   return dd_round (r, q, t, err, rnd);
+}
+#endif
+
+
+int
+mpc_div_dd (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
+{
+#ifdef MPC_DD
+   double a, b, c, d, re, im, n [4], m [4];
+   int inex_re, inex_im;
+
+   if (   !dd_prec_p (z)
+       || !dd_get_c (&a, &b, x, DD_EMAX_DIV)
+       || !dd_get_c (&c, &d, y, DD_EMAX_DIV)
+       || (c == 0.0 && d == 0.0)
+       || !dd_ok_p ())
+      return MPC_DD_FAIL;
+
+   /* the norm c^2 + d^2 */
+   two_prod (&m [0], &m [2], c, c);
+   two_prod (&m [1], &m [3], d, d);
+
+   /* re = (a*c + b*d) / (c^2 + d^2) */
+   two_prod (&n [0], &n [2], a, c);
+   two_prod (&n [1], &n [3], b, d);
+   inex_re = dd_round_quo (&re, n, m, MPC_RND_RE (rnd));
+   if (inex_re == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   /* im = (b*c - a*d) / (c^2 + d^2) */
+   two_prod (&n [0], &n [2], b, c);
+   two_prod (&n [1], &n [3], -a, d);
+   inex_im = dd_round_quo (&im, n, m, MPC_RND_IM (rnd));
+   if (inex_im == DD_FAIL)
+      return MPC_DD_FAIL;
+
+   return dd_set (z, re, im, inex_re, inex_im);
+#else
+   return MPC_DD_FAIL;
+#endif
+}
@@ -230,48 +230,220 @@ mpc_div_imag (mpc_ptr rop, mpc_srcptr z, mpc_srcptr w, mpc_rnd_t rnd)
 }
 
 
-int
-mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+/* The real and imaginary parts of b/c are the quotients of
+   re(b)*re(c) + im(b)*im(c) and im(b)*re(c) - re(b)*im(c) by the norm
+   re(c)^2 + im(c)^2. div_single computes the six real products exactly,
+   on the stack for small operands, so that each numerator and the norm
+   are sums of two exact terms, rounded only once by mpfr_add. The first
+   attempt at a working precision slightly above the target one thus
+   suffers from neither cancellation nor error accumulation; if it cannot
+   be rounded, the numerators and the norm are summed exactly, and each
+   part of the result is obtained by a single correctly rounded mpfr_div.
+   So there is at most one retry, instead of the loop of div_general,
+   which computes mpc_norm and mpc_mul anew in each iteration. At large
+   precisions, where mpc_mul needs only three real multiplications,
+   div_general remains the faster choice. */
+
+/* returns 1 if div_single is to be used for a = b/c with b and c finite
+   and c without zero part: b must not be zero, since the signs of zero
+   parts are determined by div_general; and since div_single computes six
+   exact products instead of the five real multiplications of mpc_norm and
+   mpc_mul, the precisions must lie below the thresholds of the
+   multiplications with three real products */
+static int
+single_p (mpc_srcptr a, mpc_srcptr b, mpc_srcptr c)
+{
+   mpfr_prec_t prec, karatsuba, gauss;
+
+   prec = MPC_MAX_PREC (a);
+   prec += mpc_ceil_log2 (prec) + 5;
+   prec = MPC_MAX (prec, MPC_MAX (MPC_MAX_PREC (b), MPC_MAX_PREC (c)));
+   mpc_get_mul_threshold (&karatsuba, &gauss);
+   return !mpc_zero_p (b) && prec <= MPC_MIN (karatsuba, gauss)
+      && mpc_in_range_p (b, c, c);
+}
+
+/* returns a precision for which the sum of x and y, not both zero, is
+   exact */
+static mpfr_prec_t
+sum_prec (mpfr_srcptr x, mpfr_srcptr y)
+{
+   if (mpfr_zero_p (x))
+      return mpfr_get_prec (y);
+   else if (mpfr_zero_p (y))
+      return mpfr_get_prec (x);
+   else
+      return MPC_MAX (mpfr_get_exp (x), mpfr_get_exp (y)) + 1
+             - MPC_MIN (MPC_EXP_ULP (x), MPC_EXP_ULP (y));
+}
+
+/* returns 1 if the approximation x of a quotient has neither over- nor
+   underflowed, and if its rounding to a lower precision cannot overflow */
+static int
+round_p (mpfr_srcptr x)
+{
+   return    mpfr_regular_p (x)
+          && mpfr_get_exp (x) > mpfr_get_emin ()
+          && mpfr_get_exp (x) < mpfr_get_emax ();
+}
+
+/* computes a = b/c with a single rounding per part, where b and c are
+   finite and satisfy mpc_in_range_p, b is not zero and c has no zero part;
+   returns MPC_DD_FAIL without changing a when the exact sums would need
+   an unreasonably large precision, which is only possible for huge
+   differences between the exponents of the operands */
+static int
+div_single (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+   __mpfr_struct p [6];
+   mp_limb_t s [6 * MPC_SMALL_SIZE];
+   int clear [6];
+   mpfr_t x, y, n;
+   mpfr_prec_t prec, prec_re, prec_im, prec_norm;
+   int saved_underflow, saved_overflow;
+   int i, ok, inex_x, inex_y, inex_n, inex_re, inex_im;
+
+   MPC_STATS_LOOP (DIV, MPC_MAX_PREC (a));
+
+   /* real numerator p[0] + p[1], imaginary numerator p[2] + p[3] and norm
+      p[4] + p[5]; all products are computed before a is changed, since it
+      may be one of the operands */
+   clear [0] = mpc_mul_exact (p, s, mpc_realref (b), mpc_realref (c), 0);
+   clear [1] = mpc_mul_exact (p + 1, s + MPC_SMALL_SIZE,
+                              mpc_imagref (b), mpc_imagref (c), 0);
+   clear [2] = mpc_mul_exact (p + 2, s + 2 * MPC_SMALL_SIZE,
+                              mpc_imagref (b), mpc_realref (c), 0);
+   clear [3] = mpc_mul_exact (p + 3, s + 3 * MPC_SMALL_SIZE,
+                              mpc_realref (b), mpc_imagref (c), 1);
+   clear [4] = mpc_mul_exact (p + 4, s + 4 * MPC_SMALL_SIZE,
+                              mpc_realref (c), mpc_realref (c), 0);
+   clear [5] = mpc_mul_exact (p + 5, s + 5 * MPC_SMALL_SIZE,
+                              mpc_imagref (c), mpc_imagref (c), 0);
+
+   prec = MPC_MAX_PREC (a);
+   prec += mpc_ceil_log2 (prec) + 5;
+   mpc_scratch_init2 (x, prec);
+   mpc_scratch_init2 (y, prec);
+   mpc_scratch_init2 (n, prec);
+
+   /* The quotients may over- or underflow, which is detected below; the
+      corresponding flags of MPFR must not be kept. */
+   saved_underflow = mpfr_underflow_p ();
+   saved_overflow = mpfr_overflow_p ();
+
+   /* The numerators and the norm have a relative error of at most
+      u = 2^(-prec), and the quotients of at most (1+u)^2/(1-u) - 1 < 4u,
+      so that their absolute error is less than 2^(exp-prec+3), unless all
+      operations are exact, in which case the quotients have not over- or
+      underflowed. An exact zero numerator gives +0, as the product
+      b*conj(c) with rounding towards zero in div_general. */
+   inex_x = mpfr_add (x, p, p + 1, MPFR_RNDN);
+   inex_y = mpfr_add (y, p + 2, p + 3, MPFR_RNDN);
+   inex_n = mpfr_add (n, p + 4, p + 5, MPFR_RNDN);
+   inex_x |= inex_n | mpfr_div (x, x, n, MPFR_RNDN);
+   inex_y |= inex_n | mpfr_div (y, y, n, MPFR_RNDN);
+   ok =    (inex_x == 0
+            || (round_p (x) && MPC_CAN_ROUND (x, prec - 3, MPC_PREC_RE (a),
+                                              MPC_RND_RE (rnd))))
+        && (inex_y == 0
+            || (round_p (y) && MPC_CAN_ROUND (y, prec - 3, MPC_PREC_IM (a),
+                                              MPC_RND_IM (rnd))));
+
+   mpfr_clear_underflow ();
+   mpfr_clear_overflow ();
+   if (saved_underflow)
+      mpfr_set_underflow ();
+   if (saved_overflow)
+      mpfr_set_overflow ();
+
+   if (ok) {
+      inex_re = mpfr_set (mpc_realref (a), x, MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (a), y, MPC_RND_IM (rnd));
+   }
+   else {
+      prec_re = sum_prec (p, p + 1);
+      prec_im = sum_prec (p + 2, p + 3);
+      prec_norm = sum_prec (p + 4, p + 5);
+      ok = MPC_MAX (prec_re, MPC_MAX (prec_im, prec_norm)) <= 64 * prec;
+      if (ok) {
+         MPC_STATS_LOOP (DIV, MPC_MAX (prec_re, MPC_MAX (prec_im, prec_norm)));
+         mpfr_set_prec (x, prec_re);
+         mpfr_set_prec (y, prec_im);
+         mpfr_set_prec (n, prec_norm);
+         mpfr_add (x, p, p + 1, MPFR_RNDN);
+         mpfr_add (y, p + 2, p + 3, MPFR_RNDN);
+         mpfr_add (n, p + 4, p + 5, MPFR_RNDN);
+         inex_re = mpfr_div (mpc_realref (a), x, n, MPC_RND_RE (rnd));
+         inex_im = mpfr_div (mpc_imagref (a), y, n, MPC_RND_IM (rnd));
+      }
+   }
+
+   for (i = 0; i < 6; i++)
+      if (clear [i])
+         mpc_scratch_clear (p + i);
+   mpc_scratch_clear (x);
+   mpc_scratch_clear (y);
+   mpc_scratch_clear (n);
+
+   return ok ? MPC_INEX (inex_re, inex_im) : MPC_DD_FAIL;
+}
+
+
+/* sets the norm of pc->op rounded up and its inverse rounded towards zero
+   in pc at precision prec, as computed in the loop of div_general; the
+   flags of MPFR are preserved */
+static void
+div_precomp_set (mpc_div_precomp_ptr pc, mpfr_prec_t prec)
+{
+   int saved_underflow = mpfr_underflow_p ();
+   int saved_overflow = mpfr_overflow_p ();
+
+   pc->prec = prec;
+   mpfr_set_prec (pc->norm, prec);
+   mpfr_set_prec (pc->inv, prec);
+   mpfr_clear_underflow ();
+   mpfr_clear_overflow ();
+   pc->inex_norm = mpc_norm (pc->norm, pc->op, MPFR_RNDU);
+   pc->underflow = mpfr_underflow_p ();
+   pc->overflow = mpfr_overflow_p ();
+   if (pc->underflow)
+      mpfr_set_ui (pc->norm, 0ul, MPFR_RNDN);
+   pc->inex_inv = mpfr_ui_div (pc->inv, 1ul, pc->norm, MPFR_RNDZ);
+
+   mpfr_clear_underflow ();
+   mpfr_clear_overflow ();
+   if (saved_underflow)
+     mpfr_set_underflow ();
+   if (saved_overflow)
+     mpfr_set_overflow ();
+}
+
+
+/* computes a = b/c, where b and c are finite, and c has no zero part; if pc
+   is not NULL, then c is pc->op, and the norm of c and its inverse are
+   taken from pc, and added to it at higher precisions when needed */
+static int
+div_general (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd,
+             mpc_div_precomp_ptr pc)
 {
    int ok_re = 0, ok_im = 0;
    mpc_t res, c_conj;
    mpfr_t q;
+   mpfr_srcptr norm, inv;
    mpfr_prec_t prec;
-   int inex, inexact_prod, inexact_norm, inexact_re, inexact_im, loops = 0;
+   int inex, inexact_prod, inexact_norm, inexact_inv, inexact_re, inexact_im;
+   int loops = 0;
    int underflow_norm, overflow_norm, underflow_prod, overflow_prod;
    int underflow_re = 0, overflow_re = 0, underflow_im = 0, overflow_im = 0;
    mpfr_rnd_t rnd_re = MPC_RND_RE (rnd), rnd_im = MPC_RND_IM (rnd);
    int saved_underflow, saved_overflow;
    int tmpsgn;
 
-   /* According to the C standard G.3, there are three types of numbers:   */
-   /* finite (both parts are usual real numbers; contains 0), infinite     */
-   /* (at least one part is a real infinity) and all others; the latter    */
-   /* are numbers containing a nan, but no infinity, and could reasonably  */
-   /* be called nan.                                                       */
-   /* By G.5.1.4, infinite/finite=infinite; finite/infinite=0;             */
-   /* all other divisions that are not finite/finite return nan+i*nan.     */
-   /* Division by 0 could be handled by the following case of division by  */
-   /* a real; we handle it separately instead.                             */
-   if (mpc_zero_p (c))
-      return mpc_div_zero (a, b, c, rnd);
-   else if (mpc_inf_p (b) && mpc_fin_p (c))
-         return mpc_div_inf_fin (a, b, c);
-   else if (mpc_fin_p (b) && mpc_inf_p (c))
-         return mpc_div_fin_inf (a, b, c);
-   else if (!mpc_fin_p (b) || !mpc_fin_p (c)) {
-      mpc_set_nan (a);
-      return MPC_INEX (0, 0);
-   }
-   else if (mpfr_zero_p(mpc_imagref(c)))
-      return mpc_div_real (a, b, c, rnd);
-   else if (mpfr_zero_p(mpc_realref(c)))
-      return mpc_div_imag (a, b, c, rnd);
-      
    prec = MPC_MAX_PREC(a);
 
-   mpc_init2 (res, 2);
-   mpfr_init (q);
+   mpc_scratch_init2 (mpc_realref (res), 2);
+   mpc_scratch_init2 (mpc_imagref (res), 2);
+   mpc_scratch_init2 (q, 2);
 
    /* create the conjugate of c in c_conj without allocating new memory */
    mpc_realref (c_conj)[0] = mpc_realref (c)[0];
@@ -285,19 +457,32 @@ mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
    do {
       loops ++;
       prec += loops <= 2 ? mpc_ceil_log2 (prec) + 5 : prec / 2;
+      MPC_STATS_LOOP (DIV, prec);
 
       mpc_set_prec (res, prec);
       mpfr_set_prec (q, prec);
 
       /* first compute norm(c) */
-      mpfr_clear_underflow ();
-      mpfr_clear_overflow ();
-      inexact_norm = mpc_norm (q, c, MPFR_RNDU);
-      underflow_norm = mpfr_underflow_p ();
-      overflow_norm = mpfr_overflow_p ();
-      if (underflow_norm)
-         mpfr_set_ui (q, 0ul, MPFR_RNDN);
-         /* to obtain divisions by 0 later on */
+      if (pc != NULL) {
+         /* a norm of higher precision does not harm the error analysis */
+         if (pc->prec < prec)
+            div_precomp_set (pc, prec);
+         norm = pc->norm;
+         inexact_norm = pc->inex_norm;
+         underflow_norm = pc->underflow;
+         overflow_norm = pc->overflow;
+      }
+      else {
+         mpfr_clear_underflow ();
+         mpfr_clear_overflow ();
+         inexact_norm = mpc_norm (q, c, MPFR_RNDU);
+         underflow_norm = mpfr_underflow_p ();
+         overflow_norm = mpfr_overflow_p ();
+         if (underflow_norm)
+            mpfr_set_ui (q, 0ul, MPFR_RNDN);
+            /* to obtain divisions by 0 later on */
+         norm = q;
+      }
 
       /* now compute b*conjugate(c) */
       mpfr_clear_underflow ();
@@ -361,28 +546,36 @@ mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
          /* we use the division code of mpfr, which handles the situation.   */
          mpfr_clear_underflow ();
          mpfr_clear_overflow ();
-         inexact_re |= mpfr_div (mpc_realref (res), mpc_realref (res), q, MPFR_RNDZ);
+         inexact_re |= mpfr_div (mpc_realref (res), mpc_realref (res), norm, MPFR_RNDZ);
          underflow_re = mpfr_underflow_p ();
          overflow_re = mpfr_overflow_p ();
          ok_re = !inexact_re || underflow_re || overflow_re
-                 || mpfr_can_round (mpc_realref (res), prec - 4, MPFR_RNDN,
-                    MPFR_RNDZ, MPC_PREC_RE(a) + (rnd_re == MPFR_RNDN));
+                 || MPC_CAN_ROUND (mpc_realref (res), prec - 4,
+                    MPC_PREC_RE(a), rnd_re);
 
          if (ok_re) /* compute imaginary part */ {
             mpfr_clear_underflow ();
             mpfr_clear_overflow ();
-            inexact_im |= mpfr_div (mpc_imagref (res), mpc_imagref (res), q, MPFR_RNDZ);
+            inexact_im |= mpfr_div (mpc_imagref (res), mpc_imagref (res), norm, MPFR_RNDZ);
             underflow_im = mpfr_underflow_p ();
             overflow_im = mpfr_overflow_p ();
             ok_im = !inexact_im || underflow_im || overflow_im
-                    || mpfr_can_round (mpc_imagref (res), prec - 4, MPFR_RNDN,
-                       MPFR_RNDZ, MPC_PREC_IM(a) + (rnd_im == MPFR_RNDN));
+                    || MPC_CAN_ROUND (mpc_imagref (res), prec - 4,
+                       MPC_PREC_IM(a), rnd_im);
          }
       }
       else {
          /* The division is inexact, so for efficiency reasons we invert q */
          /* only once and multiply by the inverse. */
-         if (mpfr_ui_div (q, 1ul, q, MPFR_RNDZ) || inexact_norm) {
+         if (pc != NULL) {
+            inv = pc->inv;
+            inexact_inv = pc->inex_inv;
+         }
+         else {
+            inexact_inv = mpfr_ui_div (q, 1ul, q, MPFR_RNDZ);
+            inv = q;
+         }
+         if (inexact_inv || inexact_norm) {
              /* if 1/q is inexact, the approximations of the real and
                 imaginary part below will be inexact, unless RE(res)
                 or IM(res) is zero */
@@ -391,28 +584,28 @@ mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
          }
          mpfr_clear_underflow ();
          mpfr_clear_overflow ();
-         inexact_re |= mpfr_mul (mpc_realref (res), mpc_realref (res), q, MPFR_RNDZ);
+         inexact_re |= mpfr_mul (mpc_realref (res), mpc_realref (res), inv, MPFR_RNDZ);
          underflow_re = mpfr_underflow_p ();
          overflow_re = mpfr_overflow_p ();
          ok_re = !inexact_re || underflow_re || overflow_re
-                 || mpfr_can_round (mpc_realref (res), prec - 4, MPFR_RNDN,
-                    MPFR_RNDZ, MPC_PREC_RE(a) + (rnd_re == MPFR_RNDN));
+                 || MPC_CAN_ROUND (mpc_realref (res), prec - 4,
+                    MPC_PREC_RE(a), rnd_re);
 
          if (ok_re) /* compute imaginary part */ {
             mpfr_clear_underflow ();
             mpfr_clear_overflow ();
-            inexact_im |= mpfr_mul (mpc_imagref (res), mpc_imagref (res), q, MPFR_RNDZ);
+            inexact_im |= mpfr_mul (mpc_imagref (res), mpc_imagref (res), inv, MPFR_RNDZ);
             underflow_im = mpfr_underflow_p ();
             overflow_im = mpfr_overflow_p ();
             ok_im = !inexact_im || underflow_im || overflow_im
-                    || mpfr_can_round (mpc_imagref (res), prec - 4, MPFR_RNDN,
-                       MPFR_RNDZ, MPC_PREC_IM(a) + (rnd_im == MPFR_RNDN));
+                    || MPC_CAN_ROUND (mpc_imagref (res), prec - 4,
+                       MPC_PREC_IM(a), rnd_im);
          }
       }
    } while ((!ok_re || !ok_im) && !underflow_norm && !overflow_norm
                                && !underflow_prod && !overflow_prod);
 
-   inex = mpc_set (a, res, rnd);
+   inex = mpc_set (a, res, MPC_RND_FTON_C (rnd));
    inexact_re = MPC_INEX_RE (inex);
    inexact_im = MPC_INEX_IM (inex);
 
@@ -436,8 +629,9 @@ mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
       mpfr_set_zero (mpc_imagref (a), -inexact_im);
    }
 
-   mpc_clear (res);
-   mpfr_clear (q);
+   mpc_scratch_clear (mpc_realref (res));
+   mpc_scratch_clear (mpc_imagref (res));
+   mpc_scratch_clear (q);
 
    /* restore underflow and overflow flags from MPFR */
    if (saved_underflow)
@@ -447,3 +641,93 @@ mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
 
    return MPC_INEX (inexact_re, inexact_im);
 }
+
+
+int
+mpc_div (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+   int inex;
+
+   MPC_STATS_CALL (DIV);
+
+   /* According to the C standard G.3, there are three types of numbers:   */
+   /* finite (both parts are usual real numbers; contains 0), infinite     */
+   /* (at least one part is a real infinity) and all others; the latter    */
+   /* are numbers containing a nan, but no infinity, and could reasonably  */
+   /* be called nan.                                                       */
+   /* By G.5.1.4, infinite/finite=infinite; finite/infinite=0;             */
+   /* all other divisions that are not finite/finite return nan+i*nan.     */
+   /* Division by 0 could be handled by the following case of division by  */
+   /* a real; we handle it separately instead.                             */
+   if (mpc_zero_p (c))
+      return mpc_div_zero (a, b, c, rnd);
+   else if (mpc_inf_p (b) && mpc_fin_p (c))
+         return mpc_div_inf_fin (a, b, c);
+   else if (mpc_fin_p (b) && mpc_inf_p (c))
+         return mpc_div_fin_inf (a, b, c);
+   else if (!mpc_fin_p (b) || !mpc_fin_p (c)) {
+      mpc_set_nan (a);
+      return MPC_INEX (0, 0);
+   }
+   else if (mpfr_zero_p(mpc_imagref(c)))
+      return mpc_div_real (a, b, c, rnd);
+   else if (mpfr_zero_p(mpc_realref(c)))
+      return mpc_div_imag (a, b, c, rnd);
+   else if ((inex = mpc_div_dd (a, b, c, rnd)) != MPC_DD_FAIL)
+      return inex;
+   else if (single_p (a, b, c)
+            && (inex = div_single (a, b, c, rnd)) != MPC_DD_FAIL)
+      return inex;
+   else
+      return div_general (a, b, c, rnd, NULL);
+}
+
+
+void
+mpc_div_precomp_init (mpc_div_precomp_ptr pc, mpc_srcptr op, mpfr_prec_t prec)
+{
+   /* prepares pc for divisions by op with results of precision prec; the
+      norm of op and its inverse are computed at the precision of the first
+      loop of div_general, and only if mpc_div would use it */
+   mpc_init3 (pc->op, MPC_PREC_RE (op), MPC_PREC_IM (op));
+   mpc_set (pc->op, op, MPC_RNDNN); /* exact */
+   mpfr_init2 (pc->norm, 2);
+   mpfr_init2 (pc->inv, 2);
+   pc->regular =    mpfr_regular_p (mpc_realref (op))
+                 && mpfr_regular_p (mpc_imagref (op));
+   pc->prec = 0;
+   pc->inex_norm = 0;
+   pc->inex_inv = 0;
+   pc->underflow = 0;
+   pc->overflow = 0;
+
+   if (pc->regular)
+      div_precomp_set (pc, prec + mpc_ceil_log2 (prec) + 5);
+}
+
+
+void
+mpc_div_precomp_clear (mpc_div_precomp_ptr pc)
+{
+   mpc_clear (pc->op);
+   mpfr_clear (pc->norm);
+   mpfr_clear (pc->inv);
+}
+
+
+int
+mpc_div_precomp (mpc_ptr rop, mpc_srcptr op, mpc_div_precomp_ptr pc,
+                 mpc_rnd_t rnd)
+{
+   /* computes rop = op / pc->op with the same result as mpc_div */
+   int inex;
+
+   if (!pc->regular || !mpc_fin_p (op))
+      return mpc_div (rop, op, pc->op, rnd);
+
+   MPC_STATS_CALL (DIV);
+   if ((inex = mpc_div_dd (rop, op, pc->op, rnd)) != MPC_DD_FAIL)
+      return inex;
+   else
+      return div_general (rop, op, pc->op, rnd, pc);
+}
@@ -0,0 +1,91 @@
+/* mpc_dot -- Dot product of two arrays of complex numbers.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* The real parts a_r b_r and -a_i b_i and the imaginary parts a_r b_i and
+   a_i b_r of the products are computed exactly, as in mpc_fma_naive, and
+   added by mpfr_sum with a single rounding per part of the result. The
+   products of operands of at most MPC_SMALL_LIMBS limbs are stored in one
+   array of limbs, the other ones in temporary variables. */
+
+int
+mpc_dot (mpc_ptr rop, const mpc_ptr *a, const mpc_ptr *b, size_t n,
+         mpc_rnd_t rnd)
+{
+   void * (*allocfunc) (size_t);
+   void (*freefunc) (void *, size_t);
+   __mpfr_struct *p;
+   mpfr_ptr *t;
+   mp_limb_t *s;
+   char *clear;
+   size_t i;
+   int inex_re, inex_im;
+
+   if (n == 0)
+      return mpc_set_ui (rop, 0, MPC_RNDNN);
+
+   mp_get_memory_functions (&allocfunc, NULL, &freefunc);
+   p = (__mpfr_struct *) (*allocfunc) (4 * n * sizeof (__mpfr_struct));
+   t = (mpfr_ptr *) (*allocfunc) (2 * n * sizeof (mpfr_ptr));
+   s = (mp_limb_t *)
+      (*allocfunc) (4 * n * MPC_SMALL_SIZE * sizeof (mp_limb_t));
+   clear = (char *) (*allocfunc) (4 * n);
+
+   /* All products are computed before rop is changed, since it may be one
+      of the operands. */
+   for (i = 0; i < n; i++) {
+      clear [4*i] = (char) mpc_mul_exact (p + 4*i,
+         s + 4*i*MPC_SMALL_SIZE,
+         mpc_realref (a [i]), mpc_realref (b [i]), 0);
+      clear [4*i+1] = (char) mpc_mul_exact (p + 4*i+1,
+         s + (4*i+1)*MPC_SMALL_SIZE,
+         mpc_imagref (a [i]), mpc_imagref (b [i]), 1);
+      clear [4*i+2] = (char) mpc_mul_exact (p + 4*i+2,
+         s + (4*i+2)*MPC_SMALL_SIZE,
+         mpc_realref (a [i]), mpc_imagref (b [i]), 0);
+      clear [4*i+3] = (char) mpc_mul_exact (p + 4*i+3,
+         s + (4*i+3)*MPC_SMALL_SIZE,
+         mpc_imagref (a [i]), mpc_realref (b [i]), 0);
+   }
+
+   for (i = 0; i < n; i++) {
+      t [2*i] = p + 4*i;
+      t [2*i+1] = p + 4*i+1;
+   }
+   inex_re = mpfr_sum (mpc_realref (rop), t, (unsigned long) (2 * n),
+                       MPC_RND_RE (rnd));
+   for (i = 0; i < n; i++) {
+      t [2*i] = p + 4*i+2;
+      t [2*i+1] = p + 4*i+3;
+   }
+   inex_im = mpfr_sum (mpc_imagref (rop), t, (unsigned long) (2 * n),
+                       MPC_RND_IM (rnd));
+
+   for (i = 0; i < 4 * n; i++)
+      if (clear [i])
+         mpc_scratch_clear (p + i);
+   (*freefunc) (p, 4 * n * sizeof (__mpfr_struct));
+   (*freefunc) (t, 2 * n * sizeof (mpfr_ptr));
+   (*freefunc) (s, 4 * n * MPC_SMALL_SIZE * sizeof (mp_limb_t));
+   (*freefunc) (clear, 4 * n);
+
+   return MPC_INEX (inex_re, inex_im);
+}
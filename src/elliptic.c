@@ -0,0 +1,179 @@
+/* mpc_elliptic_k, mpc_elliptic_e -- Complete elliptic integrals.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* For the parameter m, K (m) = pi / (2 AGM (1, sqrt (1 - m))) and
+   E (m) = K (m) (1 - S) with the sum S of mpc_agm_loop, see agm.c and
+   algorithms.tex. The principal square root gives the branch cut
+   [1, +inf[ of both functions. */
+
+/* sets rop to E (m) if second is non-zero, to K (m) otherwise */
+static int
+elliptic (mpc_ptr rop, mpc_srcptr m, mpc_rnd_t rnd, int second)
+{
+   mpc_t y, z, c, s, x;
+   mpfr_t pi;
+   mpfr_exp_t emin, emax, lost, err, e, ey;
+   mpfr_prec_t prec, N, p, wp;
+   int n, zero, sign_im, inex;
+
+   MPC_STATS_CALL (ELLIPTIC);
+
+   if (mpfr_nan_p (mpc_realref (m)) || mpfr_nan_p (mpc_imagref (m))) {
+      mpc_set_nan (rop);
+      return MPC_INEX (0, 0);
+   }
+
+   /* K (m) tends to 0 and E (m) behaves like sqrt (-m) for |m| -> inf */
+   if (mpc_inf_p (m)) {
+      if (second) {
+         y [0] = m [0];
+         MPFR_CHANGE_SIGN (mpc_realref (y));
+         MPFR_CHANGE_SIGN (mpc_imagref (y));
+         return mpc_sqrt (rop, y, rnd);
+      }
+      mpc_set_ui (rop, 0, MPC_RNDNN);
+      return MPC_INEX (0, 0);
+   }
+
+   /* For m real less than 1, both functions are real, with an imaginary
+      part of the sign of the one of m by symmetry. K (1) = +inf and
+      E (1) = 1. */
+   sign_im = mpfr_signbit (mpc_imagref (m));
+   zero = 0;
+   if (mpfr_zero_p (mpc_imagref (m)) && mpfr_cmp_ui (mpc_realref (m), 1) < 0)
+      zero = 2;
+   else if (   mpfr_zero_p (mpc_imagref (m))
+            && mpfr_cmp_ui (mpc_realref (m), 1) == 0) {
+      if (second)
+         mpfr_set_ui (mpc_realref (rop), 1, MPFR_RNDN);
+      else
+         mpfr_set_inf (mpc_realref (rop), +1);
+      mpfr_set_ui (mpc_imagref (rop), 0, MPFR_RNDN);
+      mpfr_setsign (mpc_imagref (rop), mpc_imagref (rop), sign_im,
+                    MPFR_RNDN);
+      return MPC_INEX (0, 0);
+   }
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   prec = MPC_MAX_PREC (rop);
+   N = prec + mpc_ceil_log2 (prec) + 10;
+   mpc_init2 (y, 2);
+   mpc_init2 (z, 2);
+   mpc_init2 (c, 2);
+   mpc_init2 (s, 2);
+   mpc_init2 (x, 2);
+   mpfr_init2 (pi, 2);
+   for (;;) {
+      /* z = sqrt (1 - m) with a relative error of at most 2^(2-wp), where
+         the working precision wp is p+3 for the p of mpc_agm_steps */
+      wp = N + mpc_ceil_log2 (N) + 10;
+      for (;;) {
+         MPC_STATS_LOOP (ELLIPTIC, wp);
+         mpc_set_prec (y, wp);
+         mpc_set_prec (z, wp);
+         mpfr_ui_sub (mpc_realref (y), 1, mpc_realref (m), MPFR_RNDN);
+         mpfr_neg (mpc_imagref (y), mpc_imagref (m), MPFR_RNDN);
+         mpc_sqrt (z, y, MPC_RNDNN);
+         n = mpc_agm_steps (&p, z, N);
+         if (p + 3 <= wp)
+            break;
+         wp = p + 3;
+      }
+
+      if (second) {
+         mpc_set_prec (s, MPC_MAX_PREC (m));
+         mpc_set (s, m, MPC_RNDNN);
+      }
+      mpc_agm_loop (c, z, n, p, second ? s : NULL, &err);
+      mpfr_set_prec (pi, wp);
+      mpc_const_pi (pi, MPFR_RNDN);
+      mpc_set_prec (x, wp);
+      if (!second) {
+         /* The relative error of x is at most 2^(-N) + 3 * 2^(-wp) with
+            wp >= N + 9, including second order terms. */
+         mpc_fr_div (x, pi, c, MPC_RNDNN);
+         mpc_div_2ui (x, x, 1, MPC_RNDNN);
+         e = N - 1;
+      }
+      else {
+         /* With y = 1 - S, |y| >= 2^(EXP(y)-1), the relative error of y is
+            at most 2^(err-EXP(y)+1) + 2^(2-wp). Adding the relative errors
+            of the AGM, of pi and of the two roundings, and second order
+            terms, the relative error of x is at most 2^(f+3) for the
+            largest exponent f of these terms. */
+         mpfr_ui_sub (mpc_realref (y), 1, mpc_realref (s), MPFR_RNDN);
+         mpfr_neg (mpc_imagref (y), mpc_imagref (s), MPFR_RNDN);
+         if (mpc_zero_p (y))
+            e = 0;
+         else {
+            if (mpfr_zero_p (mpc_realref (y)))
+               ey = mpfr_get_exp (mpc_imagref (y));
+            else if (mpfr_zero_p (mpc_imagref (y)))
+               ey = mpfr_get_exp (mpc_realref (y));
+            else
+               ey = MPC_MAX (mpfr_get_exp (mpc_realref (y)),
+                             mpfr_get_exp (mpc_imagref (y)));
+            e = -(MPC_MAX (MPC_MAX (-N, err + 1 - ey), 2 - wp) + 3);
+         }
+         mpc_mul_fr (x, y, pi, MPC_RNDNN);
+         mpc_div (x, x, c, MPC_RNDNN);
+         mpc_div_2ui (x, x, 1, MPC_RNDNN);
+      }
+      /* |x - X| <= 2^(-e) |X| <= 2^(1-e) |x| for the exact value X */
+      lost = mpc_agm_check (x, e - 1, zero, rop, rnd);
+      if (lost == 0)
+         break;
+      N += lost + mpc_ceil_log2 (N) + 10;
+   }
+
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+   inex = mpc_agm_round (rop, x, zero, rnd);
+   if (zero & 2)
+      mpfr_setsign (mpc_imagref (rop), mpc_imagref (rop), sign_im,
+                    MPFR_RNDN);
+
+   mpc_clear (y);
+   mpc_clear (z);
+   mpc_clear (c);
+   mpc_clear (s);
+   mpc_clear (x);
+   mpfr_clear (pi);
+
+   return inex;
+}
+
+int
+mpc_elliptic_k (mpc_ptr rop, mpc_srcptr m, mpc_rnd_t rnd)
+{
+   return elliptic (rop, m, rnd, 0);
+}
+
+int
+mpc_elliptic_e (mpc_ptr rop, mpc_srcptr m, mpc_rnd_t rnd)
+{
+   return elliptic (rop, m, rnd, 1);
+}
@@ -29,6 +29,8 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   int inex_re, inex_im;
   int saved_underflow, saved_overflow;
 
+  MPC_STATS_CALL (EXP);
+
   /* special values */
   if (mpfr_nan_p (mpc_realref (op)) || mpfr_nan_p (mpc_imagref (op)))
     /* NaNs
@@ -132,16 +134,18 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 
   /* from now on, both parts of op are regular numbers */
 
-  prec = MPC_MAX_PREC(rop)
-         + MPC_MAX (MPC_MAX (-mpfr_get_exp (mpc_realref (op)), 0),
-                   -mpfr_get_exp (mpc_imagref (op)));
+  prec = MPC_MAX_PREC(rop);
+  if (!MPC_IS_LIKE_RNDF (MPC_RND_RE (rnd))
+      || !MPC_IS_LIKE_RNDF (MPC_RND_IM (rnd)))
+    prec += MPC_MAX (MPC_MAX (-mpfr_get_exp (mpc_realref (op)), 0),
+                     -mpfr_get_exp (mpc_imagref (op)));
     /* When op is close to 0, then exp is close to 1+Re(op), while
        cos is close to 1-Im(op); to decide on the ternary value of exp*cos,
        we need a high enough precision so that none of exp or cos is
-       computed as 1. */
-  mpfr_init2 (x, 2);
-  mpfr_init2 (y, 2);
-  mpfr_init2 (z, 2);
+       computed as 1. This is not needed for faithful rounding. */
+  mpc_scratch_init2 (x, 2);
+  mpc_scratch_init2 (y, 2);
+  mpc_scratch_init2 (z, 2);
 
   /* save the underflow or overflow flags from MPFR */
   saved_underflow = mpfr_underflow_p ();
@@ -150,6 +154,7 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   do
     {
       prec += mpc_ceil_log2 (prec) + 5;
+      MPC_STATS_LOOP (EXP, prec);
 
       mpfr_set_prec (x, prec);
       mpfr_set_prec (y, prec);
@@ -163,20 +168,18 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       mpfr_sin_cos (z, y, mpc_imagref(op), MPFR_RNDN); /* errors <= 0.5ulp */
       mpfr_mul (y, y, x, MPFR_RNDN); /* error <= 2ulp */
       ok = mpfr_overflow_p () || mpfr_zero_p (x)
-        || mpfr_can_round (y, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                       MPC_PREC_RE(rop) + (MPC_RND_RE(rnd) == MPFR_RNDN));
+        || MPC_CAN_ROUND (y, prec - 2, MPC_PREC_RE(rop), MPC_RND_RE(rnd));
       if (ok) /* compute imaginary part */
         {
           mpfr_mul (z, z, x, MPFR_RNDN);
           ok = mpfr_overflow_p () || mpfr_zero_p (x)
-            || mpfr_can_round (z, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                       MPC_PREC_IM(rop) + (MPC_RND_IM(rnd) == MPFR_RNDN));
+            || MPC_CAN_ROUND (z, prec - 2, MPC_PREC_IM(rop), MPC_RND_IM(rnd));
         }
     }
   while (ok == 0);
 
-  inex_re = mpfr_set (mpc_realref(rop), y, MPC_RND_RE(rnd));
-  inex_im = mpfr_set (mpc_imagref(rop), z, MPC_RND_IM(rnd));
+  inex_re = mpfr_set (mpc_realref(rop), y, MPC_RND_FTON (MPC_RND_RE(rnd)));
+  inex_im = mpfr_set (mpc_imagref(rop), z, MPC_RND_FTON (MPC_RND_IM(rnd)));
   if (mpfr_overflow_p ()) {
     /* overflow in real exponential, inex is sign of infinite result */
     inex_re = mpfr_sgn (y);
@@ -188,9 +191,9 @@ mpc_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
     inex_im = (mpfr_signbit (z) ? +1 : -1);
   }
 
-  mpfr_clear (x);
-  mpfr_clear (y);
-  mpfr_clear (z);
+  mpc_scratch_clear (x);
+  mpc_scratch_clear (y);
+  mpc_scratch_clear (z);
 
   /* restore underflow and overflow flags from MPFR */
   if (saved_underflow)
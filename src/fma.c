@@ -38,23 +38,51 @@ bound_prec_addsub (mpfr_srcptr x, mpfr_srcptr y)
     }
 }
 
-/* r <- a*b+c */
-int
-mpc_fma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+/* the exact real products of the parts of two complex numbers */
+typedef struct {
+  mpfr_t rea_reb, rea_imb, ima_reb, ima_imb;
+  mp_limb_t s1 [MPC_SMALL_SIZE], s2 [MPC_SMALL_SIZE],
+            s3 [MPC_SMALL_SIZE], s4 [MPC_SMALL_SIZE];
+  int clear1, clear2, clear3, clear4;
+} products_t;
+
+/* compute the products of the parts of a and b into p, which must remain
+   in scope until products_clear (p) has been called */
+static void
+products_init (products_t *p, mpc_srcptr a, mpc_srcptr b)
 {
-  mpfr_t rea_reb, rea_imb, ima_reb, ima_imb, tmp;
-  mpfr_prec_t pre12, pre13, pre23, pim12, pim13, pim23;
-  int inex_re, inex_im;
+  p->clear1 = mpc_mul_exact (p->rea_reb, p->s1,
+                             mpc_realref (a), mpc_realref (b), 0);
+  p->clear2 = mpc_mul_exact (p->rea_imb, p->s2,
+                             mpc_realref (a), mpc_imagref (b), 0);
+  p->clear3 = mpc_mul_exact (p->ima_reb, p->s3,
+                             mpc_imagref (a), mpc_realref (b), 0);
+  p->clear4 = mpc_mul_exact (p->ima_imb, p->s4,
+                             mpc_imagref (a), mpc_imagref (b), 0);
+}
 
-  mpfr_init2 (rea_reb, mpfr_get_prec (mpc_realref(a)) + mpfr_get_prec (mpc_realref(b)));
-  mpfr_init2 (rea_imb, mpfr_get_prec (mpc_realref(a)) + mpfr_get_prec (mpc_imagref(b)));
-  mpfr_init2 (ima_reb, mpfr_get_prec (mpc_imagref(a)) + mpfr_get_prec (mpc_realref(b)));
-  mpfr_init2 (ima_imb, mpfr_get_prec (mpc_imagref(a)) + mpfr_get_prec (mpc_imagref(b)));
+static void
+products_clear (products_t *p)
+{
+  if (p->clear1)
+    mpc_scratch_clear (p->rea_reb);
+  if (p->clear2)
+    mpc_scratch_clear (p->rea_imb);
+  if (p->clear3)
+    mpc_scratch_clear (p->ima_reb);
+  if (p->clear4)
+    mpc_scratch_clear (p->ima_imb);
+}
 
-  mpfr_mul (rea_reb, mpc_realref(a), mpc_realref(b), MPFR_RNDZ); /* exact */
-  mpfr_mul (rea_imb, mpc_realref(a), mpc_imagref(b), MPFR_RNDZ); /* exact */
-  mpfr_mul (ima_reb, mpc_imagref(a), mpc_realref(b), MPFR_RNDZ); /* exact */
-  mpfr_mul (ima_imb, mpc_imagref(a), mpc_imagref(b), MPFR_RNDZ); /* exact */
+/* r <- a*b+c, given the exact products of the parts of a and b in p */
+static int
+fma_exact (mpc_ptr r, products_t *p, mpc_srcptr c, mpc_rnd_t rnd)
+{
+  mpfr_srcptr rea_reb = p->rea_reb, rea_imb = p->rea_imb,
+              ima_reb = p->ima_reb, ima_imb = p->ima_imb;
+  mpfr_t tmp;
+  mpfr_prec_t pre12, pre13, pre23, pim12, pim13, pim23;
+  int inex_re, inex_im;
 
   /* Re(r) <- rea_reb - ima_imb + Re(c) */
 
@@ -66,7 +94,7 @@ mpc_fma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rn
   /* bound for ima_imb - Re(c) */
   if (pre12 <= pre13 && pre12 <= pre23) /* (rea_reb - ima_imb) + Re(c) */
     {
-      mpfr_init2 (tmp, pre12);
+      mpc_scratch_init2 (tmp, pre12);
       mpfr_sub (tmp, rea_reb, ima_imb, MPFR_RNDZ); /* exact */
       inex_re = mpfr_add (mpc_realref(r), tmp, mpc_realref(c), MPC_RND_RE(rnd));
       /* the only possible bad overlap is between r and c, but since we are
@@ -74,7 +102,7 @@ mpc_fma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rn
     }
   else if (pre13 <= pre23) /* (rea_reb + Re(c)) - ima_imb */
     {
-      mpfr_init2 (tmp, pre13);
+      mpc_scratch_init2 (tmp, pre13);
       mpfr_add (tmp, rea_reb, mpc_realref(c), MPFR_RNDZ); /* exact */
       inex_re = mpfr_sub (mpc_realref(r), tmp, ima_imb, MPC_RND_RE(rnd));
       /* the only possible bad overlap is between r and c, but since we are
@@ -82,7 +110,7 @@ mpc_fma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rn
     }
   else /* rea_reb + (Re(c) - ima_imb) */
     {
-      mpfr_init2 (tmp, pre23);
+      mpc_scratch_init2 (tmp, pre23);
       mpfr_sub (tmp, mpc_realref(c), ima_imb, MPFR_RNDZ); /* exact */
       inex_re = mpfr_add (mpc_realref(r), tmp, rea_reb, MPC_RND_RE(rnd));
       /* the only possible bad overlap is between r and c, but since we are
@@ -114,47 +142,134 @@ mpc_fma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rn
     }
   else /* rea_imb + (Im(c) + ima_reb) */
     {
-      mpfr_set_prec (tmp, pre23);
+      mpfr_set_prec (tmp, pim23);
       mpfr_add (tmp, mpc_imagref(c), ima_reb, MPFR_RNDZ); /* exact */
       inex_im = mpfr_add (mpc_imagref(r), tmp, rea_imb, MPC_RND_IM(rnd));
       /* the only possible bad overlap is between r and c, but since we are
 	 only touching the imaginary part of both, it is ok */
     }
 
-  mpfr_clear (rea_reb);
-  mpfr_clear (rea_imb);
-  mpfr_clear (ima_reb);
-  mpfr_clear (ima_imb);
-  mpfr_clear (tmp);
+  mpc_scratch_clear (tmp);
 
   return MPC_INEX(inex_re, inex_im);
 }
 
+/* return 1 if the exponent of x, when x is not zero, lies between lo and
+   hi */
+static int
+exp_in_p (mpfr_srcptr x, mpfr_exp_t lo, mpfr_exp_t hi)
+{
+  return mpfr_zero_p (x) || (mpfr_get_exp (x) >= lo && mpfr_get_exp (x) <= hi);
+}
+
+/* return 1 if the exact products of the parts of a and b, their sums with
+   the parts of c and all roundings of these sums lie in the current exponent
+   range; this holds when the exponents of the parts are at most emax/2-2,
+   and at least emin/2 plus the precision of the operands, since then all
+   values are multiples of 2^emin; also used by mpc_div with c = b */
+int
+mpc_in_range_p (mpc_srcptr a, mpc_srcptr b, mpc_srcptr c)
+{
+  mpfr_exp_t lo, hi;
+
+  lo = mpfr_get_emin () / 2
+       + MPC_MAX (MPC_MAX_PREC (a), MPC_MAX (MPC_MAX_PREC (b), MPC_MAX_PREC (c)));
+  hi = mpfr_get_emax () / 2 - 2;
+  return exp_in_p (mpc_realref (a), lo, hi) && exp_in_p (mpc_imagref (a), lo, hi)
+    && exp_in_p (mpc_realref (b), lo, hi) && exp_in_p (mpc_imagref (b), lo, hi)
+    && exp_in_p (mpc_realref (c), lo, hi) && exp_in_p (mpc_imagref (c), lo, hi);
+}
+
+/* r <- a*b+c */
+int
+mpc_fma_naive (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+  products_t p;
+  int inex;
+
+  products_init (&p, a, b);
+  inex = fma_exact (r, &p, c, rnd);
+  products_clear (&p);
+
+  return inex;
+}
+
 /* The algorithm is as follows:
    - in a first pass, we use the target precision + some extra bits
    - if it fails, we add the number of cancelled bits when adding
      Re(a*b) and Re(c) [similarly for the imaginary part]
-   - it is fails again, we call the mpc_fma_naive function, which also
-     deals with the special cases */
-int
-mpc_fma (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+   - it is fails again, the exact real products of the parts of a and b are
+     added to c with a single rounding, as in mpc_fma_naive
+   The exact products are computed at most once: below the thresholds of
+   the multiplications with three real products, mpc_mul would compute them
+   anyway, so they are obtained first and used in all passes; above, the
+   first pass calls mpc_mul, and they are obtained only if it fails.
+   If some intermediate value may leave the current exponent range,
+   everything is computed in the largest one, in which the products neither
+   overflow nor underflow, and the result is moved back into the current
+   exponent range in the end; the special values are handled by
+   mpc_fma_naive.
+   ab is an initialised temporary variable, its precision is changed here */
+static int
+fma_tmp (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd,
+         mpc_ptr ab)
 {
-  mpc_t ab;
-  mpfr_prec_t pre, pim, wpre, wpim;
-  mpfr_exp_t diffre, diffim;
+  products_t p;
+  int have_p, extend;
+  mpfr_prec_t pre, pim, wpre, wpim, karatsuba, gauss;
+  mpfr_exp_t diffre, diffim, emin, emax;
   int i, inex = 0, okre = 0, okim = 0;
 
+  MPC_STATS_CALL (FMA);
+
   if (mpc_fin_p (a) == 0 || mpc_fin_p (b) == 0 || mpc_fin_p (c) == 0)
     return mpc_fma_naive (r, a, b, c, rnd);
 
+  if ((inex = mpc_fma_dd (r, a, b, c, rnd)) != MPC_DD_FAIL)
+    return inex;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  extend = !mpc_in_range_p (a, b, c);
+  if (extend)
+    {
+      if (emax > mpfr_get_emax_max () / 2 || emin <= mpfr_get_emin_min () / 2)
+        /* the products may not be representable in any exponent range */
+        return mpc_fma_naive (r, a, b, c, rnd);
+      mpfr_set_emin (mpfr_get_emin_min ());
+      mpfr_set_emax (mpfr_get_emax_max ());
+    }
+
+  /* for small operands, the exact sums cost less than the loop */
+  if (MPC_SMALL_C_P (a) && MPC_SMALL_C_P (b) && MPC_SMALL_C_P (c)
+      && MPC_SMALL_C_P (r))
+    {
+      products_init (&p, a, b);
+      inex = fma_exact (r, &p, c, rnd);
+      products_clear (&p);
+      goto end;
+    }
+
   pre = mpfr_get_prec (mpc_realref(r));
   pim = mpfr_get_prec (mpc_imagref(r));
   wpre = pre + mpc_ceil_log2 (pre) + 10;
   wpim = pim + mpc_ceil_log2 (pim) + 10;
-  mpc_init3 (ab, wpre, wpim);
+  mpc_get_mul_threshold (&karatsuba, &gauss);
+  have_p = MPC_MAX (wpre, wpim) <= MPC_MIN (karatsuba, gauss);
+  if (have_p)
+    products_init (&p, a, b);
+  mpfr_set_prec (mpc_realref(ab), wpre);
+  mpfr_set_prec (mpc_imagref(ab), wpim);
   for (i = 0; i < 2; ++i)
     {
-      mpc_mul (ab, a, b, MPC_RNDZZ);
+      MPC_STATS_LOOP (FMA, MPC_MAX (wpre, wpim));
+      if (have_p)
+        {
+          mpfr_sub (mpc_realref(ab), p.rea_reb, p.ima_imb, MPFR_RNDZ);
+          mpfr_add (mpc_imagref(ab), p.rea_imb, p.ima_reb, MPFR_RNDZ);
+        }
+      else
+        mpc_mul (ab, a, b, MPC_RNDZZ);
       if (mpfr_zero_p (mpc_realref(ab)) || mpfr_zero_p (mpc_imagref(ab)))
         break;
       diffre = mpfr_get_exp (mpc_realref(ab));
@@ -185,7 +300,70 @@ mpc_fma (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
         wpim += diffim;
       mpfr_set_prec (mpc_realref(ab), wpre);
       mpfr_set_prec (mpc_imagref(ab), wpim);
+      if (!have_p)
+        {
+          products_init (&p, a, b);
+          have_p = 1;
+        }
+    }
+  if (!okre || !okim)
+    {
+      MPC_STATS_FALLBACK (FMA);
+      if (!have_p)
+        {
+          products_init (&p, a, b);
+          have_p = 1;
+        }
+      inex = fma_exact (r, &p, c, rnd);
+    }
+  if (have_p)
+    products_clear (&p);
+
+end:
+  if (extend)
+    {
+      mpfr_set_emin (emin);
+      mpfr_set_emax (emax);
+      inex = MPC_INEX (mpfr_check_range (mpc_realref (r), MPC_INEX_RE (inex),
+                                         MPC_RND_RE (rnd)),
+                       mpfr_check_range (mpc_imagref (r), MPC_INEX_IM (inex),
+                                         MPC_RND_IM (rnd)));
     }
-  mpc_clear (ab);
-  return okre && okim ? inex : mpc_fma_naive (r, a, b, c, rnd);
+  return inex;
+}
+
+int
+mpc_fma (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+  mpc_t ab;
+  int inex;
+
+  mpc_scratch_init2 (mpc_realref (ab), 2);
+  mpc_scratch_init2 (mpc_imagref (ab), 2);
+  inex = fma_tmp (r, a, b, c, rnd, ab);
+  mpc_scratch_clear (mpc_realref (ab));
+  mpc_scratch_clear (mpc_imagref (ab));
+
+  return inex;
+}
+
+/* r[i] <- a[i]*b[i]+c[i] for 0 <= i < n, with the same results as n calls
+   to mpc_fma, but a single temporary variable for the whole vector;
+   return 0 iff all results are exact */
+int
+mpc_fma_vec (mpc_ptr r, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, size_t n,
+             mpc_rnd_t rnd)
+{
+  mpc_t ab;
+  size_t i;
+  int inex = 0;
+
+  mpc_scratch_init2 (mpc_realref (ab), 2);
+  mpc_scratch_init2 (mpc_imagref (ab), 2);
+  for (i = 0; i < n; i++)
+    inex |= fma_tmp (r + i, a + i, b + i, c + i, rnd, ab);
+  mpc_scratch_clear (mpc_realref (ab));
+  mpc_scratch_clear (mpc_imagref (ab));
+
+  return inex;
 }
@@ -0,0 +1,152 @@
+/* mpc_fmma, mpc_fmms -- Fused sum and difference of two complex products.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* Each part of a*b+c*d is the sum of four real products, which are computed
+   exactly, on the stack when the operands are small, and added by mpfr_sum
+   with a single rounding. As in mpfr_fmma of mul.c, the exact products may
+   lie outside of the current exponent range while the result does not; so
+   they are computed in the largest exponent range, and the result is moved
+   back into the current one by mpfr_check_range. */
+
+/* returns 1 if p = +-x*y is the exact product, 0 after an overflow or an
+   underflow */
+static int
+exact_p (mpfr_srcptr p, mpfr_srcptr x, mpfr_srcptr y)
+{
+   return mpfr_number_p (p)
+      && (!mpfr_zero_p (p) || mpfr_zero_p (x) || mpfr_zero_p (y));
+}
+
+/* computes z = a*b+c*d with products rounded separately, for operands
+   that are not all finite or for the rare case that the exact products
+   overflow the largest exponent range */
+static int
+fmma_naive (mpc_ptr z, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c,
+            mpc_srcptr d, int sign, mpc_rnd_t rnd)
+{
+   mpc_t u, v;
+   int inex;
+
+   mpc_init3 (u, MPC_MAX_PREC (a) + MPC_MAX_PREC (b),
+              MPC_MAX_PREC (a) + MPC_MAX_PREC (b));
+   mpc_init3 (v, MPC_MAX_PREC (c) + MPC_MAX_PREC (d),
+              MPC_MAX_PREC (c) + MPC_MAX_PREC (d));
+   mpc_mul (u, a, b, MPC_RNDNN);
+   mpc_mul (v, c, d, MPC_RNDNN);
+   if (sign < 0)
+      inex = mpc_sub (z, u, v, rnd);
+   else
+      inex = mpc_add (z, u, v, rnd);
+   mpc_clear (u);
+   mpc_clear (v);
+
+   return inex;
+}
+
+/* computes z = a*b+c*d if sign >= 0, or z = a*b-c*d if sign < 0 */
+static int
+fmma (mpc_ptr z, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_srcptr d,
+      int sign, mpc_rnd_t rnd)
+{
+   __mpfr_struct p [8];
+   mpfr_ptr t [4];
+   mp_limb_t s [8 * MPC_SMALL_SIZE];
+   int clear [8];
+   mpfr_exp_t emin, emax;
+   int i, ok, inex_re, inex_im;
+
+   if (!mpc_fin_p (a) || !mpc_fin_p (b) || !mpc_fin_p (c) || !mpc_fin_p (d))
+      /* The products with an infinite or NaN operand have infinite or NaN
+         parts only, so that the second rounding is harmless. */
+      return fmma_naive (z, a, b, c, d, sign, rnd);
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* real part: p[0] - p[1] + p[2] - p[3],
+      imaginary part: p[4] + p[5] + p[6] + p[7], with the signs of the
+      products with c and d inverted for mpc_fmms; all products are computed
+      before z is changed, since it may be one of the operands */
+   clear [0] = mpc_mul_exact (p, s, mpc_realref (a), mpc_realref (b), 0);
+   clear [1] = mpc_mul_exact (p + 1, s + MPC_SMALL_SIZE,
+                              mpc_imagref (a), mpc_imagref (b), 1);
+   clear [2] = mpc_mul_exact (p + 2, s + 2 * MPC_SMALL_SIZE,
+                              mpc_realref (c), mpc_realref (d), sign < 0);
+   clear [3] = mpc_mul_exact (p + 3, s + 3 * MPC_SMALL_SIZE,
+                              mpc_imagref (c), mpc_imagref (d), sign >= 0);
+   clear [4] = mpc_mul_exact (p + 4, s + 4 * MPC_SMALL_SIZE,
+                              mpc_realref (a), mpc_imagref (b), 0);
+   clear [5] = mpc_mul_exact (p + 5, s + 5 * MPC_SMALL_SIZE,
+                              mpc_imagref (a), mpc_realref (b), 0);
+   clear [6] = mpc_mul_exact (p + 6, s + 6 * MPC_SMALL_SIZE,
+                              mpc_realref (c), mpc_imagref (d), sign < 0);
+   clear [7] = mpc_mul_exact (p + 7, s + 7 * MPC_SMALL_SIZE,
+                              mpc_imagref (c), mpc_realref (d), sign < 0);
+
+   ok =    exact_p (p, mpc_realref (a), mpc_realref (b))
+        && exact_p (p + 1, mpc_imagref (a), mpc_imagref (b))
+        && exact_p (p + 2, mpc_realref (c), mpc_realref (d))
+        && exact_p (p + 3, mpc_imagref (c), mpc_imagref (d))
+        && exact_p (p + 4, mpc_realref (a), mpc_imagref (b))
+        && exact_p (p + 5, mpc_imagref (a), mpc_realref (b))
+        && exact_p (p + 6, mpc_realref (c), mpc_imagref (d))
+        && exact_p (p + 7, mpc_imagref (c), mpc_realref (d));
+
+   if (ok) {
+      for (i = 0; i < 4; i++)
+         t [i] = p + i;
+      inex_re = mpfr_sum (mpc_realref (z), t, 4, MPC_RND_RE (rnd));
+      for (i = 0; i < 4; i++)
+         t [i] = p + 4 + i;
+      inex_im = mpfr_sum (mpc_imagref (z), t, 4, MPC_RND_IM (rnd));
+   }
+
+   for (i = 0; i < 8; i++)
+      if (clear [i])
+         mpc_scratch_clear (p + i);
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+
+   if (!ok)
+      return fmma_naive (z, a, b, c, d, sign, rnd);
+
+   inex_re = mpfr_check_range (mpc_realref (z), inex_re, MPC_RND_RE (rnd));
+   inex_im = mpfr_check_range (mpc_imagref (z), inex_im, MPC_RND_IM (rnd));
+
+   return MPC_INEX (inex_re, inex_im);
+}
+
+int
+mpc_fmma (mpc_ptr z, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_srcptr d,
+          mpc_rnd_t rnd)
+{
+   return fmma (z, a, b, c, d, 1, rnd);
+}
+
+int
+mpc_fmms (mpc_ptr z, mpc_srcptr a, mpc_srcptr b, mpc_srcptr c, mpc_srcptr d,
+          mpc_rnd_t rnd)
+{
+   return fmma (z, a, b, c, d, -1, rnd);
+}
@@ -23,17 +23,6 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 int
 mpc_fr_div (mpc_ptr a, mpfr_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
 {
-   mpc_t bc;
-   int inexact;
-
-   mpc_realref (bc)[0] = b [0];
-   mpfr_init (mpc_imagref (bc));
-   /* we consider the operand b to have imaginary part +0 */
-   mpfr_set_ui (mpc_imagref (bc), 0, MPFR_RNDN);
-
-   inexact = mpc_div (a, bc, c, rnd);
-
-   mpfr_clear (mpc_imagref (bc));
-
-   return inexact;
+   /* the operand b is considered to have imaginary part +0 */
+   return mpc_real_div (a, b, c, rnd);
 }
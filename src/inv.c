@@ -0,0 +1,196 @@
+/* mpc_inv -- Inverse of a complex number.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* The inverse of c = x + i*y is x/n - i*y/n with the norm n = x^2 + y^2,
+   and the quotient of a real number b by c is b*x/n - i*b*y/n. Both are
+   obtained from one norm and one reciprocal 1/n or b/n, instead of the
+   complex product b*conj(c) of mpc_div. When the Ziv loop fails, which
+   happens in particular for exact results such as 1/(1+i) = (1-i)/2, the
+   norm is computed exactly and each part is rounded by a single real
+   division. Special values, real or purely imaginary c and exponents
+   close to the limits of the exponent range are left to mpc_div. */
+
+/* sets z to b + 0*i, or to 1 + 0*i if b is NULL, sharing the significand
+   of b; the other parts live in s, which must have room for 2 limbs, so
+   that z needs no clearing; also used by agm.c */
+void
+mpc_real_c (mpc_ptr z, mp_limb_t *s, mpfr_srcptr b)
+{
+   if (b == NULL) {
+      mpfr_custom_init_set (mpc_realref (z), MPFR_ZERO_KIND, 0,
+                            GMP_NUMB_BITS, s);
+      mpfr_set_ui (mpc_realref (z), 1, MPFR_RNDN);
+   }
+   else
+      mpc_realref (z) [0] = b [0];
+   mpfr_custom_init_set (mpc_imagref (z), MPFR_ZERO_KIND, 0, GMP_NUMB_BITS,
+                         s + 1);
+}
+
+/* returns 1 if the exponent of x lies in [-r, r] */
+static int
+exp_in_p (mpfr_srcptr x, mpfr_exp_t r)
+{
+   mpfr_exp_t e = mpfr_get_exp (x);
+
+   return -r <= e && e <= r;
+}
+
+/* sets a to b/c rounded once per part for b NULL, meaning 1, or a regular
+   number, and c with regular parts, such that the exponents of b and of the
+   parts of c are at most r in absolute value, where r is a quarter of the
+   exponent range; then no intermediate value over- or underflows */
+static int
+inv_general (mpc_ptr a, mpfr_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+   mpfr_t n, t, x, y;
+   mpfr_prec_t prec, exact;
+   mpfr_exp_t emax, umin;
+   int ok, inex_re, inex_im;
+
+   prec = MPC_MAX_PREC (a);
+   prec += mpc_ceil_log2 (prec) + 5;
+   mpc_scratch_init2 (n, prec);
+   mpc_scratch_init2 (t, prec);
+   mpc_scratch_init2 (x, prec);
+   mpc_scratch_init2 (y, prec);
+
+   exact = 0;
+   for (;;) {
+      MPC_STATS_LOOP (INV, prec);
+
+      /* Each of the 5 roundings to nearest leading to x or y causes a
+         relative error of at most u = 2^(-prec), so that their relative
+         error is at most (1+u)^5 - 1 < 8u, and their absolute error is
+         less than 2^(exp-prec+3). */
+      mpfr_sqr (n, mpc_realref (c), MPFR_RNDN);
+      mpfr_sqr (t, mpc_imagref (c), MPFR_RNDN);
+      mpfr_add (n, n, t, MPFR_RNDN);
+      if (b == NULL)
+         mpfr_ui_div (t, 1, n, MPFR_RNDN);
+      else
+         mpfr_div (t, b, n, MPFR_RNDN);
+      mpfr_mul (x, t, mpc_realref (c), MPFR_RNDN);
+      mpfr_mul (y, t, mpc_imagref (c), MPFR_RNDN);
+      mpfr_neg (y, y, MPFR_RNDN);
+
+      ok =    MPC_CAN_ROUND (x, prec - 3, MPC_PREC_RE (a), MPC_RND_RE (rnd))
+           && MPC_CAN_ROUND (y, prec - 3, MPC_PREC_IM (a), MPC_RND_IM (rnd));
+      if (ok)
+         break;
+
+      /* The exact norm needs at most 2*(emax-umin)+1 bits, where emax is
+         the larger exponent of the parts of c and umin the smaller exponent
+         of their last non-zero bits. */
+      if (exact == 0) {
+         emax = MPC_MAX (mpfr_get_exp (mpc_realref (c)),
+                         mpfr_get_exp (mpc_imagref (c)));
+         umin = MPC_MIN (MPC_EXP_ULP (mpc_realref (c)),
+                         MPC_EXP_ULP (mpc_imagref (c)));
+         exact = 2 * (emax - umin) + 1;
+      }
+      if (exact <= 2 * prec)
+         break;
+
+      prec += prec / 2;
+      mpfr_set_prec (n, prec);
+      mpfr_set_prec (t, prec);
+      mpfr_set_prec (x, prec);
+      mpfr_set_prec (y, prec);
+   }
+
+   if (ok) {
+      inex_re = mpfr_set (mpc_realref (a), x, MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (a), y, MPC_RND_IM (rnd));
+   }
+   else {
+      /* The result may be exact; each part is the quotient of an exact
+         numerator by the exact norm, rounded once. */
+      MPC_STATS_FALLBACK (INV);
+      mpfr_set_prec (n, exact);
+      mpfr_set_prec (t, exact);
+      mpfr_sqr (n, mpc_realref (c), MPFR_RNDN);
+      mpfr_sqr (t, mpc_imagref (c), MPFR_RNDN);
+      mpfr_add (n, n, t, MPFR_RNDN);
+      if (b == NULL) {
+         /* a may be c, whose imaginary part is still needed */
+         mpfr_set_prec (y, MPC_PREC_IM (c));
+         mpfr_neg (y, mpc_imagref (c), MPFR_RNDN);
+         inex_re = mpfr_div (mpc_realref (a), mpc_realref (c), n,
+                             MPC_RND_RE (rnd));
+      }
+      else {
+         /* both numerators are computed before a is changed, since b
+            may be one of its parts */
+         mpfr_set_prec (x, mpfr_get_prec (b) + MPC_PREC_RE (c));
+         mpfr_set_prec (y, mpfr_get_prec (b) + MPC_PREC_IM (c));
+         mpfr_mul (x, b, mpc_realref (c), MPFR_RNDN);
+         mpfr_mul (y, b, mpc_imagref (c), MPFR_RNDN);
+         mpfr_neg (y, y, MPFR_RNDN);
+         inex_re = mpfr_div (mpc_realref (a), x, n, MPC_RND_RE (rnd));
+      }
+      inex_im = mpfr_div (mpc_imagref (a), y, n, MPC_RND_IM (rnd));
+   }
+
+   mpc_scratch_clear (n);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (x);
+   mpc_scratch_clear (y);
+
+   return MPC_INEX (inex_re, inex_im);
+}
+
+/* sets a to b/c for a real number b, or to 1/c if b is NULL */
+int
+mpc_real_div (mpc_ptr a, mpfr_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
+{
+   mpc_t z;
+   mp_limb_t s [2];
+   mpfr_exp_t r;
+   int inex;
+
+   MPC_STATS_CALL (INV);
+
+   mpc_real_c (z, s, b);
+   r = MPC_MIN (-mpfr_get_emin (), mpfr_get_emax ()) / 4;
+   if (   (b != NULL && !mpfr_regular_p (b))
+       || !mpfr_regular_p (mpc_realref (c))
+       || !mpfr_regular_p (mpc_imagref (c))
+       || (b != NULL && !exp_in_p (b, r))
+       || !exp_in_p (mpc_realref (c), r) || !exp_in_p (mpc_imagref (c), r)) {
+      /* The special values, the divisions by a real or purely imaginary
+         number, which do not need the norm, and the exponents close to the
+         limits are handled by mpc_div. */
+      return mpc_div (a, z, c, rnd);
+   }
+
+   if ((inex = mpc_div_dd (a, z, c, rnd)) != MPC_DD_FAIL)
+      return inex;
+   else
+      return inv_general (a, b, c, rnd);
+}
+
+int
+mpc_inv (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   return mpc_real_div (rop, NULL, op, rnd);
+}
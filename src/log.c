@@ -21,6 +21,158 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdio.h> /* for MPC_ASSERT */
 #include "mpc-impl.h"
 
+/* precision in bits from which mpc_log uses the AGM, see
+   mpc_set_log_agm_threshold */
+static mpfr_prec_t log_agm_threshold =
+   (mpfr_prec_t) LOG_AGM_THRESHOLD * GMP_NUMB_BITS;
+
+void
+mpc_set_log_agm_threshold (mpfr_prec_t prec)
+{
+   log_agm_threshold = prec;
+}
+
+/* Computes log (op) for op with non-zero finite parts with one complex
+   AGM, in time O(M(p) log p) instead of the O(M(p) log^2 p) of
+   mpfr_atan2. Let t be op or -op such that Re (t) > 0, and s = t*2^m
+   with |s| >= 2^q. Then log (s) is approximated by pi / (2 AGM (1, 4/s))
+   with a relative error of at most 2^(4-2q), and log (op) = log (s)
+   - m log 2, plus i*pi or -i*pi if Re (op) < 0; see algorithms.tex.
+   Returns MPC_DD_FAIL if a part of the result cannot be rounded after a
+   few iterations, which happens when it is very small compared to the
+   other part, that is, for |op| very close to 1 or op very close to the
+   real axis. */
+int
+mpc_log_by_agm (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   mpfr_exp_t emin = mpfr_get_emin ();
+   mpfr_exp_t emax = mpfr_get_emax ();
+   mpfr_prec_t prec, N, p;
+   mpfr_exp_t m, q, e_re, e_im, e;
+   mpc_t t, a, b, c;
+   mpfr_t pi, l;
+   int neg, loops, n, ok_re, ok_im, inex;
+
+   mpfr_set_emin (mpfr_get_emin_min ());
+   mpfr_set_emax (mpfr_get_emax_max ());
+
+   /* t = |Re (op)| + i*Im (op) * sign (Re (op)) shares the significands
+      of op */
+   t [0] = op [0];
+   neg = mpfr_signbit (mpc_realref (op));
+   if (neg) {
+      MPFR_CHANGE_SIGN (mpc_realref (t));
+      MPFR_CHANGE_SIGN (mpc_imagref (t));
+   }
+
+   prec = MPC_MAX_PREC (rop);
+   N = prec + mpc_ceil_log2 (prec) + 10;
+   mpc_init2 (a, 2);
+   mpc_init2 (b, 2);
+   mpc_init2 (c, 2);
+   mpfr_init2 (pi, 2);
+   mpfr_init2 (l, 2);
+   ok_re = ok_im = 0;
+   for (loops = 0; loops < 3 && !(ok_re && ok_im); loops++) {
+      /* log s is approximated with relative error 2^(-N) if 2q >= N+4 */
+      q = N / 2 + 3;
+      m = q + 1 - MPC_MAX (mpfr_get_exp (mpc_realref (t)),
+                           mpfr_get_exp (mpc_imagref (t)));
+      /* n = B (N, 4/s) of algorithms.tex, with
+         |log_2 |4/s|| <= q - 2 + 1/2 */
+      n = MPC_MAX (1, mpc_ceil_log2 ((mpfr_prec_t) q - 1))
+          + mpc_ceil_log2 (N + 4) + 2;
+      p = N + n + 5;
+      MPC_STATS_LOOP (LOG, p);
+      mpc_set_prec (b, p);
+      mpc_set_prec (c, p);
+      mpfr_set_prec (pi, p);
+      mpfr_set_prec (l, p);
+
+      /* b = 4/s with a relative error of at most 2^(1-p) and a positive
+         real part, as required by mpc_agm_loop */
+      mpc_ui_div (b, 4, t, MPC_RNDNN);
+      mpc_mul_2si (b, b, -m, MPC_RNDNN);
+      mpc_agm_loop (a, b, n, p, NULL, NULL);
+      /* a = AGM (1, 4/s) (1 + theta_a) with |theta_a| <= 2^(-N) */
+      mpc_const_pi (pi, MPFR_RNDN);
+      mpfr_div_2ui (pi, pi, 1, MPFR_RNDN);
+      mpc_fr_div (c, pi, a, MPC_RNDNN);
+      /* c = log (s) (1 + theta_c) with |theta_c| <= 2^(2-N), collecting
+         the errors 2^(-N) of a and of the formula and 2^(-p) of pi and
+         of the division; so the absolute error of c is at most
+         2^(2-N) |log s| <= 2^(3-N) |c| <= 2^(4-N+e) with e the larger
+         exponent of its parts */
+      e = MPC_MAX (mpfr_get_exp (mpc_realref (c)),
+                   mpfr_get_exp (mpc_imagref (c))) + 4 - N;
+
+      /* real part: Re (c) - m log 2, where the error of m log 2 is at most
+         2^(EXP-p+2) and the one of the subtraction 2^(EXP-p-1) */
+      e_re = e;
+      if (m != 0) {
+         mpc_const_log2 (l, MPFR_RNDN);
+         mpfr_mul_si (l, l, m, MPFR_RNDN);
+         e_re = MPC_MAX (e_re, mpfr_get_exp (l) + 2 - p);
+         mpfr_sub (mpc_realref (c), mpc_realref (c), l, MPFR_RNDN);
+      }
+      /* imaginary part: Im (c) + pi or - pi, where the error of pi is at
+         most 2^(1-p) */
+      e_im = e;
+      if (neg) {
+         mpc_const_pi (pi, MPFR_RNDN);
+         if (mpfr_signbit (mpc_imagref (op)))
+            mpfr_sub (mpc_imagref (c), mpc_imagref (c), pi, MPFR_RNDN);
+         else
+            mpfr_add (mpc_imagref (c), mpc_imagref (c), pi, MPFR_RNDN);
+         e_im = MPC_MAX (e_im, 1 - p);
+      }
+      if (mpfr_zero_p (mpc_realref (c)) || mpfr_zero_p (mpc_imagref (c)))
+         break;
+      /* each error is the sum of at most three terms bounded by 2^e_re
+         resp. 2^e_im and by half an ulp of the result */
+      e_re = mpfr_get_exp (mpc_realref (c))
+             - (MPC_MAX (e_re, mpfr_get_exp (mpc_realref (c)) - p) + 2);
+      e_im = mpfr_get_exp (mpc_imagref (c))
+             - (MPC_MAX (e_im, mpfr_get_exp (mpc_imagref (c)) - p) + 2);
+      ok_re = MPC_CAN_ROUND (mpc_realref (c), e_re, MPC_PREC_RE (rop),
+                             MPC_RND_RE (rnd));
+      ok_im = MPC_CAN_ROUND (mpc_imagref (c), e_im, MPC_PREC_IM (rop),
+                             MPC_RND_IM (rnd));
+
+      /* The lost bits will most likely be lost again; give up if they
+         are more than the target precision. */
+      e = MPC_MAX (MPC_PREC_RE (rop) - e_re, MPC_PREC_IM (rop) - e_im);
+      if (e > (mpfr_exp_t) prec)
+         break;
+      N += MPC_MAX (e, 0) + mpc_ceil_log2 (N) + 10;
+   }
+
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+   if (ok_re && ok_im) {
+      /* the real part may underflow in a reduced exponent range */
+      ok_re = mpfr_set (mpc_realref (rop), mpc_realref (c),
+                        MPC_RND_FTON (MPC_RND_RE (rnd)));
+      ok_re = mpfr_check_range (mpc_realref (rop), ok_re, MPC_RND_RE (rnd));
+      ok_im = mpfr_set (mpc_imagref (rop), mpc_imagref (c),
+                        MPC_RND_FTON (MPC_RND_IM (rnd)));
+      ok_im = mpfr_check_range (mpc_imagref (rop), ok_im, MPC_RND_IM (rnd));
+      inex = MPC_INEX (ok_re, ok_im);
+   }
+   else {
+      MPC_STATS_FALLBACK (LOG);
+      inex = MPC_DD_FAIL;
+   }
+
+   mpc_clear (a);
+   mpc_clear (b);
+   mpc_clear (c);
+   mpfr_clear (pi);
+   mpfr_clear (l);
+
+   return inex;
+}
+
 int
 mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
    int ok, underflow = 0;
@@ -34,6 +186,8 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
    mpfr_exp_t expw;
    int sgnw;
 
+   MPC_STATS_CALL (LOG);
+
    /* special values: NaN and infinities */
    if (!mpc_fin_p (op)) {
       if (mpfr_nan_p (mpc_realref (op))) {
@@ -87,7 +241,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
          w [0] = *mpc_realref (op);
          MPFR_CHANGE_SIGN (w);
          inex_re = mpfr_log (mpc_realref (rop), w, MPC_RND_RE (rnd));
-         inex_im = mpfr_const_pi (mpc_imagref (rop), rnd_im);
+         inex_im = mpc_const_pi (mpc_imagref (rop), rnd_im);
          if (negative_zero) {
             mpc_conj (rop, rop, MPC_RNDNN);
             inex_im = -inex_im;
@@ -98,7 +252,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
    else if (re_cmp == 0) {
       if (im_cmp > 0) {
          inex_re = mpfr_log (mpc_realref (rop), mpc_imagref (op), MPC_RND_RE (rnd));
-         inex_im = mpfr_const_pi (mpc_imagref (rop), MPC_RND_IM (rnd));
+         inex_im = mpc_const_pi (mpc_imagref (rop), MPC_RND_IM (rnd));
          /* division by 2 does not change the ternary flag */
          mpfr_div_2ui (mpc_imagref (rop), mpc_imagref (rop), 1, MPFR_RNDN);
       }
@@ -106,7 +260,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
          w [0] = *mpc_imagref (op);
          MPFR_CHANGE_SIGN (w);
          inex_re = mpfr_log (mpc_realref (rop), w, MPC_RND_RE (rnd));
-         inex_im = mpfr_const_pi (mpc_imagref (rop), INV_RND (MPC_RND_IM (rnd)));
+         inex_im = mpc_const_pi (mpc_imagref (rop), INV_RND (MPC_RND_IM (rnd)));
          /* division by 2 does not change the ternary flag */
          mpfr_div_2ui (mpc_imagref (rop), mpc_imagref (rop), 1, MPFR_RNDN);
          mpfr_neg (mpc_imagref (rop), mpc_imagref (rop), MPFR_RNDN);
@@ -115,14 +269,19 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
       return MPC_INEX(inex_re, inex_im);
    }
 
+   if (MPC_MAX_PREC (rop) >= log_agm_threshold
+       && (inex_re = mpc_log_by_agm (rop, op, rnd)) != MPC_DD_FAIL)
+      return inex_re;
+
    prec = MPC_PREC_RE(rop);
-   mpfr_init2 (w, 2);
+   mpc_scratch_init2 (w, 2);
    /* let op = x + iy; log = 1/2 log (x^2 + y^2) + i atan2 (y, x)   */
    /* loop for the real part: 1/2 log (x^2 + y^2), fast, but unsafe */
    /* implementation                                                */
    ok = 0;
    for (loops = 1; !ok && loops <= 2; loops++) {
       prec += mpc_ceil_log2 (prec) + 4;
+      MPC_STATS_LOOP (LOG, prec);
       mpfr_set_prec (w, prec);
 
       mpc_abs (w, op, MPFR_RNDN);
@@ -141,13 +300,13 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
 
       err = MPC_MAX (-mpfr_get_exp (w), 0) + 1;
          /* number of lost digits */
-      ok = mpfr_can_round (w, prec - err, MPFR_RNDN, MPFR_RNDZ,
-         mpfr_get_prec (mpc_realref (rop)) + (MPC_RND_RE (rnd) == MPFR_RNDN));
+      ok = MPC_CAN_ROUND (w, prec - err, MPC_PREC_RE (rop), MPC_RND_RE (rnd));
    }
 
    if (!ok) {
+      MPC_STATS_FALLBACK (LOG);
       prec = MPC_PREC_RE(rop);
-      mpfr_init2 (v, 2);
+      mpc_scratch_init2 (v, 2);
       /* compute 1/2 log (x^2 + y^2) = log |x| + 1/2 * log (1 + (y/x)^2)
             if |x| >= |y|; otherwise, exchange x and y                   */
       if (mpfr_cmpabs (mpc_realref (op), mpc_imagref (op)) >= 0) {
@@ -161,6 +320,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
 
       do {
          prec += mpc_ceil_log2 (prec) + 4;
+         MPC_STATS_LOOP (LOG, prec);
          mpfr_set_prec (v, prec);
          mpfr_set_prec (w, prec);
 
@@ -196,9 +356,9 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
             underflow = 1;
 
       } while (!underflow &&
-               !mpfr_can_round (w, prec - err, MPFR_RNDN, MPFR_RNDZ,
-               mpfr_get_prec (mpc_realref (rop)) + (MPC_RND_RE (rnd) == MPFR_RNDN)));
-      mpfr_clear (v);
+               !MPC_CAN_ROUND (w, prec - err, MPC_PREC_RE (rop),
+                               MPC_RND_RE (rnd)));
+      mpc_scratch_clear (v);
    }
 
    /* imaginary part */
@@ -211,7 +371,7 @@ mpc_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd){
       inex_re = mpfr_set_ui_2exp (mpc_realref (rop), 1,
                                   mpfr_get_emin_min () - 2, MPC_RND_RE (rnd));
    else
-      inex_re = mpfr_set (mpc_realref (rop), w, MPC_RND_RE (rnd));
-   mpfr_clear (w);
+      inex_re = mpfr_set (mpc_realref (rop), w, MPC_RND_FTON (MPC_RND_RE (rnd)));
+   mpc_scratch_clear (w);
    return MPC_INEX(inex_re, inex_im);
 }
@@ -21,14 +21,6 @@ along with this program. If not, see http://logw.gnu.org/licenses/ .
 #include <limits.h> /* for CHAR_BIT */
 #include "mpc-impl.h"
 
-static void
-mpfr_const_log10 (mpfr_ptr log10)
-{
-   mpfr_set_ui (log10, 10, MPFR_RNDN); /* exact since prec >= 4 */
-   mpfr_log (log10, log10, MPFR_RNDN); /* error <= 1/2 ulp */
-}
-
-
 int
 mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
@@ -38,6 +30,8 @@ mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
    mpfr_t log10;
    mpc_t log;
 
+   MPC_STATS_CALL (LOG10);
+
    mpfr_init2 (log10, 2);
    mpc_init2 (log, 2);
    prec = MPC_MAX_PREC (rop);
@@ -45,6 +39,7 @@ mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
    while (ok == 0) {
       loops ++;
       prec += (loops <= 2) ? mpc_ceil_log2 (prec) + 4 : prec / 2;
+      MPC_STATS_LOOP (LOG10, prec);
       mpfr_set_prec (log10, prec);
       mpc_set_prec (log, prec);
 
@@ -58,12 +53,11 @@ mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       }
       else {
          special_im = 0;
-         mpfr_const_log10 (log10);
+         mpc_const_log10 (log10, MPFR_RNDN); /* error <= 1/2 ulp */
          mpfr_div (mpc_imagref (log), mpc_imagref (log), log10, MPFR_RNDN);
 
-         ok = mpfr_can_round (mpc_imagref (log), prec - 2,
-                  MPFR_RNDN, MPFR_RNDZ,
-                  MPC_PREC_IM(rop) + (MPC_RND_IM (rnd) == MPFR_RNDN));
+         ok = MPC_CAN_ROUND (mpc_imagref (log), prec - 2,
+                  MPC_PREC_IM(rop), MPC_RND_IM (rnd));
       }
 
       if (ok) {
@@ -74,13 +68,12 @@ mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
             special_re = 0;
             if (special_im)
                /* log10 not yet computed */
-               mpfr_const_log10 (log10);
+               mpc_const_log10 (log10, MPFR_RNDN); /* error <= 1/2 ulp */
             mpfr_div (mpc_realref (log), mpc_realref (log), log10, MPFR_RNDN);
                /* error <= 24/7 ulp < 4 ulp for prec >= 4, see algorithms.tex */
 
-            ok = mpfr_can_round (mpc_realref (log), prec - 2,
-                     MPFR_RNDN, MPFR_RNDZ,
-                     MPC_PREC_RE(rop) + (MPC_RND_RE (rnd) == MPFR_RNDN));
+            ok = MPC_CAN_ROUND (mpc_realref (log), prec - 2,
+                     MPC_PREC_RE(rop), MPC_RND_RE (rnd));
          }
 
          /* Special code to deal with cases where the real part of log10(x+i*y)
@@ -94,9 +87,11 @@ mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
             x = u/2^e and y = v/2^e with u, v, e integers: u^2+v^2 = 10^s*2^(2e)
             thus u^2+v^2 = 0 mod 2^(2e). By recurrence on e, necessarily
             u = v = 0 mod 2^e, thus x and y are necessarily integers.
+            Exact results need not be detected for faithful rounding.
          */
-         if (!ok && !check_exact && mpfr_integer_p (mpc_realref (op)) &&
-            mpfr_integer_p (mpc_imagref (op))) {
+         if (!ok && !check_exact && !MPC_IS_LIKE_RNDF (MPC_RND_RE (rnd))
+            && mpfr_integer_p (mpc_realref (op))
+            && mpfr_integer_p (mpc_imagref (op))) {
             mpz_t x, y;
             unsigned long s, v;
 
@@ -133,11 +128,13 @@ mpc_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       }
    }
 
-   inex_re = mpfr_set (mpc_realref(rop), mpc_realref (log), MPC_RND_RE (rnd));
+   inex_re = mpfr_set (mpc_realref(rop), mpc_realref (log),
+                       MPC_RND_FTON (MPC_RND_RE (rnd)));
    if (special_re)
       inex_re = MPC_INEX_RE (inex);
       /* recover flag from call to mpc_log above */
-   inex_im = mpfr_set (mpc_imagref(rop), mpc_imagref (log), MPC_RND_IM (rnd));
+   inex_im = mpfr_set (mpc_imagref(rop), mpc_imagref (log),
+                       MPC_RND_FTON (MPC_RND_IM (rnd)));
    if (special_im)
       inex_im = MPC_INEX_IM (inex);
    mpfr_clear (log10);
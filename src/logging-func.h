@@ -0,0 +1,1813 @@
+/* logging-func.h -- Wrappers logging calls to real mpc functions.
+
+Copyright (C) 2011, 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* generated by tools/logging from mpc.h, do not edit */
+
+__MPC_DECLSPEC int
+mpc_log_add (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_add");
+   if (!log_begin (&id, "mpc_add", "c_cc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_add_fr (mpc_ptr rop, mpc_srcptr op1, mpfr_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_add_fr");
+   if (!log_begin (&id, "mpc_add_fr", "c_cf"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_f (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_add_si (mpc_ptr rop, mpc_srcptr op1, long int op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_add_si");
+   if (!log_begin (&id, "mpc_add_si", "c_cs"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_s (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_add_ui (mpc_ptr rop, mpc_srcptr op1, unsigned long int op2,
+                mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_add_ui");
+   if (!log_begin (&id, "mpc_add_ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sub (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sub");
+   if (!log_begin (&id, "mpc_sub", "c_cc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sub_fr (mpc_ptr rop, mpc_srcptr op1, mpfr_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sub_fr");
+   if (!log_begin (&id, "mpc_sub_fr", "c_cf"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_f (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_fr_sub (mpc_ptr rop, mpfr_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpfr_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpfr_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_fr_sub");
+   if (!log_begin (&id, "mpc_fr_sub", "c_fc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_f (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sub_ui (mpc_ptr rop, mpc_srcptr op1, unsigned long int op2,
+                mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sub_ui");
+   if (!log_begin (&id, "mpc_sub_ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_ui_ui_sub (mpc_ptr rop, unsigned long int op1, unsigned long int op2,
+                   mpc_srcptr op3, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, unsigned long int, unsigned long int,
+                       mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, unsigned long int, unsigned long int,
+                       mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_ui_ui_sub");
+   if (!log_begin (&id, "mpc_ui_ui_sub", "c_uuc"))
+      return func (rop, op1, op2, op3, rnd);
+   log_prec_c (rop);
+   log_u (op1);
+   log_u (op2);
+   log_c (op3);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, op3, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul");
+   if (!log_begin (&id, "mpc_mul", "c_cc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul_fr (mpc_ptr rop, mpc_srcptr op1, mpfr_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul_fr");
+   if (!log_begin (&id, "mpc_mul_fr", "c_cf"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_f (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul_ui (mpc_ptr rop, mpc_srcptr op1, unsigned long int op2,
+                mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul_ui");
+   if (!log_begin (&id, "mpc_mul_ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul_si (mpc_ptr rop, mpc_srcptr op1, long int op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul_si");
+   if (!log_begin (&id, "mpc_mul_si", "c_cs"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_s (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul_i (mpc_ptr rop, mpc_srcptr op1, int op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul_i");
+   if (!log_begin (&id, "mpc_mul_i", "c_ci"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_i (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sqr");
+   if (!log_begin (&id, "mpc_sqr", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_div (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_div");
+   if (!log_begin (&id, "mpc_div", "c_cc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_inv (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_inv");
+   if (!log_begin (&id, "mpc_inv", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_pow (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_pow");
+   if (!log_begin (&id, "mpc_pow", "c_cc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_pow_fr (mpc_ptr rop, mpc_srcptr op1, mpfr_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_pow_fr");
+   if (!log_begin (&id, "mpc_pow_fr", "c_cf"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_f (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_pow_d (mpc_ptr rop, mpc_srcptr op1, double op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, double, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, double, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_pow_d");
+   if (!log_begin (&id, "mpc_pow_d", "c_cd"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_d (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_pow_si (mpc_ptr rop, mpc_srcptr op1, long op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, long, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, long, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_pow_si");
+   if (!log_begin (&id, "mpc_pow_si", "c_cs"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_s (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_pow_ui (mpc_ptr rop, mpc_srcptr op1, unsigned long op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_pow_ui");
+   if (!log_begin (&id, "mpc_pow_ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_pow_z (mpc_ptr rop, mpc_srcptr op1, mpz_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpz_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpz_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_pow_z");
+   if (!log_begin (&id, "mpc_pow_z", "c_cz"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_z (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_div_fr (mpc_ptr rop, mpc_srcptr op1, mpfr_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_div_fr");
+   if (!log_begin (&id, "mpc_div_fr", "c_cf"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_f (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_fr_div (mpc_ptr rop, mpfr_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpfr_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpfr_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_fr_div");
+   if (!log_begin (&id, "mpc_fr_div", "c_fc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_f (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_div_ui (mpc_ptr rop, mpc_srcptr op1, unsigned long int op2,
+                mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_div_ui");
+   if (!log_begin (&id, "mpc_div_ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_ui_div (mpc_ptr rop, unsigned long int op1, mpc_srcptr op2,
+                mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, unsigned long int, mpc_srcptr,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, unsigned long int, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_ui_div");
+   if (!log_begin (&id, "mpc_ui_div", "c_uc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_u (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_div_2ui (mpc_ptr rop, mpc_srcptr op1, unsigned long int op2,
+                 mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_div_2ui");
+   if (!log_begin (&id, "mpc_div_2ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul_2ui (mpc_ptr rop, mpc_srcptr op1, unsigned long int op2,
+                 mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul_2ui");
+   if (!log_begin (&id, "mpc_mul_2ui", "c_cu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_div_2si (mpc_ptr rop, mpc_srcptr op1, long int op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_div_2si");
+   if (!log_begin (&id, "mpc_div_2si", "c_cs"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_s (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_mul_2si (mpc_ptr rop, mpc_srcptr op1, long int op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_mul_2si");
+   if (!log_begin (&id, "mpc_mul_2si", "c_cs"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_s (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_conj (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_conj");
+   if (!log_begin (&id, "mpc_conj", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_neg (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_neg");
+   if (!log_begin (&id, "mpc_neg", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_norm (mpfr_ptr rop, mpc_srcptr op, mpfr_rnd_t rnd)
+{
+   static int (*func) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_norm");
+   if (!log_begin (&id, "mpc_norm", "f_c"))
+      return func (rop, op, rnd);
+   log_prec_f (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_f (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_abs (mpfr_ptr rop, mpc_srcptr op, mpfr_rnd_t rnd)
+{
+   static int (*func) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_abs");
+   if (!log_begin (&id, "mpc_abs", "f_c"))
+      return func (rop, op, rnd);
+   log_prec_f (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_f (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sqrt (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sqrt");
+   if (!log_begin (&id, "mpc_sqrt", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set");
+   if (!log_begin (&id, "mpc_set", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_d (mpc_ptr rop, double op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, double, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, double, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_d");
+   if (!log_begin (&id, "mpc_set_d", "c_d"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_d (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_d_d (mpc_ptr rop, double op1, double op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, double, double, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, double, double, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_d_d");
+   if (!log_begin (&id, "mpc_set_d_d", "c_dd"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_d (op1);
+   log_d (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_fr (mpc_ptr rop, mpfr_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_fr");
+   if (!log_begin (&id, "mpc_set_fr", "c_f"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_f (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_fr_fr (mpc_ptr rop, mpfr_srcptr op1, mpfr_srcptr op2,
+                   mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpfr_srcptr, mpfr_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpfr_srcptr, mpfr_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_fr_fr");
+   if (!log_begin (&id, "mpc_set_fr_fr", "c_ff"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_f (op1);
+   log_f (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_si (mpc_ptr rop, long int op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_si");
+   if (!log_begin (&id, "mpc_set_si", "c_s"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_s (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_si_si (mpc_ptr rop, long int op1, long int op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, long int, long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, long int, long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_si_si");
+   if (!log_begin (&id, "mpc_set_si_si", "c_ss"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_s (op1);
+   log_s (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_ui (mpc_ptr rop, unsigned long int op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, unsigned long int, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, unsigned long int, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_ui");
+   if (!log_begin (&id, "mpc_set_ui", "c_u"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_u (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_ui_ui (mpc_ptr rop, unsigned long int op1, unsigned long int op2,
+                   mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, unsigned long int, unsigned long int,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, unsigned long int, unsigned long int,
+                       mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_ui_ui");
+   if (!log_begin (&id, "mpc_set_ui_ui", "c_uu"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_u (op1);
+   log_u (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_z (mpc_ptr rop, mpz_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpz_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpz_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_z");
+   if (!log_begin (&id, "mpc_set_z", "c_z"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_z (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_set_z_z (mpc_ptr rop, mpz_srcptr op1, mpz_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpz_srcptr, mpz_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpz_srcptr, mpz_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_set_z_z");
+   if (!log_begin (&id, "mpc_set_z_z", "c_zz"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_z (op1);
+   log_z (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_fma (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_srcptr op3,
+             mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_fma");
+   if (!log_begin (&id, "mpc_fma", "c_ccc"))
+      return func (rop, op1, op2, op3, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_c (op3);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, op3, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_fmma (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_srcptr op3,
+              mpc_srcptr op4, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_srcptr,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_srcptr,
+                       mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_fmma");
+   if (!log_begin (&id, "mpc_fmma", "c_cccc"))
+      return func (rop, op1, op2, op3, op4, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_c (op3);
+   log_c (op4);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, op3, op4, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_fmms (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_srcptr op3,
+              mpc_srcptr op4, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_srcptr,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_srcptr,
+                       mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_fmms");
+   if (!log_begin (&id, "mpc_fmms", "c_cccc"))
+      return func (rop, op1, op2, op3, op4, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_c (op3);
+   log_c (op4);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, op3, op4, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_real (mpfr_ptr rop, mpc_srcptr op, mpfr_rnd_t rnd)
+{
+   static int (*func) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_real");
+   if (!log_begin (&id, "mpc_real", "f_c"))
+      return func (rop, op, rnd);
+   log_prec_f (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_f (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_imag (mpfr_ptr rop, mpc_srcptr op, mpfr_rnd_t rnd)
+{
+   static int (*func) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_imag");
+   if (!log_begin (&id, "mpc_imag", "f_c"))
+      return func (rop, op, rnd);
+   log_prec_f (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_f (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_arg (mpfr_ptr rop, mpc_srcptr op, mpfr_rnd_t rnd)
+{
+   static int (*func) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpfr_ptr, mpc_srcptr, mpfr_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_arg");
+   if (!log_begin (&id, "mpc_arg", "f_c"))
+      return func (rop, op, rnd);
+   log_prec_f (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_f (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_proj (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_proj");
+   if (!log_begin (&id, "mpc_proj", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_exp (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_exp");
+   if (!log_begin (&id, "mpc_exp", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_log (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_log");
+   if (!log_begin (&id, "mpc_log", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_log10 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_log10");
+   if (!log_begin (&id, "mpc_log10", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sin (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sin");
+   if (!log_begin (&id, "mpc_sin", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_cos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_cos");
+   if (!log_begin (&id, "mpc_cos", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sin_cos (mpc_ptr rop1, mpc_ptr rop2, mpc_srcptr op, mpc_rnd_t rnd1,
+                 mpc_rnd_t rnd2)
+{
+   static int (*func) (mpc_ptr, mpc_ptr, mpc_srcptr, mpc_rnd_t,
+                       mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_ptr, mpc_srcptr, mpc_rnd_t, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sin_cos");
+   if (!log_begin (&id, "mpc_sin_cos", "cc_c"))
+      return func (rop1, rop2, op, rnd1, rnd2);
+   log_prec_c (rop1);
+   log_prec_c (rop2);
+   log_c (op);
+   log_rnd (rnd1);
+   log_rnd (rnd2);
+   start = log_start ();
+   inex = func (rop1, rop2, op, rnd1, rnd2);
+   log_end (inex, start);
+   log_result_c (rop1);
+   log_result_c (rop2);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_tan");
+   if (!log_begin (&id, "mpc_tan", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_sinh (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_sinh");
+   if (!log_begin (&id, "mpc_sinh", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_cosh (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_cosh");
+   if (!log_begin (&id, "mpc_cosh", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_tanh (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_tanh");
+   if (!log_begin (&id, "mpc_tanh", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_asin (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_asin");
+   if (!log_begin (&id, "mpc_asin", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_acos (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_acos");
+   if (!log_begin (&id, "mpc_acos", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_atan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_atan");
+   if (!log_begin (&id, "mpc_atan", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_asinh (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_asinh");
+   if (!log_begin (&id, "mpc_asinh", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_acosh (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_acosh");
+   if (!log_begin (&id, "mpc_acosh", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_atanh (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_atanh");
+   if (!log_begin (&id, "mpc_atanh", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_agm (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_agm");
+   if (!log_begin (&id, "mpc_agm", "c_cc"))
+      return func (rop, op1, op2, rnd);
+   log_prec_c (rop);
+   log_c (op1);
+   log_c (op2);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op1, op2, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_agm1 (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_agm1");
+   if (!log_begin (&id, "mpc_agm1", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_elliptic_k (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_elliptic_k");
+   if (!log_begin (&id, "mpc_elliptic_k", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+__MPC_DECLSPEC int
+mpc_log_elliptic_e (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   static int (*func) (mpc_ptr, mpc_srcptr, mpc_rnd_t) = NULL;
+   static int id = LOG_UNKNOWN;
+   int inex;
+   int64_t start;
+
+   if (func == NULL)
+      func = (int (*) (mpc_ptr, mpc_srcptr, mpc_rnd_t))
+             (intptr_t) dlsym (NULL, "mpc_elliptic_e");
+   if (!log_begin (&id, "mpc_elliptic_e", "c_c"))
+      return func (rop, op, rnd);
+   log_prec_c (rop);
+   log_c (op);
+   log_rnd (rnd);
+   start = log_start ();
+   inex = func (rop, op, rnd);
+   log_end (inex, start);
+   log_result_c (rop);
+   return inex;
+}
+
+/* not logged: mpc_pow_ld mpc_set_ld mpc_set_ld_ld mpc_set_f mpc_set_f_f
+   mpc_set_q mpc_set_q_q mpc_swap mpc_add_vec mpc_mul_vec mpc_fma_vec
+   mpc_sum mpc_dot mpc_mul_precomp_init mpc_mul_precomp_clear
+   mpc_mul_precomp mpc_div_precomp_init mpc_div_precomp_clear
+   mpc_div_precomp mpc_set_mul_threshold mpc_get_mul_threshold mpc_set_nan
+   mpc_cmp mpc_cmp_si_si mpc_clear mpc_urandom mpc_init2 mpc_init3
+   mpc_get_prec mpc_get_prec2 mpc_set_prec mpc_get_version mpc_strtoc
+   mpc_set_str mpc_get_str mpc_free_str mpc_free_scratch mpc_free_cache
+   mpc_cache_save mpc_cache_load mpc_stats_get mpc_stats_reset mpc_set_sj
+   mpc_set_uj mpc_set_sj_sj mpc_set_uj_uj mpc_set_dc mpc_set_ldc mpc_get_dc
+   mpc_get_ldc mpc_inp_str mpc_out_str */
@@ -32,116 +32,334 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
    /* to indicate we are inside the library build; needed here since mpc-log.h
       includes mpc.h and not mpc-impl.h */
 #include "mpc-log.h"
+#include "mpc-trace.h"
 
 #ifdef HAVE_DLFCN_H
 #include <dlfcn.h>
 #endif
 
-typedef int (*c_c_func_ptr) (mpc_ptr, mpc_srcptr, mpc_rnd_t);
-typedef int (*c_cc_func_ptr) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
-typedef int (*c_ccc_func_ptr) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
-typedef int (*cc_c_func_ptr) (mpc_ptr, mpc_ptr, mpc_srcptr, mpc_rnd_t, mpc_rnd_t);
-
-#define MPC_LOGGING_OUT_PREC(z) \
-   do { \
-      fprintf (stderr, " %li %li", (long) mpfr_get_prec (mpc_realref (z)),  \
-                                (long) mpfr_get_prec (mpc_imagref (z))); \
-   } while (0);
-
-#define MPC_LOGGING_OUT_C(z) \
-   do { \
-      MPC_LOGGING_OUT_PREC (z); \
-      fprintf (stderr, " "); \
-      mpc_out_str (stderr, 16, 0, z, MPC_RNDNN); \
-   } while (0);
-
-#define MPC_LOGGING_FUNC_TYPE(funcname, type) \
-   do { \
-      fprintf (stderr, "mpc_"#funcname" "#type); \
-   } while (0);
-
-#define MPC_LOGGING_C_C(funcname) \
-__MPC_DECLSPEC int mpc_log_##funcname (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd) \
-{ \
-   static c_c_func_ptr func = NULL; \
-   if (func == NULL) \
-      func = (c_c_func_ptr) (intptr_t) dlsym (NULL, "mpc_"#funcname); \
-   MPC_LOGGING_FUNC_TYPE (funcname, c_c); \
-   MPC_LOGGING_OUT_PREC (rop); \
-   MPC_LOGGING_OUT_C (op); \
-   fprintf (stderr, "\n"); \
-   return func (rop, op, rnd); \
-}
-
-#define MPC_LOGGING_C_CC(funcname) \
-__MPC_DECLSPEC int mpc_log_##funcname (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd) \
-{ \
-   static c_cc_func_ptr func = NULL; \
-   if (func == NULL) \
-      func = (c_cc_func_ptr) (intptr_t) dlsym (NULL, "mpc_"#funcname); \
-   MPC_LOGGING_FUNC_TYPE (funcname, c_cc); \
-   MPC_LOGGING_OUT_PREC (rop); \
-   MPC_LOGGING_OUT_C (op1); \
-   MPC_LOGGING_OUT_C (op2); \
-   fprintf (stderr, "\n"); \
-   return func (rop, op1, op2, rnd); \
-}
-
-#define MPC_LOGGING_C_CCC(funcname) \
-__MPC_DECLSPEC int mpc_log_##funcname (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_srcptr op3, mpc_rnd_t rnd) \
-{ \
-   static c_ccc_func_ptr func = NULL; \
-   if (func == NULL) \
-      func = (c_ccc_func_ptr) (intptr_t) dlsym (NULL, "mpc_"#funcname); \
-   MPC_LOGGING_FUNC_TYPE (funcname, c_ccc); \
-   MPC_LOGGING_OUT_PREC (rop); \
-   MPC_LOGGING_OUT_C (op1); \
-   MPC_LOGGING_OUT_C (op2); \
-   MPC_LOGGING_OUT_C (op3); \
-   fprintf (stderr, "\n"); \
-   return func (rop, op1, op2, op3, rnd); \
-}
-
-#define MPC_LOGGING_CC_C(funcname) \
-__MPC_DECLSPEC int mpc_log_##funcname (mpc_ptr rop1, mpc_ptr rop2, mpc_srcptr op, mpc_rnd_t rnd1, mpc_rnd_t rnd2) \
-{ \
-   static cc_c_func_ptr func = NULL; \
-   if (func == NULL) \
-      func = (cc_c_func_ptr) (intptr_t) dlsym (NULL, "mpc_"#funcname); \
-   MPC_LOGGING_FUNC_TYPE (funcname, cc_c); \
-   MPC_LOGGING_OUT_PREC (rop1); \
-   MPC_LOGGING_OUT_PREC (rop2); \
-   MPC_LOGGING_OUT_C (op); \
-   fprintf (stderr, "\n"); \
-   return func (rop1, rop2, op, rnd1, rnd2); \
-}
-
-MPC_LOGGING_C_C (sqr)
-MPC_LOGGING_C_C (conj)
-MPC_LOGGING_C_C (neg)
-MPC_LOGGING_C_C (sqrt)
-MPC_LOGGING_C_C (proj)
-MPC_LOGGING_C_C (exp)
-MPC_LOGGING_C_C (log)
-MPC_LOGGING_C_C (sin)
-MPC_LOGGING_C_C (cos)
-MPC_LOGGING_C_C (tan)
-MPC_LOGGING_C_C (sinh)
-MPC_LOGGING_C_C (cosh)
-MPC_LOGGING_C_C (tanh)
-MPC_LOGGING_C_C (asin)
-MPC_LOGGING_C_C (acos)
-MPC_LOGGING_C_C (atan)
-MPC_LOGGING_C_C (asinh)
-MPC_LOGGING_C_C (acosh)
-MPC_LOGGING_C_C (atanh)
-
-MPC_LOGGING_C_CC (add)
-MPC_LOGGING_C_CC (sub)
-MPC_LOGGING_C_CC (mul)
-MPC_LOGGING_C_CC (div)
-MPC_LOGGING_C_CC (pow)
-
-MPC_LOGGING_C_CCC (fma)
-
-MPC_LOGGING_CC_C (sin_cos)
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#include <time.h>
+
+/* The wrappers in logging-func.h are generated by tools/logging for all
+   functions of mpc.h whose arguments can be logged. Each wrapper logs
+   the function name and type, the precisions of the results and the
+   precisions and values of the arguments, calls the real function and
+   logs its return value, time and results.
+
+   If the environment variable MPC_LOG_FUNCS is set to a comma separated
+   list of function names without the mpc_ prefix, for instance
+   "mul,mul_fr,exp", only these functions are logged.
+
+   If the environment variable MPC_LOG_TRACE is set to a file name, the
+   calls are not printed to stderr, but written in binary form to this
+   file, which is much faster and keeps the exact operands. The format is
+   described in bench/trace.h; "mpctrace" in bench/ prints such a trace
+   in the text format of the logging to stderr. The trace is buffered and
+   written completely when the program exits normally. Like the logging to
+   stderr, the trace is not meant for several threads calling GNU MPC at
+   the same time. */
+
+#define MPC_TRACE_BUFSIZE (1 << 20)
+
+/* values of the identifier of a wrapper besides the trace identifiers */
+#define LOG_UNKNOWN  -2 /* not yet called */
+#define LOG_DISABLED -1 /* not in MPC_LOG_FUNCS */
+
+static int trace_mode = -1;
+   /* -1: not yet known, 0: text on stderr, 1: binary trace */
+static FILE *trace_file;
+static int trace_funcs = 0; /* number of functions with an identifier */
+
+static void
+trace_close (void)
+{
+   fclose (trace_file);
+}
+
+static void
+trace_write (const void *p, size_t size)
+{
+   fwrite (p, size, 1, trace_file);
+}
+
+static void
+trace_write_int (int64_t i)
+{
+   trace_write (&i, sizeof (int64_t));
+}
+
+static void
+trace_write_byte (int c)
+{
+   putc (c, trace_file);
+}
+
+/* returns 1 if calls are written to the binary trace, 0 if they are
+   printed to stderr */
+static int
+trace_p (void)
+{
+   if (trace_mode < 0) {
+      const char *name = getenv ("MPC_LOG_TRACE");
+
+      trace_mode = 0;
+      if (name != NULL && *name != '\0') {
+         trace_file = fopen (name, "wb");
+         if (trace_file == NULL)
+            fprintf (stderr, "MPC logging: cannot open %s, "
+                     "logging to stderr\n", name);
+         else {
+            /* header: magic, version, a number revealing the byte order,
+               the sizes of an int64_t and of a limb */
+            setvbuf (trace_file, NULL, _IOFBF, MPC_TRACE_BUFSIZE);
+            trace_write (MPC_TRACE_MAGIC, strlen (MPC_TRACE_MAGIC));
+            trace_write_int (MPC_TRACE_VERSION);
+            trace_write_int ((int64_t) 0x0102030405060708);
+            trace_write_int (sizeof (int64_t));
+            trace_write_int (sizeof (mp_limb_t));
+            atexit (trace_close);
+            trace_mode = 1;
+         }
+      }
+   }
+   return trace_mode;
+}
+
+/* writes the definition of a new function identifier and returns it */
+static int
+trace_func (const char *name, const char *type)
+{
+   trace_write_byte (MPC_TRACE_FUNC);
+   trace_write_int (trace_funcs);
+   trace_write_byte ((int) strlen (name));
+   trace_write (name, strlen (name));
+   trace_write_byte ((int) strlen (type));
+   trace_write (type, strlen (type));
+   return trace_funcs++;
+}
+
+static void
+trace_write_fr (mpfr_srcptr x)
+{
+   mpfr_ptr y = (mpfr_ptr) x; /* the custom interface lacks const */
+   int kind = mpfr_custom_get_kind (y);
+
+   trace_write_int (mpfr_get_prec (x));
+   trace_write_byte (kind);
+   if (kind == MPFR_REGULAR_KIND || kind == -MPFR_REGULAR_KIND) {
+      trace_write_int (mpfr_custom_get_exp (y));
+      trace_write (mpfr_custom_get_significand (y),
+                   mpfr_custom_get_size (mpfr_get_prec (x)));
+   }
+}
+
+static void
+trace_write_c (mpc_srcptr z)
+{
+   trace_write_fr (mpc_realref (z));
+   trace_write_fr (mpc_imagref (z));
+}
+
+/* returns 1 if the function name is selected by MPC_LOG_FUNCS */
+static int
+log_enabled_p (const char *name)
+{
+   const char *list = getenv ("MPC_LOG_FUNCS");
+   size_t n;
+
+   if (list == NULL || *list == '\0')
+      return 1;
+   name += strlen ("mpc_");
+   n = strlen (name);
+   while (*list != '\0') {
+      if (strncmp (list, name, n) == 0 && (list [n] == ',' || list [n] == '\0'))
+         return 1;
+      list = strchr (list, ',');
+      if (list == NULL)
+         break;
+      list++;
+   }
+   return 0;
+}
+
+/* starts the log of a call of the function name with the given type and
+   returns 1, or returns 0 if the function is not logged; *id is the
+   identifier of the function, initially LOG_UNKNOWN */
+static int
+log_begin (int *id, const char *name, const char *type)
+{
+   if (*id == LOG_UNKNOWN) {
+      if (!log_enabled_p (name))
+         *id = LOG_DISABLED;
+      else
+         *id = (trace_p () ? trace_func (name, type) : 0);
+   }
+   if (*id == LOG_DISABLED)
+      return 0;
+
+   if (trace_mode) {
+      trace_write_byte (MPC_TRACE_CALL);
+      trace_write_int (*id);
+   }
+   else
+      fprintf (stderr, "%s %s", name, type);
+   return 1;
+}
+
+/* precision of a result */
+static void
+log_prec_f (mpfr_srcptr x)
+{
+   if (trace_mode)
+      trace_write_int (mpfr_get_prec (x));
+   else
+      fprintf (stderr, " %li", (long) mpfr_get_prec (x));
+}
+
+static void
+log_prec_c (mpc_srcptr z)
+{
+   log_prec_f (mpc_realref (z));
+   log_prec_f (mpc_imagref (z));
+}
+
+/* arguments */
+static void
+log_f (mpfr_srcptr x)
+{
+   if (trace_mode)
+      trace_write_fr (x);
+   else {
+      fprintf (stderr, " %li ", (long) mpfr_get_prec (x));
+      mpfr_out_str (stderr, 16, 0, x, MPFR_RNDN);
+   }
+}
+
+static void
+log_c (mpc_srcptr z)
+{
+   if (trace_mode)
+      trace_write_c (z);
+   else {
+      log_prec_c (z);
+      fprintf (stderr, " ");
+      mpc_out_str (stderr, 16, 0, z, MPC_RNDNN);
+   }
+}
+
+static void
+log_u (unsigned long u)
+{
+   if (trace_mode)
+      trace_write_int ((int64_t) u);
+   else
+      fprintf (stderr, " %lu", u);
+}
+
+static void
+log_s (long s)
+{
+   if (trace_mode)
+      trace_write_int (s);
+   else
+      fprintf (stderr, " %li", s);
+}
+
+static void
+log_i (int i)
+{
+   log_s (i);
+}
+
+static void
+log_d (double d)
+{
+   if (trace_mode)
+      trace_write (&d, sizeof (double));
+   else
+      fprintf (stderr, " %a", d);
+}
+
+static void
+log_z (mpz_srcptr z)
+{
+   size_t i, n = mpz_size (z);
+   mp_limb_t l;
+
+   if (trace_mode) {
+      trace_write_int (mpz_sgn (z) < 0 ? - (int64_t) n : (int64_t) n);
+      for (i = 0; i < n; i++) {
+         l = mpz_getlimbn (z, i);
+         trace_write (&l, sizeof (mp_limb_t));
+      }
+   }
+   else {
+      fprintf (stderr, " ");
+      mpz_out_str (stderr, 16, z);
+   }
+}
+
+/* rounding mode of a result, only in the trace */
+static void
+log_rnd (int rnd)
+{
+   if (trace_mode)
+      trace_write_byte (rnd);
+}
+
+/* returns a time stamp in nanoseconds for the trace */
+static int64_t
+log_start (void)
+{
+   if (!trace_mode)
+      return 0;
+   else {
+#if defined (HAVE_CLOCK_GETTIME) && defined (CLOCK_MONOTONIC)
+      struct timespec t;
+
+      clock_gettime (CLOCK_MONOTONIC, &t);
+      return (int64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+#elif defined (HAVE_GETTIMEOFDAY)
+      struct timeval t;
+
+      gettimeofday (&t, NULL);
+      return (int64_t) t.tv_sec * 1000000000 + (int64_t) t.tv_usec * 1000;
+#else
+      return 0;
+#endif
+   }
+}
+
+/* logs the time since start and the return value inex */
+static void
+log_end (int inex, int64_t start)
+{
+   if (trace_mode) {
+      trace_write_int (log_start () - start);
+      trace_write_int (inex);
+   }
+   else
+      fprintf (stderr, "\n");
+}
+
+/* results, only in the trace */
+static void
+log_result_f (mpfr_srcptr x)
+{
+   if (trace_mode)
+      trace_write_fr (x);
+}
+
+static void
+log_result_c (mpc_srcptr z)
+{
+   if (trace_mode)
+      trace_write_c (z);
+}
+
+#include "logging-func.h"
@@ -73,10 +73,34 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #define MPC_PREC_RE(x) (mpfr_get_prec(mpc_realref(x)))
 #define MPC_PREC_IM(x) (mpfr_get_prec(mpc_imagref(x)))
 #define MPC_MAX_PREC(x) MPC_MAX(MPC_PREC_RE(x), MPC_PREC_IM(x))
+#define MPC_EXP_ULP(x) (mpfr_get_exp (x) - mpfr_min_prec (x))
+   /* exponent of the last non-zero bit of the regular number x */
 
 #define INV_RND(r) \
    (((r) == MPFR_RNDU) ? MPFR_RNDD : (((r) == MPFR_RNDD) ? MPFR_RNDU : (r)))
 
+/* Faithful rounding: a part of the result rounded with MPFR_RNDF is one of
+   the two representable numbers surrounding the exact value, and its
+   ternary value is unspecified. The Ziv loops test with MPC_CAN_ROUND
+   whether an approximation x with |x - z| <= 2^(EXP(x)-err) of the exact
+   value z can be rounded to prec bits in the direction rnd; for MPFR_RNDF,
+   this holds as soon as err >= prec + 2, since then x rounded to nearest
+   is at distance less than one ulp of z. So x has to be rounded with
+   MPC_RND_FTON (rnd). */
+#if MPFR_VERSION_MAJOR >= 4
+#define MPC_IS_LIKE_RNDF(r) ((r) == MPFR_RNDF)
+#else
+#define MPC_IS_LIKE_RNDF(r) 0
+#endif
+#define MPC_RND_FTON(r) (MPC_IS_LIKE_RNDF (r) ? MPFR_RNDN : (r))
+#define MPC_RND_FTON_C(rnd) \
+   MPC_RND (MPC_RND_FTON (MPC_RND_RE (rnd)), MPC_RND_FTON (MPC_RND_IM (rnd)))
+#define MPC_CAN_ROUND(x,err,prec,rnd)                                   \
+   (MPC_IS_LIKE_RNDF (rnd) ?                                            \
+    mpfr_regular_p (x) && (mpfr_exp_t) (err) >= (mpfr_exp_t) (prec) + 2 \
+    : mpfr_can_round (x, err, MPFR_RNDN, MPFR_RNDZ,                     \
+                      (prec) + ((rnd) == MPFR_RNDN)))
+
 #define mpc_inf_p(z) (mpfr_inf_p(mpc_realref(z))||mpfr_inf_p(mpc_imagref(z)))
    /* Convention in C99 (G.3): z is regarded as an infinity if at least one of
       its parts is infinite */
@@ -134,9 +158,85 @@ do {                                                            \
  * Constants
  */
 
+/* thresholds in limbs; mpc-tuned.h is created by "make tune" in tune/ */
+#ifdef HAVE_MPC_TUNED_H
+#include "mpc-tuned.h"
+#endif
+
 #ifndef MUL_KARATSUBA_THRESHOLD
 #define MUL_KARATSUBA_THRESHOLD 23
 #endif
+#ifndef MUL_GAUSS_THRESHOLD
+#define MUL_GAUSS_THRESHOLD 16
+#endif
+#ifndef LOG_AGM_THRESHOLD
+#define LOG_AGM_THRESHOLD 1000000
+   /* the AGM is slower than mpfr_atan2 up to at least 4 million bits on
+      x86_64 with GMP 6, so that mpc_log only uses it when tuned */
+#endif
+
+
+/*
+ * Scratch space, see scratch.c
+ */
+
+#define MPC_SCRATCH_SIZE 16
+   /* maximal number of free temporary variables kept per thread */
+
+typedef struct {
+  int size;
+     /* number of free variables in tmp */
+  __mpfr_struct tmp [MPC_SCRATCH_SIZE];
+}
+__mpc_scratch_struct;
+
+typedef __mpc_scratch_struct mpc_scratch_t[1];
+
+
+/*
+ * Fast paths in double precision, see dd.c
+ */
+
+#define MPC_DD_FAIL (-1)
+   /* returned instead of a ternary value when the fast path does not apply */
+
+
+/*
+ * Exact products of small numbers, see small.c
+ */
+
+#define MPC_SMALL_LIMBS 2
+   /* maximal number of limbs of the operands of mpc_mul_small */
+#define MPC_SMALL_SIZE (2 * MPC_SMALL_LIMBS)
+   /* number of limbs of a small product */
+#define MPC_SMALL_P(x) \
+   (mpfr_get_prec (x) <= (mpfr_prec_t) MPC_SMALL_LIMBS * GMP_NUMB_BITS)
+#define MPC_SMALL_C_P(z) \
+   (MPC_SMALL_P (mpc_realref (z)) && MPC_SMALL_P (mpc_imagref (z)))
+
+
+/*
+ * Statistics, see stats.c
+ */
+
+enum {
+   MPC_STATS_ACOS, MPC_STATS_AGM, MPC_STATS_ASIN, MPC_STATS_ATAN,
+   MPC_STATS_DIV, MPC_STATS_ELLIPTIC, MPC_STATS_EXP, MPC_STATS_FMA,
+   MPC_STATS_INV, MPC_STATS_LOG, MPC_STATS_LOG10, MPC_STATS_MUL,
+   MPC_STATS_NORM, MPC_STATS_POW, MPC_STATS_POW_USI, MPC_STATS_SIN_COS,
+   MPC_STATS_SQR, MPC_STATS_SQRT, MPC_STATS_TAN,
+   MPC_STATS_NUMBER
+};
+
+#ifdef MPC_WANT_STATS
+#define MPC_STATS_CALL(f) mpc_stats_call (MPC_STATS_##f)
+#define MPC_STATS_LOOP(f,prec) mpc_stats_loop (MPC_STATS_##f, prec)
+#define MPC_STATS_FALLBACK(f) mpc_stats_fallback (MPC_STATS_##f)
+#else
+#define MPC_STATS_CALL(f) ((void) 0)
+#define MPC_STATS_LOOP(f,prec) ((void) 0)
+#define MPC_STATS_FALLBACK(f) ((void) 0)
+#endif
 
 
 /*
@@ -150,13 +250,38 @@ extern "C" {
 
 __MPC_DECLSPEC int  mpc_mul_naive (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_mul_karatsuba (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_mul_gauss (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_fma_naive (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_in_range_p (mpc_srcptr, mpc_srcptr, mpc_srcptr);
+__MPC_DECLSPEC int  mpc_mul_dd (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_sqr_dd (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_div_dd (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_fma_dd (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_real_div (mpc_ptr, mpfr_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC void mpc_real_c (mpc_ptr, mp_limb_t *, mpfr_srcptr);
+__MPC_DECLSPEC int  mpc_sum_sqr (mpfr_ptr, mpc_srcptr, int, mpfr_rnd_t);
+__MPC_DECLSPEC int  mpc_log_by_agm (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC void mpc_set_log_agm_threshold (mpfr_prec_t);
+__MPC_DECLSPEC int  mpc_agm_steps (mpfr_prec_t *, mpc_srcptr, mpfr_prec_t);
+__MPC_DECLSPEC void mpc_agm_loop (mpc_ptr, mpc_srcptr, int, mpfr_prec_t, mpc_ptr, mpfr_exp_t *);
+__MPC_DECLSPEC mpfr_exp_t mpc_agm_check (mpc_srcptr, mpfr_exp_t, int, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_agm_round (mpc_ptr, mpc_srcptr, int, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_mul_small (mpfr_ptr, mp_limb_t *, mpfr_srcptr, mpfr_srcptr, int);
+__MPC_DECLSPEC int  mpc_mul_exact (mpfr_ptr, mp_limb_t *, mpfr_srcptr, mpfr_srcptr, int);
 __MPC_DECLSPEC int  mpc_pow_usi (mpc_ptr, mpc_srcptr, unsigned long, int, mpc_rnd_t);
 __MPC_DECLSPEC char* mpc_alloc_str (size_t);
 __MPC_DECLSPEC char* mpc_realloc_str (char*, size_t, size_t);
 __MPC_DECLSPEC void mpc_free_str (char*);
 __MPC_DECLSPEC mpfr_prec_t mpc_ceil_log2 (mpfr_prec_t);
 __MPC_DECLSPEC int set_pi_over_2 (mpfr_ptr, int, mpfr_rnd_t);
+__MPC_DECLSPEC int mpc_const_pi (mpfr_ptr, mpfr_rnd_t);
+__MPC_DECLSPEC int mpc_const_log2 (mpfr_ptr, mpfr_rnd_t);
+__MPC_DECLSPEC int mpc_const_log10 (mpfr_ptr, mpfr_rnd_t);
+__MPC_DECLSPEC void mpc_scratch_init2 (mpfr_ptr, mpfr_prec_t);
+__MPC_DECLSPEC void mpc_scratch_clear (mpfr_ptr);
+__MPC_DECLSPEC void mpc_stats_call (int);
+__MPC_DECLSPEC void mpc_stats_loop (int, mpfr_prec_t);
+__MPC_DECLSPEC void mpc_stats_fallback (int);
 
 #if defined (__cplusplus)
 }
@@ -1,6 +1,6 @@
 /* mpc-log.h -- Include file to enable function call logging; replaces mpc.h.
 
-Copyright (C) 2011 INRIA
+Copyright (C) 2011, 2012 INRIA
 
 This file is part of GNU MPC.
 
@@ -18,15 +18,68 @@ You should have received a copy of the GNU Lesser General Public License
 along with this program. If not, see http://www.gnu.org/licenses/ .
 */
 
+/* generated by tools/logging from mpc.h, do not edit */
+
+#define mpc_add mpc_log_add
+#define mpc_add_fr mpc_log_add_fr
+#define mpc_add_si mpc_log_add_si
+#define mpc_add_ui mpc_log_add_ui
+#define mpc_sub mpc_log_sub
+#define mpc_sub_fr mpc_log_sub_fr
+#define mpc_fr_sub mpc_log_fr_sub
+#define mpc_sub_ui mpc_log_sub_ui
+#define mpc_ui_ui_sub mpc_log_ui_ui_sub
+#define mpc_mul mpc_log_mul
+#define mpc_mul_fr mpc_log_mul_fr
+#define mpc_mul_ui mpc_log_mul_ui
+#define mpc_mul_si mpc_log_mul_si
+#define mpc_mul_i mpc_log_mul_i
 #define mpc_sqr mpc_log_sqr
+#define mpc_div mpc_log_div
+#define mpc_inv mpc_log_inv
+#define mpc_pow mpc_log_pow
+#define mpc_pow_fr mpc_log_pow_fr
+#define mpc_pow_d mpc_log_pow_d
+#define mpc_pow_si mpc_log_pow_si
+#define mpc_pow_ui mpc_log_pow_ui
+#define mpc_pow_z mpc_log_pow_z
+#define mpc_div_fr mpc_log_div_fr
+#define mpc_fr_div mpc_log_fr_div
+#define mpc_div_ui mpc_log_div_ui
+#define mpc_ui_div mpc_log_ui_div
+#define mpc_div_2ui mpc_log_div_2ui
+#define mpc_mul_2ui mpc_log_mul_2ui
+#define mpc_div_2si mpc_log_div_2si
+#define mpc_mul_2si mpc_log_mul_2si
 #define mpc_conj mpc_log_conj
 #define mpc_neg mpc_log_neg
+#define mpc_norm mpc_log_norm
+#define mpc_abs mpc_log_abs
 #define mpc_sqrt mpc_log_sqrt
+#define mpc_set mpc_log_set
+#define mpc_set_d mpc_log_set_d
+#define mpc_set_d_d mpc_log_set_d_d
+#define mpc_set_fr mpc_log_set_fr
+#define mpc_set_fr_fr mpc_log_set_fr_fr
+#define mpc_set_si mpc_log_set_si
+#define mpc_set_si_si mpc_log_set_si_si
+#define mpc_set_ui mpc_log_set_ui
+#define mpc_set_ui_ui mpc_log_set_ui_ui
+#define mpc_set_z mpc_log_set_z
+#define mpc_set_z_z mpc_log_set_z_z
+#define mpc_fma mpc_log_fma
+#define mpc_fmma mpc_log_fmma
+#define mpc_fmms mpc_log_fmms
+#define mpc_real mpc_log_real
+#define mpc_imag mpc_log_imag
+#define mpc_arg mpc_log_arg
 #define mpc_proj mpc_log_proj
 #define mpc_exp mpc_log_exp
 #define mpc_log mpc_log_log
+#define mpc_log10 mpc_log_log10
 #define mpc_sin mpc_log_sin
 #define mpc_cos mpc_log_cos
+#define mpc_sin_cos mpc_log_sin_cos
 #define mpc_tan mpc_log_tan
 #define mpc_sinh mpc_log_sinh
 #define mpc_cosh mpc_log_cosh
@@ -37,15 +90,9 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #define mpc_asinh mpc_log_asinh
 #define mpc_acosh mpc_log_acosh
 #define mpc_atanh mpc_log_atanh
-
-#define mpc_add mpc_log_add
-#define mpc_sub mpc_log_sub
-#define mpc_mul mpc_log_mul
-#define mpc_div mpc_log_div
-#define mpc_pow mpc_log_pow
-
-#define mpc_fma mpc_log_fma
-
-#define mpc_sin_cos mpc_log_sin_cos
+#define mpc_agm mpc_log_agm
+#define mpc_agm1 mpc_log_agm1
+#define mpc_elliptic_k mpc_log_elliptic_k
+#define mpc_elliptic_e mpc_log_elliptic_e
 
 #include "mpc.h"
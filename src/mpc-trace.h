@@ -0,0 +1,32 @@
+/* mpc-trace.h -- Constants of the binary call traces of the logging library
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#ifndef __MPC_TRACE_CONSTANTS_H
+#define __MPC_TRACE_CONSTANTS_H
+
+/* Shared by the writer of the traces in src/logging.c and their reader in
+   bench/trace.c; the format is described in bench/trace.h. */
+
+#define MPC_TRACE_MAGIC   "MPCTRACE"
+#define MPC_TRACE_VERSION 1
+#define MPC_TRACE_FUNC    'F'
+#define MPC_TRACE_CALL    'C'
+
+#endif /* __MPC_TRACE_CONSTANTS_H */
@@ -93,6 +93,21 @@ typedef int mpc_rnd_t;
 #define MPC_RNDDU MPC_RND (MPFR_RNDD,MPFR_RNDU)
 #define MPC_RNDDD MPC_RND (MPFR_RNDD,MPFR_RNDD)
 
+/* faithful rounding of one or both parts, which leaves the corresponding
+   part of the ternary value unspecified; needs MPFR_RNDF from mpfr 4 */
+#if MPFR_VERSION_MAJOR >= 4
+#define MPC_RNDNF MPC_RND (MPFR_RNDN,MPFR_RNDF)
+#define MPC_RNDZF MPC_RND (MPFR_RNDZ,MPFR_RNDF)
+#define MPC_RNDUF MPC_RND (MPFR_RNDU,MPFR_RNDF)
+#define MPC_RNDDF MPC_RND (MPFR_RNDD,MPFR_RNDF)
+
+#define MPC_RNDFN MPC_RND (MPFR_RNDF,MPFR_RNDN)
+#define MPC_RNDFZ MPC_RND (MPFR_RNDF,MPFR_RNDZ)
+#define MPC_RNDFU MPC_RND (MPFR_RNDF,MPFR_RNDU)
+#define MPC_RNDFD MPC_RND (MPFR_RNDF,MPFR_RNDD)
+#define MPC_RNDFF MPC_RND (MPFR_RNDF,MPFR_RNDF)
+#endif
+
 
 /* Definitions of types and their semantics */
 
@@ -106,6 +121,74 @@ typedef __mpc_struct mpc_t[1];
 typedef __mpc_struct *mpc_ptr;
 typedef const __mpc_struct *mpc_srcptr;
 
+/* Data for the repeated multiplication by a fixed complex number op, see
+   mpc_mul_precomp in mul.c */
+typedef struct {
+  mpc_t       op;          /* copy of the fixed factor */
+  int         regular;     /* both parts of op are regular numbers */
+  int         spread;      /* the exponents of the parts of op are too far
+                              apart for Karatsuba multiplication */
+  int         swap;        /* |Re (op)| < |Im (op)| */
+  int         gauss;       /* sum and diff are meant for mul_gauss */
+  mpfr_prec_t prec;        /* precision of sum and diff, 0 if not computed */
+  mpfr_t      sum;         /* c+d, where for mul_karatsuba c is the part of
+                              op of larger absolute value and d the other one,
+                              rounded away from zero, and for mul_gauss
+                              c=Re(op), d=Im(op), rounded to nearest */
+  mpfr_t      diff;        /* c-d, likewise */
+  int         inex_sum;
+  int         inex_diff;
+}
+__mpc_mul_precomp_struct;
+
+typedef __mpc_mul_precomp_struct mpc_mul_precomp_t[1];
+typedef __mpc_mul_precomp_struct *mpc_mul_precomp_ptr;
+typedef const __mpc_mul_precomp_struct *mpc_mul_precomp_srcptr;
+
+/* Data for the repeated division by a fixed complex number op, see
+   mpc_div_precomp in div.c */
+typedef struct {
+  mpc_t       op;          /* copy of the fixed divisor */
+  int         regular;     /* both parts of op are regular numbers */
+  mpfr_prec_t prec;        /* precision of norm and inv, 0 if not computed */
+  mpfr_t      norm;        /* norm of op, rounded up */
+  mpfr_t      inv;         /* 1/norm, rounded towards zero */
+  int         inex_norm;
+  int         inex_inv;
+  int         underflow;   /* the norm underflows, and norm is set to 0 */
+  int         overflow;    /* the norm overflows */
+}
+__mpc_div_precomp_struct;
+
+typedef __mpc_div_precomp_struct mpc_div_precomp_t[1];
+typedef __mpc_div_precomp_struct *mpc_div_precomp_ptr;
+
+/* Complex ball, standing for the complex numbers c (1 + theta) with
+   |theta| <= r, see mpcb.c; an infinite radius stands for all complex
+   numbers */
+typedef struct {
+  mpc_t  c;                /* centre */
+  mpfr_t r;                /* radius, a bound on the relative error of c */
+}
+__mpcb_struct;
+
+typedef __mpcb_struct mpcb_t[1];
+typedef __mpcb_struct *mpcb_ptr;
+typedef const __mpcb_struct *mpcb_srcptr;
+
+/* Counters of a function, filled in by mpc_stats_get when GNU MPC has been
+   configured with --enable-stats, see stats.c */
+typedef struct {
+  unsigned long calls;     /* number of calls */
+  unsigned long loops;     /* number of Ziv loop iterations */
+  unsigned long fallbacks; /* number of calls ending in a slower algorithm */
+  mpfr_prec_t   max_prec;  /* maximal working precision reached */
+}
+__mpc_stats_struct;
+
+typedef __mpc_stats_struct mpc_stats_t[1];
+typedef __mpc_stats_struct *mpc_stats_ptr;
+
 /* Support for WINDOWS DLL, see
    http://lists.gforge.inria.fr/pipermail/mpc-discuss/2011-November/000990.html;
    when building the DLL, export symbols, otherwise behave as GMP           */
@@ -135,6 +218,7 @@ __MPC_DECLSPEC int  mpc_mul_si    (mpc_ptr, mpc_srcptr, long int, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_mul_i     (mpc_ptr, mpc_srcptr, int, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_sqr       (mpc_ptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_div       (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_inv       (mpc_ptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_pow       (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_pow_fr    (mpc_ptr, mpc_srcptr, mpfr_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_pow_ld    (mpc_ptr, mpc_srcptr, long double, mpc_rnd_t);
@@ -174,6 +258,21 @@ __MPC_DECLSPEC int  mpc_set_z     (mpc_ptr, mpz_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_set_z_z   (mpc_ptr, mpz_srcptr, mpz_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC void mpc_swap      (mpc_ptr, mpc_ptr);
 __MPC_DECLSPEC int  mpc_fma       (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_fmma      (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_fmms      (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_add_vec   (mpc_ptr, mpc_srcptr, mpc_srcptr, size_t, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_mul_vec   (mpc_ptr, mpc_srcptr, mpc_srcptr, size_t, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_fma_vec   (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr, size_t, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_sum       (mpc_ptr, const mpc_ptr *, size_t, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_dot       (mpc_ptr, const mpc_ptr *, const mpc_ptr *, size_t, mpc_rnd_t);
+__MPC_DECLSPEC void mpc_mul_precomp_init  (mpc_mul_precomp_ptr, mpc_srcptr, mpfr_prec_t);
+__MPC_DECLSPEC void mpc_mul_precomp_clear (mpc_mul_precomp_ptr);
+__MPC_DECLSPEC int  mpc_mul_precomp (mpc_ptr, mpc_srcptr, mpc_mul_precomp_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC void mpc_div_precomp_init  (mpc_div_precomp_ptr, mpc_srcptr, mpfr_prec_t);
+__MPC_DECLSPEC void mpc_div_precomp_clear (mpc_div_precomp_ptr);
+__MPC_DECLSPEC int  mpc_div_precomp (mpc_ptr, mpc_srcptr, mpc_div_precomp_ptr, mpc_rnd_t);
+__MPC_DECLSPEC void mpc_set_mul_threshold (mpfr_prec_t, mpfr_prec_t);
+__MPC_DECLSPEC void mpc_get_mul_threshold (mpfr_prec_t *, mpfr_prec_t *);
 
 __MPC_DECLSPEC void mpc_set_nan   (mpc_ptr);
 
@@ -199,6 +298,10 @@ __MPC_DECLSPEC int  mpc_atan      (mpc_ptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_asinh     (mpc_ptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_acosh     (mpc_ptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC int  mpc_atanh     (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_agm       (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_agm1      (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_elliptic_k (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+__MPC_DECLSPEC int  mpc_elliptic_e (mpc_ptr, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC void mpc_clear     (mpc_ptr);
 __MPC_DECLSPEC int  mpc_urandom   (mpc_ptr, gmp_randstate_t);
 __MPC_DECLSPEC void mpc_init2     (mpc_ptr, mpfr_prec_t);
@@ -212,6 +315,32 @@ __MPC_DECLSPEC int  mpc_strtoc    (mpc_ptr, const char *, char **, int, mpc_rnd_
 __MPC_DECLSPEC int  mpc_set_str   (mpc_ptr, const char *, int, mpc_rnd_t);
 __MPC_DECLSPEC char * mpc_get_str (int, size_t, mpc_srcptr, mpc_rnd_t);
 __MPC_DECLSPEC void mpc_free_str  (char *);
+__MPC_DECLSPEC void mpc_free_scratch (void);
+__MPC_DECLSPEC void mpc_free_cache (void);
+__MPC_DECLSPEC int  mpc_cache_save (const char *, mpfr_prec_t);
+__MPC_DECLSPEC int  mpc_cache_load (const char *);
+__MPC_DECLSPEC int  mpc_stats_get (mpc_stats_ptr, const char *);
+__MPC_DECLSPEC void mpc_stats_reset (void);
+
+__MPC_DECLSPEC void mpcb_init2    (mpcb_ptr, mpfr_prec_t);
+__MPC_DECLSPEC void mpcb_clear    (mpcb_ptr);
+__MPC_DECLSPEC void mpcb_set_prec (mpcb_ptr, mpfr_prec_t);
+__MPC_DECLSPEC mpfr_prec_t mpcb_get_prec (mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_set      (mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_set_c    (mpcb_ptr, mpc_srcptr);
+__MPC_DECLSPEC void mpcb_get_rad  (mpfr_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_neg      (mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_add      (mpcb_ptr, mpcb_srcptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_mul      (mpcb_ptr, mpcb_srcptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_sqr      (mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_div      (mpcb_ptr, mpcb_srcptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_exp      (mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_log      (mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_sin_cos  (mpcb_ptr, mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_sqrt     (mpcb_ptr, mpcb_srcptr);
+__MPC_DECLSPEC void mpcb_pow      (mpcb_ptr, mpcb_srcptr, mpcb_srcptr);
+__MPC_DECLSPEC int  mpcb_can_round (mpcb_srcptr, mpfr_prec_t, mpfr_prec_t, mpc_rnd_t);
+__MPC_DECLSPEC int  mpcb_round    (mpc_ptr, mpcb_srcptr, mpc_rnd_t);
 
 /* declare certain functions only if appropriate headers have been included */
 #ifdef _MPC_H_HAVE_INTMAX_T
@@ -0,0 +1,761 @@
+/* mpcb -- Complex ball arithmetic
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* A ball with centre c and radius r stands for the complex numbers
+   c (1 + theta) with |theta| <= r, so r is a bound on the complex relative
+   error of c in the sense of Definition "def:comrelerror" of
+   algorithms.tex, and an infinite radius stands for all complex numbers.
+   A ball with a zero centre and a finite radius is the exact zero.
+
+   The functions compute the centre of the result from the centres of the
+   operands at the precision of the result, with a fixed number of real
+   operations rounded to nearest, and its radius from the error analysis
+   of algorithms.tex: the relative errors of the operands propagate to
+   the result, to which the error of the computation of the centre, of at
+   most k*2^-p for some small k, is added. They never increase the working
+   precision as the Ziv loops of the mpc functions do, so that a chain of
+   operations may be carried out at a fixed precision and be rounded once
+   at the end with mpcb_can_round and mpcb_round.
+
+   The radii are computed with MPCB_RAD_PREC bits, rounded upwards for
+   upper bounds and downwards for lower bounds. If the centre of a result
+   is not finite or if an overflow or an underflow occurs, the error
+   analysis does not apply, and the radius is set to infinity. The
+   functions leave the exception flags of MPFR unchanged, except for the
+   inexact flag. */
+
+#define MPCB_RAD_PREC 32
+
+#define MPCB_POW_GUARD 8
+   /* additional precision of the logarithm in mpcb_pow */
+
+#define FLAG_OVERFLOW  1
+#define FLAG_UNDERFLOW 2
+#define FLAG_NAN       4
+#define FLAG_ERANGE    8
+
+/* clears the exception flags that are changed by the ball functions and
+   returns their previous values */
+static int
+flags_save (void)
+{
+   int saved = 0;
+
+   if (mpfr_overflow_p ())
+      saved |= FLAG_OVERFLOW;
+   if (mpfr_underflow_p ())
+      saved |= FLAG_UNDERFLOW;
+   if (mpfr_nanflag_p ())
+      saved |= FLAG_NAN;
+   if (mpfr_erangeflag_p ())
+      saved |= FLAG_ERANGE;
+   mpfr_clear_overflow ();
+   mpfr_clear_underflow ();
+   mpfr_clear_nanflag ();
+   mpfr_clear_erangeflag ();
+
+   return saved;
+}
+
+/* restores the exception flags saved by flags_save */
+static void
+flags_restore (int saved)
+{
+   mpfr_clear_overflow ();
+   mpfr_clear_underflow ();
+   mpfr_clear_nanflag ();
+   mpfr_clear_erangeflag ();
+   if (saved & FLAG_OVERFLOW)
+      mpfr_set_overflow ();
+   if (saved & FLAG_UNDERFLOW)
+      mpfr_set_underflow ();
+   if (saved & FLAG_NAN)
+      mpfr_set_nanflag ();
+   if (saved & FLAG_ERANGE)
+      mpfr_set_erangeflag ();
+}
+
+/* sets the radius of z to infinity if its computation since the last call
+   to flags_save is not covered by the error analysis */
+static void
+ball_check (mpcb_ptr z)
+{
+   if (mpfr_overflow_p () || mpfr_underflow_p () || mpfr_nan_p (z->r)
+       || !mpc_fin_p (z->c))
+      mpfr_set_inf (z->r, +1);
+}
+
+/* ends the computation of z started with saved = flags_save () */
+static void
+ball_end (mpcb_ptr z, int saved)
+{
+   ball_check (z);
+   flags_restore (saved);
+}
+
+/* sets r to a bound on the relative error of a centre of precision p
+   computed with an error of at most k*2^-p relative to the exact value,
+   that is, to k*2^-p / (1 - k*2^-p), if inexact is non-zero, and to 0
+   otherwise */
+static void
+rad_round (mpfr_ptr r, unsigned long k, mpfr_prec_t p, int inexact)
+{
+   mpfr_t d;
+
+   if (!inexact) {
+      mpfr_set_ui (r, 0, MPFR_RNDU);
+      return;
+   }
+
+   mpc_scratch_init2 (d, MPCB_RAD_PREC);
+   mpfr_set_ui_2exp (r, k, - (mpfr_exp_t) p, MPFR_RNDU);
+   mpfr_ui_sub (d, 1, r, MPFR_RNDD);
+   if (mpfr_sgn (d) <= 0)
+      mpfr_set_inf (r, +1);
+   else
+      mpfr_div (r, r, d, MPFR_RNDU);
+   mpc_scratch_clear (d);
+}
+
+/* sets r to a + b + a*b, the relative error of a product of two values of
+   relative errors a and b, see (eq:propmulrel) in algorithms.tex */
+static void
+rad_mul (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b)
+{
+   mpfr_t t;
+
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpfr_mul (t, a, b, MPFR_RNDU);
+   mpfr_add (t, t, a, MPFR_RNDU);
+   mpfr_add (r, t, b, MPFR_RNDU);
+   mpc_scratch_clear (t);
+}
+
+/* sets r to an upper bound on |c| */
+static void
+rad_abs (mpfr_ptr r, mpc_srcptr c)
+{
+   mpfr_hypot (r, mpc_realref (c), mpc_imagref (c), MPFR_RNDU);
+}
+
+/* sets r to an upper bound on a / |c|, the relative error of c caused by
+   an absolute error of at most a; r may be the same variable as a */
+static void
+rad_rel (mpfr_ptr r, mpfr_srcptr a, mpc_srcptr c)
+{
+   mpfr_t t;
+
+   if (mpfr_zero_p (a)) {
+      mpfr_set_ui (r, 0, MPFR_RNDU);
+      return;
+   }
+
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpfr_hypot (t, mpc_realref (c), mpc_imagref (c), MPFR_RNDD);
+   if (mpfr_zero_p (t))
+      mpfr_set_inf (r, +1);
+   else
+      mpfr_div (r, a, t, MPFR_RNDU);
+   mpc_scratch_clear (t);
+}
+
+/* returns non-zero if the ball x, whose centre is not zero, may meet the
+   branch cut of sqrt and log on the negative real axis, or if its radius
+   is at least 1, since then the error analyses of sqrt and log do not
+   apply */
+static int
+branch_cut_p (mpcb_srcptr x)
+{
+   mpfr_t t;
+   int res;
+
+   if (mpfr_cmp_ui (x->r, 1) >= 0)
+      return 1;
+   else if (mpfr_sgn (mpc_realref (x->c)) >= 0 || mpfr_zero_p (x->r))
+      /* The ball lies in the right half plane, or it is a point. */
+      return 0;
+
+   /* The ball meets the cut if |Im c| <= r |c|. */
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   rad_abs (t, x->c);
+   mpfr_mul (t, t, x->r, MPFR_RNDU);
+   res = (mpfr_cmpabs (mpc_imagref (x->c), t) <= 0);
+   mpc_scratch_clear (t);
+
+   return res;
+}
+
+void
+mpcb_init2 (mpcb_ptr z, mpfr_prec_t prec)
+{
+   mpc_init2 (z->c, prec);
+   mpfr_init2 (z->r, MPCB_RAD_PREC);
+   mpfr_set_inf (z->r, +1);
+}
+
+void
+mpcb_clear (mpcb_ptr z)
+{
+   mpc_clear (z->c);
+   mpfr_clear (z->r);
+}
+
+void
+mpcb_set_prec (mpcb_ptr z, mpfr_prec_t prec)
+{
+   mpc_set_prec (z->c, prec);
+   mpfr_set_inf (z->r, +1);
+}
+
+mpfr_prec_t
+mpcb_get_prec (mpcb_srcptr z)
+{
+   return mpfr_get_prec (mpc_realref (z->c));
+}
+
+void
+mpcb_set (mpcb_ptr z, mpcb_srcptr x)
+{
+   mpfr_t t;
+   int saved, inex;
+
+   if (z == x)
+      return;
+
+   saved = flags_save ();
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   inex = mpc_set (z->c, x->c, MPC_RNDNN);
+   rad_round (t, 1, mpcb_get_prec (z), inex);
+   rad_mul (z->r, x->r, t);
+   mpc_scratch_clear (t);
+   ball_end (z, saved);
+}
+
+void
+mpcb_set_c (mpcb_ptr z, mpc_srcptr c)
+{
+   int saved, inex;
+
+   saved = flags_save ();
+   inex = mpc_set (z->c, c, MPC_RNDNN);
+   rad_round (z->r, 1, mpcb_get_prec (z), inex);
+   ball_end (z, saved);
+}
+
+void
+mpcb_get_rad (mpfr_ptr r, mpcb_srcptr z)
+{
+   mpfr_set (r, z->r, MPFR_RNDU);
+}
+
+void
+mpcb_neg (mpcb_ptr z, mpcb_srcptr x)
+{
+   mpcb_set (z, x);
+   mpc_neg (z->c, z->c, MPC_RNDNN);
+}
+
+void
+mpcb_add (mpcb_ptr z, mpcb_srcptr x, mpcb_srcptr y)
+{
+   /* By \S"sssec:propadd" of algorithms.tex, the absolute error of the
+      exact sum of the centres is at most a = r_x |c_x| + r_y |c_y|, and
+      the result rounded to nearest has a relative error of at most 2^-p
+      with respect to it. */
+   mpfr_t a, t;
+   int saved, inex;
+
+   saved = flags_save ();
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+
+   rad_abs (a, x->c);
+   mpfr_mul (a, a, x->r, MPFR_RNDU);
+   rad_abs (t, y->c);
+   mpfr_mul (t, t, y->r, MPFR_RNDU);
+   mpfr_add (a, a, t, MPFR_RNDU);
+
+   inex = mpc_add (z->c, x->c, y->c, MPC_RNDNN);
+   rad_rel (a, a, z->c);
+   rad_round (t, 1, mpcb_get_prec (z), inex);
+   mpfr_add (z->r, a, t, MPFR_RNDU);
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   ball_end (z, saved);
+}
+
+void
+mpcb_mul (mpcb_ptr z, mpcb_srcptr x, mpcb_srcptr y)
+{
+   /* The centre is computed with the four real products and the sum and
+      difference rounded to nearest. With u = 2^-p, the error of the real
+      part is at most (2u + u^2) (|x_r y_r| + |x_i y_i|), and likewise for
+      the imaginary part, so that the complex error is at most
+      sqrt (2) (2u + u^2) |c_x c_y| <= 4u |c_x c_y|. */
+   mpfr_t a, t, p1, p2, p3, p4;
+   mpfr_prec_t p;
+   int saved, inex;
+
+   saved = flags_save ();
+   p = mpcb_get_prec (z);
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (p1, p);
+   mpc_scratch_init2 (p2, p);
+   mpc_scratch_init2 (p3, p);
+   mpc_scratch_init2 (p4, p);
+
+   rad_mul (a, x->r, y->r);
+
+   inex = mpfr_mul (p1, mpc_realref (x->c), mpc_realref (y->c), MPFR_RNDN);
+   inex |= mpfr_mul (p2, mpc_imagref (x->c), mpc_imagref (y->c), MPFR_RNDN);
+   inex |= mpfr_mul (p3, mpc_realref (x->c), mpc_imagref (y->c), MPFR_RNDN);
+   inex |= mpfr_mul (p4, mpc_imagref (x->c), mpc_realref (y->c), MPFR_RNDN);
+   inex |= mpfr_sub (mpc_realref (z->c), p1, p2, MPFR_RNDN);
+   inex |= mpfr_add (mpc_imagref (z->c), p3, p4, MPFR_RNDN);
+
+   rad_round (t, 4, p, inex);
+   rad_mul (z->r, a, t);
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (p1);
+   mpc_scratch_clear (p2);
+   mpc_scratch_clear (p3);
+   mpc_scratch_clear (p4);
+   ball_end (z, saved);
+}
+
+void
+mpcb_sqr (mpcb_ptr z, mpcb_srcptr x)
+{
+   /* The error of the real part x_r^2 - x_i^2 is at most (2u + u^2) |c_x|^2,
+      the one of the imaginary part 2 x_r x_i at most u |c_x|^2, so that
+      the complex error is at most 4u |c_x|^2 as for mpcb_mul. */
+   mpfr_t a, t, p1, p2, p3;
+   mpfr_prec_t p;
+   int saved, inex;
+
+   saved = flags_save ();
+   p = mpcb_get_prec (z);
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (p1, p);
+   mpc_scratch_init2 (p2, p);
+   mpc_scratch_init2 (p3, p);
+
+   rad_mul (a, x->r, x->r);
+
+   inex = mpfr_sqr (p1, mpc_realref (x->c), MPFR_RNDN);
+   inex |= mpfr_sqr (p2, mpc_imagref (x->c), MPFR_RNDN);
+   inex |= mpfr_mul (p3, mpc_realref (x->c), mpc_imagref (x->c), MPFR_RNDN);
+   inex |= mpfr_sub (mpc_realref (z->c), p1, p2, MPFR_RNDN);
+   mpfr_mul_2ui (mpc_imagref (z->c), p3, 1, MPFR_RNDN);
+
+   rad_round (t, 4, p, inex);
+   rad_mul (z->r, a, t);
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (p1);
+   mpc_scratch_clear (p2);
+   mpc_scratch_clear (p3);
+   ball_end (z, saved);
+}
+
+void
+mpcb_div (mpcb_ptr z, mpcb_srcptr x, mpcb_srcptr y)
+{
+   /* By \S"sssec:propdiv" of algorithms.tex, the relative errors propagate
+      as (r_x + r_y) / (1 - r_y). The centre is computed as
+      c_x conj (c_y') / N (c_y') * 2^-e, where c_y' = c_y * 2^-e is scaled
+      so that its norm lies in [1/4, 2). With u = 2^-p, the numerator has
+      an error of at most 4u |c_x c_y'| as in mpcb_mul, the norm a relative
+      error of at most 2u + u^2 <= 3u, and the division a relative error of
+      at most u in each part; the quotient then has an error of at most
+      (1+4u) (1+u) / (1-3u) - 1 = (8u + 4u^2) / (1-3u) relative to the
+      exact quotient, and an error of at most 12u / (1 - 12u) relative to
+      itself. */
+   mpfr_t a, t, yr, yi, p1, p2, p3, p4, n;
+   mpfr_prec_t p;
+   mpfr_exp_t e;
+   int saved, inex;
+
+   if (mpc_zero_p (y->c) || !mpc_fin_p (y->c)) {
+      mpc_set_nan (z->c);
+      mpfr_set_inf (z->r, +1);
+      return;
+   }
+
+   saved = flags_save ();
+   p = mpcb_get_prec (z);
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (yr, mpfr_get_prec (mpc_realref (y->c)));
+   mpc_scratch_init2 (yi, mpfr_get_prec (mpc_imagref (y->c)));
+   mpc_scratch_init2 (p1, p);
+   mpc_scratch_init2 (p2, p);
+   mpc_scratch_init2 (p3, p);
+   mpc_scratch_init2 (p4, p);
+   mpc_scratch_init2 (n, p);
+
+   mpfr_ui_sub (t, 1, y->r, MPFR_RNDD);
+   if (mpfr_sgn (t) <= 0)
+      mpfr_set_inf (a, +1);
+   else {
+      mpfr_add (a, x->r, y->r, MPFR_RNDU);
+      mpfr_div (a, a, t, MPFR_RNDU);
+   }
+
+   if (mpfr_zero_p (mpc_realref (y->c)))
+      e = mpfr_get_exp (mpc_imagref (y->c));
+   else if (mpfr_zero_p (mpc_imagref (y->c)))
+      e = mpfr_get_exp (mpc_realref (y->c));
+   else
+      e = MPC_MAX (mpfr_get_exp (mpc_realref (y->c)),
+                   mpfr_get_exp (mpc_imagref (y->c)));
+   mpfr_mul_2si (yr, mpc_realref (y->c), -e, MPFR_RNDN);
+   mpfr_mul_2si (yi, mpc_imagref (y->c), -e, MPFR_RNDN);
+
+   inex = mpfr_sqr (p1, yr, MPFR_RNDN);
+   inex |= mpfr_sqr (p2, yi, MPFR_RNDN);
+   inex |= mpfr_add (n, p1, p2, MPFR_RNDN);
+
+   inex |= mpfr_mul (p1, mpc_realref (x->c), yr, MPFR_RNDN);
+   inex |= mpfr_mul (p2, mpc_imagref (x->c), yi, MPFR_RNDN);
+   inex |= mpfr_mul (p3, mpc_imagref (x->c), yr, MPFR_RNDN);
+   inex |= mpfr_mul (p4, mpc_realref (x->c), yi, MPFR_RNDN);
+   inex |= mpfr_add (p1, p1, p2, MPFR_RNDN);
+   inex |= mpfr_sub (p3, p3, p4, MPFR_RNDN);
+   inex |= mpfr_div (p1, p1, n, MPFR_RNDN);
+   inex |= mpfr_div (p3, p3, n, MPFR_RNDN);
+   mpfr_mul_2si (mpc_realref (z->c), p1, -e, MPFR_RNDN);
+   mpfr_mul_2si (mpc_imagref (z->c), p3, -e, MPFR_RNDN);
+
+   rad_round (t, 12, p, inex);
+   rad_mul (z->r, a, t);
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (yr);
+   mpc_scratch_clear (yi);
+   mpc_scratch_clear (p1);
+   mpc_scratch_clear (p2);
+   mpc_scratch_clear (p3);
+   mpc_scratch_clear (p4);
+   mpc_scratch_clear (n);
+   ball_end (z, saved);
+}
+
+void
+mpcb_exp (mpcb_ptr z, mpcb_srcptr x)
+{
+   /* exp (c (1 + theta)) = exp (c) exp (c theta) with
+      |exp (c theta) - 1| <= exp (r |c|) - 1. Each part of the centre
+      exp (x_r) cos (x_i) + i exp (x_r) sin (x_i) is obtained with three
+      roundings to nearest, so that its relative error is at most
+      (1+u)^3 - 1 <= 4u. */
+   mpfr_t a, t, ex, co, si;
+   mpfr_prec_t p;
+   int saved, inex;
+
+   saved = flags_save ();
+   p = mpcb_get_prec (z);
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (ex, p);
+   mpc_scratch_init2 (co, p);
+   mpc_scratch_init2 (si, p);
+
+   rad_abs (a, x->c);
+   mpfr_mul (a, a, x->r, MPFR_RNDU);
+   mpfr_expm1 (a, a, MPFR_RNDU);
+
+   inex = mpfr_exp (ex, mpc_realref (x->c), MPFR_RNDN);
+   inex |= mpfr_sin_cos (si, co, mpc_imagref (x->c), MPFR_RNDN);
+   inex |= mpfr_mul (mpc_realref (z->c), ex, co, MPFR_RNDN);
+   inex |= mpfr_mul (mpc_imagref (z->c), ex, si, MPFR_RNDN);
+
+   rad_round (t, 4, p, inex);
+   rad_mul (z->r, a, t);
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (ex);
+   mpc_scratch_clear (co);
+   mpc_scratch_clear (si);
+   ball_end (z, saved);
+}
+
+void
+mpcb_log (mpcb_ptr z, mpcb_srcptr x)
+{
+   /* Outside the branch cut, log (c (1 + theta)) = log (c) + log (1 + theta)
+      with |log (1 + theta)| <= -log (1 - r). The real part of the centre
+      is log (h) with h = |c| (1 + delta) and |delta| <= u, which differs
+      from log |c| by at most -log (1 - u) <= 2u, and both parts are
+      rounded to nearest. So the centre differs from the exact value by at
+      most a + u |c| in absolute value, where a = 2u if h is inexact and
+      0 otherwise. */
+   mpfr_t a, t, h;
+   mpfr_prec_t p;
+   int saved, inex, inex_h;
+
+   if (mpc_zero_p (x->c) || !mpc_fin_p (x->c) || branch_cut_p (x)) {
+      mpc_set_nan (z->c);
+      mpfr_set_inf (z->r, +1);
+      return;
+   }
+
+   saved = flags_save ();
+   p = mpcb_get_prec (z);
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (h, p);
+
+   mpfr_neg (a, x->r, MPFR_RNDD);
+   mpfr_log1p (a, a, MPFR_RNDD);
+   mpfr_neg (a, a, MPFR_RNDU);
+
+   inex_h = mpfr_hypot (h, mpc_realref (x->c), mpc_imagref (x->c),
+                        MPFR_RNDN);
+   inex = mpfr_atan2 (mpc_imagref (z->c), mpc_imagref (x->c),
+                      mpc_realref (x->c), MPFR_RNDN);
+   inex |= mpfr_log (mpc_realref (z->c), h, MPFR_RNDN);
+   inex |= inex_h;
+
+   if (inex_h) {
+      mpfr_set_ui_2exp (t, 1, 1 - (mpfr_exp_t) p, MPFR_RNDU);
+      mpfr_add (a, a, t, MPFR_RNDU);
+   }
+   rad_rel (a, a, z->c);
+   rad_round (t, 1, p, inex);
+   mpfr_add (z->r, a, t, MPFR_RNDU);
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (h);
+   ball_end (z, saved);
+}
+
+void
+mpcb_sin_cos (mpcb_ptr s, mpcb_ptr c, mpcb_srcptr x)
+{
+   /* With h = c_x theta and |h| <= b = r |c_x|, the derivatives cos and
+      -sin on the segment from c_x to c_x + h are bounded in absolute value
+      by cosh (|Im c_x| + b), so that both sin and cos have an absolute
+      error of at most a = b cosh (|Im c_x| + b). The parts of the centres
+      sin (x_r) cosh (x_i) + i cos (x_r) sinh (x_i) and
+      cos (x_r) cosh (x_i) - i sin (x_r) sinh (x_i) are obtained with three
+      roundings to nearest as in mpcb_exp. Either s or c may be NULL. */
+   mpfr_t a, t, sr, cr, shi, chi;
+   mpfr_prec_t p, ps, pc;
+   int saved, inex;
+
+   saved = flags_save ();
+   ps = (s == NULL ? MPFR_PREC_MIN : mpcb_get_prec (s));
+   pc = (c == NULL ? MPFR_PREC_MIN : mpcb_get_prec (c));
+   p = MPC_MAX (ps, pc);
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (sr, p);
+   mpc_scratch_init2 (cr, p);
+   mpc_scratch_init2 (shi, p);
+   mpc_scratch_init2 (chi, p);
+
+   rad_abs (a, x->c);
+   mpfr_mul (a, a, x->r, MPFR_RNDU);
+   mpfr_set (t, mpc_imagref (x->c), MPFR_RNDU);
+   mpfr_abs (t, t, MPFR_RNDU);
+   mpfr_add (t, t, a, MPFR_RNDU);
+   mpfr_cosh (t, t, MPFR_RNDU);
+   mpfr_mul (a, a, t, MPFR_RNDU);
+
+   inex = mpfr_sin_cos (sr, cr, mpc_realref (x->c), MPFR_RNDN);
+   inex |= mpfr_sinh_cosh (shi, chi, mpc_imagref (x->c), MPFR_RNDN);
+
+   if (s != NULL) {
+      int inex_s = inex;
+      inex_s |= mpfr_mul (mpc_realref (s->c), sr, chi, MPFR_RNDN);
+      inex_s |= mpfr_mul (mpc_imagref (s->c), cr, shi, MPFR_RNDN);
+      rad_rel (s->r, a, s->c);
+      rad_round (t, 4, ps, inex_s);
+      mpfr_add (s->r, s->r, t, MPFR_RNDU);
+   }
+   if (c != NULL) {
+      int inex_c = inex;
+      inex_c |= mpfr_mul (mpc_realref (c->c), cr, chi, MPFR_RNDN);
+      inex_c |= mpfr_mul (mpc_imagref (c->c), sr, shi, MPFR_RNDN);
+      mpfr_neg (mpc_imagref (c->c), mpc_imagref (c->c), MPFR_RNDN);
+      rad_rel (c->r, a, c->c);
+      rad_round (t, 4, pc, inex_c);
+      mpfr_add (c->r, c->r, t, MPFR_RNDU);
+   }
+
+   mpc_scratch_clear (a);
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (sr);
+   mpc_scratch_clear (cr);
+   mpc_scratch_clear (shi);
+   mpc_scratch_clear (chi);
+   if (s != NULL)
+      ball_check (s);
+   if (c != NULL)
+      ball_check (c);
+   flags_restore (saved);
+}
+
+void
+mpcb_sqrt (mpcb_ptr z, mpcb_srcptr x)
+{
+   /* Outside the branch cut, sqrt (c (1 + theta)) = sqrt (c) (1 + theta')
+      with |theta'| <= r by (eq:propsqrt) in algorithms.tex. With
+      w = sqrt ((|x_r| + |c|) / 2), the centre is w + i x_i / (2w) if
+      x_r >= 0 and |x_i| / (2w) + i sign (x_i) w otherwise. The sum
+      |x_r| + |c| is obtained with a relative error of at most
+      (1+u)^2 - 1 <= 2.25u, w with a relative error of at most
+      (1+u) sqrt (1 + 2.25u) - 1 <= 2.5u, and x_i / (2w) with a relative
+      error of at most (1+u) / (1-2.5u) - 1 = 3.5u / (1-2.5u), which is
+      at most 6u / (1-6u) relative to the computed value. */
+   mpfr_t t, h, w, v;
+   mpfr_prec_t p;
+   int saved, inex;
+
+   if (!mpc_fin_p (x->c)) {
+      mpc_set_nan (z->c);
+      mpfr_set_inf (z->r, +1);
+      return;
+   }
+   else if (mpc_zero_p (x->c)) {
+      int inf = mpfr_inf_p (x->r);
+      mpc_set_ui (z->c, 0, MPC_RNDNN);
+      if (inf)
+         mpfr_set_inf (z->r, +1);
+      else
+         mpfr_set_ui (z->r, 0, MPFR_RNDU);
+      return;
+   }
+   else if (branch_cut_p (x)) {
+      mpc_set_nan (z->c);
+      mpfr_set_inf (z->r, +1);
+      return;
+   }
+
+   saved = flags_save ();
+   p = mpcb_get_prec (z);
+   mpc_scratch_init2 (t, MPCB_RAD_PREC);
+   mpc_scratch_init2 (h, p);
+   mpc_scratch_init2 (w, p);
+   mpc_scratch_init2 (v, p);
+
+   inex = mpfr_hypot (h, mpc_realref (x->c), mpc_imagref (x->c), MPFR_RNDN);
+   if (mpfr_sgn (mpc_realref (x->c)) >= 0)
+      inex |= mpfr_add (h, h, mpc_realref (x->c), MPFR_RNDN);
+   else
+      inex |= mpfr_sub (h, h, mpc_realref (x->c), MPFR_RNDN);
+   mpfr_div_2ui (h, h, 1, MPFR_RNDN);
+   inex |= mpfr_sqrt (w, h, MPFR_RNDN);
+   mpfr_mul_2ui (h, w, 1, MPFR_RNDN);
+   inex |= mpfr_div (v, mpc_imagref (x->c), h, MPFR_RNDN);
+
+   if (mpfr_sgn (mpc_realref (x->c)) >= 0) {
+      mpfr_set (mpc_realref (z->c), w, MPFR_RNDN);
+      mpfr_set (mpc_imagref (z->c), v, MPFR_RNDN);
+   }
+   else {
+      mpfr_abs (mpc_realref (z->c), v, MPFR_RNDN);
+      mpfr_setsign (mpc_imagref (z->c), w,
+                    mpfr_signbit (mpc_imagref (x->c)), MPFR_RNDN);
+   }
+
+   rad_round (t, 6, p, inex);
+   rad_mul (z->r, x->r, t);
+
+   mpc_scratch_clear (t);
+   mpc_scratch_clear (h);
+   mpc_scratch_clear (w);
+   mpc_scratch_clear (v);
+   ball_end (z, saved);
+}
+
+void
+mpcb_pow (mpcb_ptr z, mpcb_srcptr x, mpcb_srcptr y)
+{
+   /* z = exp (y log x), where the logarithm and the product are computed
+      with a few guard bits to absorb their rounding errors */
+   mpcb_t l;
+
+   mpcb_init2 (l, mpcb_get_prec (z) + MPCB_POW_GUARD);
+   mpcb_log (l, x);
+   mpcb_mul (l, l, y);
+   mpcb_exp (z, l);
+   mpcb_clear (l);
+}
+
+/* returns non-zero if the part x of a centre with an absolute error of at
+   most a can be rounded correctly to prec bits in the direction rnd */
+static int
+can_round_part (mpfr_srcptr x, mpfr_srcptr a, mpfr_prec_t prec,
+                mpfr_rnd_t rnd)
+{
+   mpfr_exp_t err;
+
+   if (mpfr_zero_p (a))
+      return 1;
+   else if (!mpfr_regular_p (x))
+      return 0;
+
+   /* a < 2^EXP(a) */
+   err = mpfr_get_exp (x) - mpfr_get_exp (a);
+   return err > 0 && MPC_CAN_ROUND (x, err, prec, rnd);
+}
+
+int
+mpcb_can_round (mpcb_srcptr z, mpfr_prec_t prec_re, mpfr_prec_t prec_im,
+                mpc_rnd_t rnd)
+{
+   /* Each part of the centre has an absolute error of at most r |c|. */
+   mpfr_t a;
+   int saved, res;
+
+   if (!mpfr_number_p (z->r) || !mpc_fin_p (z->c))
+      return 0;
+
+   saved = flags_save ();
+   mpc_scratch_init2 (a, MPCB_RAD_PREC);
+   rad_abs (a, z->c);
+   mpfr_mul (a, a, z->r, MPFR_RNDU);
+   res = mpfr_number_p (a)
+         && can_round_part (mpc_realref (z->c), a, prec_re, MPC_RND_RE (rnd))
+         && can_round_part (mpc_imagref (z->c), a, prec_im, MPC_RND_IM (rnd));
+   mpc_scratch_clear (a);
+   flags_restore (saved);
+
+   return res;
+}
+
+int
+mpcb_round (mpc_ptr rop, mpcb_srcptr z, mpc_rnd_t rnd)
+{
+   return mpc_set (rop, z->c, MPC_RND_FTON_C (rnd));
+}
@@ -21,6 +21,13 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdio.h>    /* for MPC_ASSERT */
 #include "mpc-impl.h"
 
+/* precisions in bits above which mpc_mul uses Karatsuba resp. Gauss
+   multiplication, see mpc_set_mul_threshold */
+static mpfr_prec_t mul_karatsuba_threshold =
+   (mpfr_prec_t) MUL_KARATSUBA_THRESHOLD * GMP_NUMB_BITS;
+static mpfr_prec_t mul_gauss_threshold =
+   (mpfr_prec_t) MUL_GAUSS_THRESHOLD * GMP_NUMB_BITS;
+
 #define mpz_add_si(z,x,y) do { \
    if (y >= 0) \
       mpz_add_ui (z, x, (long int) y); \
@@ -173,20 +180,29 @@ mul_imag (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
 
 static int
 mpfr_fmma (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
-           mpfr_srcptr d, int sign, mpfr_rnd_t rnd)
+           mpfr_srcptr d, int sign, mpfr_rnd_t rnd, mpfr_ptr u, mpfr_ptr v)
 {
    /* Computes z = ab+cd if sign >= 0, or z = ab-cd if sign < 0.
       Assumes that a, b, c, d are finite and non-zero; so any multiplication
       of two of them yielding an infinity is an overflow, and a
       multiplication yielding 0 is an underflow.
-      Assumes further that z is distinct from a, b, c, d. */
+      Assumes further that z is distinct from a, b, c, d.
+      u and v are initialised temporary variables provided by the caller,
+      their precision is changed here. */
 
    int inex;
-   mpfr_t u, v;
+   mpfr_t us, vs;
+   mp_limb_t ul [2 * MPC_SMALL_LIMBS], vl [2 * MPC_SMALL_LIMBS];
+
+   if (   mpc_mul_small (us, ul, a, b, 0)
+       && mpc_mul_small (vs, vl, c, d, sign < 0))
+      /* The exact products are in the exponent range, so that a single
+         rounded addition yields the correct result. */
+      return mpfr_add (z, us, vs, rnd);
 
    /* u=a*b, v=sign*c*d exactly */
-   mpfr_init2 (u, mpfr_get_prec (a) + mpfr_get_prec (b));
-   mpfr_init2 (v, mpfr_get_prec (c) + mpfr_get_prec (d));
+   mpfr_set_prec (u, mpfr_get_prec (a) + mpfr_get_prec (b));
+   mpfr_set_prec (v, mpfr_get_prec (c) + mpfr_get_prec (d));
    mpfr_mul (u, a, b, MPFR_RNDN);
    mpfr_mul (v, c, d, MPFR_RNDN);
    if (sign < 0)
@@ -314,13 +330,24 @@ mpfr_fmma (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
          /* works also when some of a, b, c, d are not all distinct */
    }
 
-   mpfr_clear (u);
-   mpfr_clear (v);
-
    return inex;
 }
 
 
+static int
+mul_naive (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd,
+           mpfr_ptr u, mpfr_ptr v)
+{
+   /* computes z=x*y by the schoolbook method, where x and y are assumed
+      to be finite and without zero parts, and z is distinct from x and y;
+      u and v are temporary variables for mpfr_fmma                      */
+   return MPC_INEX (mpfr_fmma (mpc_realref (z), mpc_realref (x), mpc_realref (y), mpc_imagref (x),
+                               mpc_imagref (y), -1, MPC_RND_RE (rnd), u, v),
+                    mpfr_fmma (mpc_imagref (z), mpc_realref (x), mpc_imagref (y), mpc_imagref (x),
+                               mpc_realref (y), +1, MPC_RND_IM (rnd), u, v));
+}
+
+
 int
 mpc_mul_naive (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
 {
@@ -328,35 +355,46 @@ mpc_mul_naive (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
       to be finite and without zero parts                                */
    int overlap, inex;
    mpc_t rop;
+   mpfr_t u, v;
 
    MPC_ASSERT (   mpfr_regular_p (mpc_realref (x)) && mpfr_regular_p (mpc_imagref (x))
                && mpfr_regular_p (mpc_realref (y)) && mpfr_regular_p (mpc_imagref (y)));
    overlap = (z == x) || (z == y);
-   if (overlap)
-      mpc_init3 (rop, MPC_PREC_RE (z), MPC_PREC_IM (z));
+   if (overlap) {
+      mpc_scratch_init2 (mpc_realref (rop), MPC_PREC_RE (z));
+      mpc_scratch_init2 (mpc_imagref (rop), MPC_PREC_IM (z));
+   }
    else
       rop [0] = z [0];
+   mpc_scratch_init2 (u, 2);
+   mpc_scratch_init2 (v, 2);
 
-   inex = MPC_INEX (mpfr_fmma (mpc_realref (rop), mpc_realref (x), mpc_realref (y), mpc_imagref (x),
-                               mpc_imagref (y), -1, MPC_RND_RE (rnd)),
-                    mpfr_fmma (mpc_imagref (rop), mpc_realref (x), mpc_imagref (y), mpc_imagref (x),
-                               mpc_realref (y), +1, MPC_RND_IM (rnd)));
+   inex = mul_naive (rop, x, y, rnd, u, v);
 
    mpc_set (z, rop, MPC_RNDNN);
-   if (overlap)
-      mpc_clear (rop);
+   if (overlap) {
+      mpc_scratch_clear (mpc_realref (rop));
+      mpc_scratch_clear (mpc_imagref (rop));
+   }
+   mpc_scratch_clear (u);
+   mpc_scratch_clear (v);
 
    return inex;
 }
 
 
-int
-mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+static int
+mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd,
+               mpc_mul_precomp_srcptr pc)
 {
    /* computes rop=op1*op2 by a Karatsuba algorithm, where op1 and op2
-      are assumed to be finite and without zero parts                  */
-  mpfr_srcptr a, b, c, d;
+      are assumed to be finite and without zero parts; if pc is not NULL,
+      then op2 is pc->op and the sums of its parts are taken from pc   */
+  mpfr_srcptr a, b, c, d, ua, xs;
   int mul_i, ok, inexact, mul_a, mul_c, inex_re = 0, inex_im = 0, sign_x, sign_u;
+  int fixed, neg;
+     /* fixed is 2 (resp. 1) if pc is used and op2 is in c, d (resp. a, b);
+        neg is 1 if the product of u and x is to be negated */
   mpfr_t u, v, w, x;
   mpfr_prec_t prec, prec_re, prec_u, prec_v, prec_w;
   mpfr_rnd_t rnd_re, rnd_u;
@@ -373,8 +411,10 @@ mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
   const int MAX_MUL_LOOP = 1;
 
   overlap = (rop == op1) || (rop == op2);
-  if (overlap)
-     mpc_init3 (result, MPC_PREC_RE (rop), MPC_PREC_IM (rop));
+  if (overlap) {
+     mpc_scratch_init2 (mpc_realref (result), MPC_PREC_RE (rop));
+     mpc_scratch_init2 (mpc_imagref (result), MPC_PREC_IM (rop));
+  }
   else
      result [0] = rop [0];
 
@@ -396,7 +436,8 @@ mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
       mul_a = -1; /* consider i * (a+i*b) = -b + i*a */
     }
 
-  if (mpfr_cmp_abs (c, d) < 0)
+  fixed = (pc != NULL ? 2 : 0);
+  if (fixed ? pc->swap : mpfr_cmp_abs (c, d) < 0)
     {
       MPFR_SWAP (c, d);
       mul_i ++;
@@ -421,10 +462,10 @@ mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
   /* now |a| >= |b| and |c| >= |d| */
   prec = MPC_MAX_PREC(rop);
 
-  mpfr_init2 (v, prec_v = mpfr_get_prec (a) + mpfr_get_prec (d));
-  mpfr_init2 (w, prec_w = mpfr_get_prec (b) + mpfr_get_prec (c));
-  mpfr_init2 (u, 2);
-  mpfr_init2 (x, 2);
+  mpc_scratch_init2 (v, prec_v = mpfr_get_prec (a) + mpfr_get_prec (d));
+  mpc_scratch_init2 (w, prec_w = mpfr_get_prec (b) + mpfr_get_prec (c));
+  mpc_scratch_init2 (u, 2);
+  mpc_scratch_init2 (x, 2);
 
   inexact = mpfr_mul (v, a, d, MPFR_RNDN);
   if (inexact) {
@@ -462,6 +503,8 @@ mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
       mpfr_swap (v, w);
       { int tmp; tmp = mul_a; mul_a = mul_c; mul_c = tmp; }
       sign_x = - sign_x;
+      if (fixed)
+         fixed = 1;
     }
 
    /* now sign_x * sign_u >= 0 */
@@ -471,28 +514,57 @@ mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
         loop++;
          /* the following should give failures with prob. <= 1/prec */
          prec += mpc_ceil_log2 (prec) + 3;
+         MPC_STATS_LOOP (MUL, prec);
 
          mpfr_set_prec (u, prec_u = prec);
          mpfr_set_prec (x, prec);
+         if (fixed && (pc->gauss || prec != pc->prec))
+            fixed = 0;
+         neg = 0;
+
+         /* first compute away(b +/- a) and store it in u, or let ua point
+            to its precomputed value up to the sign */
+         if (fixed == 1) {
+            ua = (mul_a == -1 ? pc->diff : pc->sum);
+            inexact = (mul_a == -1 ? pc->inex_diff : pc->inex_sum);
+            neg = (mul_a == -1);
+         }
+         else {
+            ua = u;
+            inexact = (mul_a == -1 ?
+                       mpfr_sub (u, b, a, MPFR_RNDA) :
+                       mpfr_add (u, b, a, MPFR_RNDA));
+         }
 
-         /* first compute away(b +/- a) and store it in u */
-         inexact = (mul_a == -1 ?
-                    mpfr_sub (u, b, a, MPFR_RNDA) :
-                    mpfr_add (u, b, a, MPFR_RNDA));
-
-         /* then compute away(+/-c - d) and store it in x */
-         inexact |= (mul_c == -1 ?
-                     mpfr_add (x, c, d, MPFR_RNDA) :
-                     mpfr_sub (x, c, d, MPFR_RNDA));
-         if (mul_c == -1)
-           mpfr_neg (x, x, MPFR_RNDN);
+         /* then compute away(+/-c - d) and store it in x, or let xs point
+            to its precomputed value up to the sign */
+         if (fixed == 2) {
+            xs = (mul_c == -1 ? pc->sum : pc->diff);
+            inexact |= (mul_c == -1 ? pc->inex_sum : pc->inex_diff);
+            neg ^= (mul_c == -1);
+         }
+         else {
+            xs = x;
+            inexact |= (mul_c == -1 ?
+                        mpfr_add (x, c, d, MPFR_RNDA) :
+                        mpfr_sub (x, c, d, MPFR_RNDA));
+            if (mul_c == -1)
+              mpfr_neg (x, x, MPFR_RNDN);
+         }
 
-         if (inexact == 0)
-            mpfr_prec_round (u, prec_u = 2 * prec, MPFR_RNDN);
+         if (inexact == 0) {
+            prec_u = 2 * prec;
+            if (ua == u)
+               mpfr_prec_round (u, prec_u, MPFR_RNDN);
+            else
+               mpfr_set_prec (u, prec_u);
+         }
 
          /* compute away(u*x) and store it in u */
-         inexact |= mpfr_mul (u, u, x, MPFR_RNDA);
+         inexact |= mpfr_mul (u, ua, xs, MPFR_RNDA);
             /* (a+b)*(c-d) */
+         if (neg)
+            mpfr_neg (u, u, MPFR_RNDN);
 
 	 /* if all computations are exact up to here, it may be that
 	    the real part is exact, thus we need if possible to
@@ -578,26 +650,313 @@ mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
    }
 
 clear:
-   mpfr_clear (u);
-   mpfr_clear (v);
-   mpfr_clear (w);
-   mpfr_clear (x);
-   if (overlap)
-      mpc_clear (result);
+   mpc_scratch_clear (u);
+   mpc_scratch_clear (v);
+   mpc_scratch_clear (w);
+   mpc_scratch_clear (x);
+   if (overlap) {
+      mpc_scratch_clear (mpc_realref (result));
+      mpc_scratch_clear (mpc_imagref (result));
+   }
 
    if (ok)
       return MPC_INEX(inex_re, inex_im);
+   MPC_STATS_FALLBACK (MUL);
+   return mpc_mul_naive (rop, op1, op2, rnd);
+}
+
+
+int
+mpc_mul_karatsuba (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   /* computes rop=op1*op2 by a Karatsuba algorithm, where op1 and op2
+      are assumed to be finite and without zero parts                  */
+   return mul_karatsuba (rop, op1, op2, rnd, NULL);
+}
+
+
+/* return the maximum of e and the exponent of x, ignoring x if it is 0 */
+static mpfr_exp_t
+max_exp (mpfr_exp_t e, mpfr_srcptr x)
+{
+   if (!mpfr_zero_p (x) && mpfr_get_exp (x) > e)
+      return mpfr_get_exp (x);
    else
-      return mpc_mul_naive (rop, op1, op2, rnd);
+      return e;
+}
+
+
+/* working precision of the first loop of mul_gauss for a target
+   precision prec */
+static mpfr_prec_t
+gauss_prec (mpfr_prec_t prec)
+{
+   return prec + mpc_ceil_log2 (prec) + 6;
+}
+
+
+static int
+mul_gauss (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd,
+           mpc_mul_precomp_srcptr pc)
+{
+   /* computes rop=op1*op2 with three real multiplications at a working
+      precision w slightly above the target precision, where op1 and op2
+      are assumed to be finite and without zero parts; if pc is not NULL,
+      then op2 is pc->op and c+d or c-d is taken from pc.
+      With op1 = a+i*b and op2 = c+i*d, either
+         p1 = ac, p2 = bd, m = (a+b)(c+d), Re = p1-p2, Im = m-p1-p2 (sgn=-1)
+      or
+         p1 = ad, p2 = bc, m = (a+b)(c-d), Im = p1+p2, Re = m+p1-p2 (sgn=1),
+      so that the part obtained from m is the one that cannot suffer from
+      cancellation in the schoolbook formula. All operations are rounded to
+      nearest at precision w; the error analysis is in algorithms.tex.   */
+   mpfr_srcptr a, b, c, d, s2p;
+   mpfr_t p1, p2, s1, s2, m, dir, kar;
+      /* dir is the part computed directly from p1 and p2,
+         kar the one computed through m */
+   mpfr_ptr x, y;
+   mpfr_prec_t prec, w;
+   mpfr_exp_t e1, e2, e3, e4, e_re, e_im, e_max, err_dir, err_kar, lost;
+   int sgn, loop, ok, exact_dir, exact_kar, inex_re = 0, inex_im = 0;
+   int saved_underflow, saved_overflow;
+   const int MAX_MUL_LOOP = 2;
+
+   a = mpc_realref (op1);
+   b = mpc_imagref (op1);
+   c = mpc_realref (op2);
+   d = mpc_imagref (op2);
+
+   /* Compute through m the part of the result of larger absolute value,
+      estimated from the exponents of the four products; the part whose
+      products have close exponents and are subtracted may suffer from
+      cancellation and is considered to be the smaller one. */
+   e1 = mpfr_get_exp (a) + mpfr_get_exp (c);
+   e2 = mpfr_get_exp (b) + mpfr_get_exp (d);
+   e3 = mpfr_get_exp (a) + mpfr_get_exp (d);
+   e4 = mpfr_get_exp (b) + mpfr_get_exp (c);
+   e_re = MPC_MAX (e1, e2);
+   e_im = MPC_MAX (e3, e4);
+   if (mpfr_signbit (a) ^ mpfr_signbit (b) ^ mpfr_signbit (c)
+       ^ mpfr_signbit (d))
+      /* ac and bd have different signs, ad and bc as well */
+      sgn = (SAFE_ABS (mpfr_exp_t, e3 - e4) <= 1 || e_re >= e_im ? 1 : -1);
+   else
+      sgn = (SAFE_ABS (mpfr_exp_t, e1 - e2) <= 1 || e_im >= e_re ? -1 : 1);
+
+   prec = MPC_MAX_PREC (rop);
+   w = gauss_prec (prec);
+
+   mpc_scratch_init2 (p1, w);
+   mpc_scratch_init2 (p2, w);
+   mpc_scratch_init2 (s1, w);
+   mpc_scratch_init2 (s2, w);
+   mpc_scratch_init2 (m, w);
+   mpc_scratch_init2 (dir, w);
+   mpc_scratch_init2 (kar, w);
+   if (sgn == -1) {
+      x = dir;
+      y = kar;
+   }
+   else {
+      x = kar;
+      y = dir;
+   }
+
+   /* save the underflow or overflow flags from MPFR */
+   saved_underflow = mpfr_underflow_p ();
+   saved_overflow = mpfr_overflow_p ();
+
+   loop = 0;
+   do {
+      loop++;
+      MPC_STATS_LOOP (MUL, w);
+      mpfr_clear_underflow ();
+      mpfr_clear_overflow ();
+      if (loop > 1) {
+         mpfr_set_prec (p1, w);
+         mpfr_set_prec (p2, w);
+         mpfr_set_prec (s1, w);
+         mpfr_set_prec (s2, w);
+         mpfr_set_prec (m, w);
+         mpfr_set_prec (dir, w);
+         mpfr_set_prec (kar, w);
+      }
+
+      exact_dir = (mpfr_mul (p1, a, (sgn == -1 ? c : d), MPFR_RNDN) == 0);
+      exact_dir &= (mpfr_mul (p2, b, (sgn == -1 ? d : c), MPFR_RNDN) == 0);
+      exact_kar = exact_dir;
+      exact_dir &= ((sgn == -1 ?
+                     mpfr_sub (dir, p1, p2, MPFR_RNDN) :
+                     mpfr_add (dir, p1, p2, MPFR_RNDN)) == 0);
+
+      exact_kar &= (mpfr_add (s1, a, b, MPFR_RNDN) == 0);
+      if (pc != NULL && pc->gauss && w == pc->prec) {
+         s2p = (sgn == -1 ? pc->sum : pc->diff);
+         exact_kar &= ((sgn == -1 ? pc->inex_sum : pc->inex_diff) == 0);
+      }
+      else {
+         s2p = s2;
+         exact_kar &= ((sgn == -1 ?
+                        mpfr_add (s2, c, d, MPFR_RNDN) :
+                        mpfr_sub (s2, c, d, MPFR_RNDN)) == 0);
+      }
+      exact_kar &= (mpfr_mul (m, s1, s2p, MPFR_RNDN) == 0);
+      e_max = max_exp (max_exp (max_exp (mpfr_get_emin (), m), p1), p2);
+      exact_kar &= ((sgn == -1 ?
+                     mpfr_sub (kar, m, p1, MPFR_RNDN) :
+                     mpfr_add (kar, m, p1, MPFR_RNDN)) == 0);
+      e_max = max_exp (e_max, kar);
+      exact_kar &= (mpfr_sub (kar, kar, p2, MPFR_RNDN) == 0);
+
+      if (mpfr_underflow_p () || mpfr_overflow_p ()) {
+         ok = 0;
+         break;
+      }
+
+      /* the error of dir is bounded by 2^(e-w+1), that of kar by
+         2^(e'-w+3) with e and e' the maximal exponents occurring in their
+         computations */
+      ok = 1;
+      lost = 0;
+      if (!exact_dir) {
+         if (mpfr_zero_p (dir))
+            err_dir = 0;
+         else
+            err_dir = w - 1 - (max_exp (max_exp (mpfr_get_exp (dir), p1), p2)
+                               - mpfr_get_exp (dir));
+         if (!mpfr_can_round (dir, err_dir, MPFR_RNDN, MPFR_RNDZ,
+                              mpfr_get_prec (sgn == -1 ? mpc_realref (rop)
+                                                       : mpc_imagref (rop))
+                              + ((sgn == -1 ? MPC_RND_RE (rnd)
+                                            : MPC_RND_IM (rnd)) == MPFR_RNDN))) {
+            ok = 0;
+            lost = w - err_dir;
+         }
+      }
+      if (!exact_kar) {
+         if (mpfr_zero_p (kar))
+            err_kar = 0;
+         else
+            err_kar = w - 3 - (max_exp (e_max, kar) - mpfr_get_exp (kar));
+         if (!mpfr_can_round (kar, err_kar, MPFR_RNDN, MPFR_RNDZ,
+                              mpfr_get_prec (sgn == -1 ? mpc_imagref (rop)
+                                                       : mpc_realref (rop))
+                              + ((sgn == -1 ? MPC_RND_IM (rnd)
+                                            : MPC_RND_RE (rnd)) == MPFR_RNDN))) {
+            ok = 0;
+            lost = MPC_MAX (lost, w - err_kar);
+         }
+      }
+      if (!ok)
+         w += lost + mpc_ceil_log2 (w);
+   } while (!ok && loop < MAX_MUL_LOOP && w <= 2 * prec);
+      /* beyond a working precision of 2*prec, the schoolbook method with
+         its exact products is faster */
+
+   /* restore underflow and overflow flags from MPFR */
+   if (saved_underflow)
+     mpfr_set_underflow ();
+   if (saved_overflow)
+     mpfr_set_overflow ();
+
+   if (ok) {
+      /* a zero part is exact, and like the exact zero sum of two non-zero
+         products in mpfr_fmma it is -0 when rounding towards -infinity
+         and +0 otherwise, whatever the order of the operations */
+      if (mpfr_zero_p (x))
+         mpfr_setsign (x, x, MPC_RND_RE (rnd) == MPFR_RNDD, MPFR_RNDN);
+      if (mpfr_zero_p (y))
+         mpfr_setsign (y, y, MPC_RND_IM (rnd) == MPFR_RNDD, MPFR_RNDN);
+      inex_re = mpfr_set (mpc_realref (rop), x, MPC_RND_RE (rnd));
+      inex_im = mpfr_set (mpc_imagref (rop), y, MPC_RND_IM (rnd));
+   }
+
+   mpc_scratch_clear (p1);
+   mpc_scratch_clear (p2);
+   mpc_scratch_clear (s1);
+   mpc_scratch_clear (s2);
+   mpc_scratch_clear (m);
+   mpc_scratch_clear (dir);
+   mpc_scratch_clear (kar);
+
+   if (ok)
+      return MPC_INEX (inex_re, inex_im);
+   MPC_STATS_FALLBACK (MUL);
+   return mpc_mul_naive (rop, op1, op2, rnd);
+}
+
+
+int
+mpc_mul_gauss (mpc_ptr rop, mpc_srcptr op1, mpc_srcptr op2, mpc_rnd_t rnd)
+{
+   /* computes rop=op1*op2 by the three multiplication algorithm, where op1
+      and op2 are assumed to be finite and without zero parts           */
+   return mul_gauss (rop, op1, op2, rnd, NULL);
+}
+
+
+/* return non-zero if the real and imaginary part of b have a very different
+   exponent, so that it is not reasonable to use Karatsuba multiplication */
+static int
+mul_spread_p (mpc_srcptr b)
+{
+   return SAFE_ABS (mpfr_exp_t,
+                    mpfr_get_exp (mpc_realref (b)) - mpfr_get_exp (mpc_imagref (b)))
+          > (mpfr_exp_t) MPC_MAX_PREC (b) / 2;
+}
+
+
+typedef int (*mul_func_t) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+
+/* return the function used by mpc_mul for a=b*c, where b and c are finite
+   and without zero parts, and spread is mul_spread_p (c), which
+   mpc_mul_precomp knows from mpc_mul_precomp_init */
+static mul_func_t
+mul_choose_spread (mpc_srcptr a, mpc_srcptr b, int spread)
+{
+   if (spread || mul_spread_p (b))
+      return mpc_mul_naive;
+   else if (MPC_MAX_PREC (a) > mul_gauss_threshold)
+      return mpc_mul_gauss;
+   else if (MPC_MAX_PREC (a) > mul_karatsuba_threshold)
+      return mpc_mul_karatsuba;
+   else
+      return mpc_mul_naive;
+}
+
+static mul_func_t
+mul_choose (mpc_srcptr a, mpc_srcptr b, mpc_srcptr c)
+{
+   return mul_choose_spread (a, b, mul_spread_p (c));
+}
+
+
+void
+mpc_set_mul_threshold (mpfr_prec_t karatsuba, mpfr_prec_t gauss)
+{
+   mul_karatsuba_threshold = karatsuba;
+   mul_gauss_threshold = gauss;
+}
+
+
+void
+mpc_get_mul_threshold (mpfr_prec_t *karatsuba, mpfr_prec_t *gauss)
+{
+   *karatsuba = mul_karatsuba_threshold;
+   *gauss = mul_gauss_threshold;
 }
 
 
 int
 mpc_mul (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
 {
+   int inex;
+
    /* Conforming to ISO C99 standard (G.5.1 multiplicative operators),
       infinities are treated specially if both parts are NaN when computed
       naively. */
+   MPC_STATS_CALL (MUL);
+
    if (mpc_inf_p (b))
       return mul_infinite (a, b, c);
    if (mpc_inf_p (c))
@@ -623,17 +982,150 @@ mpc_mul (mpc_ptr a, mpc_srcptr b, mpc_srcptr c, mpc_rnd_t rnd)
    if (mpfr_zero_p (mpc_realref (c)))
       return mul_imag (a, b, c, rnd);
 
-   /* If the real and imaginary part of one argument have a very different */
-   /* exponent, it is not reasonable to use Karatsuba multiplication.      */
-   if (   SAFE_ABS (mpfr_exp_t,
-                     mpfr_get_exp (mpc_realref (b)) - mpfr_get_exp (mpc_imagref (b)))
-         > (mpfr_exp_t) MPC_MAX_PREC (b) / 2
-      || SAFE_ABS (mpfr_exp_t,
-                     mpfr_get_exp (mpc_realref (c)) - mpfr_get_exp (mpc_imagref (c)))
-         > (mpfr_exp_t) MPC_MAX_PREC (c) / 2)
-      return mpc_mul_naive (a, b, c, rnd);
-   else
-      return ((MPC_MAX_PREC(a)
-               <= (mpfr_prec_t) MUL_KARATSUBA_THRESHOLD * BITS_PER_MP_LIMB)
-            ? mpc_mul_naive : mpc_mul_karatsuba) (a, b, c, rnd);
+   if ((inex = mpc_mul_dd (a, b, c, rnd)) != MPC_DD_FAIL)
+      return inex;
+
+   return mul_choose (a, b, c) (a, b, c, rnd);
+}
+
+
+int
+mpc_mul_vec (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, size_t n, mpc_rnd_t rnd)
+{
+   /* computes z[i] = x[i]*y[i] for 0 <= i < n with the same results as n
+      calls to mpc_mul; the temporary variables of the schoolbook method
+      are allocated only once for the whole vector, and elements without
+      special parts skip the case distinctions of mpc_mul; elements of
+      precision at most 53 bits are first tried in double precision */
+   mpfr_t u, v;
+   mpc_t rop;
+   mul_func_t f;
+   size_t i;
+   int inex = 0, inex_dd;
+
+   if (n == 0)
+      return 0;
+
+   mpc_scratch_init2 (u, 2);
+   mpc_scratch_init2 (v, 2);
+   mpc_scratch_init2 (mpc_realref (rop), 2);
+   mpc_scratch_init2 (mpc_imagref (rop), 2);
+
+   for (i = 0; i < n; i++) {
+      mpc_ptr zi = z + i;
+      mpc_srcptr xi = x + i, yi = y + i;
+
+      if (   !mpfr_regular_p (mpc_realref (xi))
+          || !mpfr_regular_p (mpc_imagref (xi))
+          || !mpfr_regular_p (mpc_realref (yi))
+          || !mpfr_regular_p (mpc_imagref (yi)))
+         inex |= mpc_mul (zi, xi, yi, rnd);
+      else {
+         MPC_STATS_CALL (MUL);
+         if ((inex_dd = mpc_mul_dd (zi, xi, yi, rnd)) != MPC_DD_FAIL)
+            inex |= inex_dd;
+         else if ((f = mul_choose (zi, xi, yi)) != mpc_mul_naive)
+            inex |= f (zi, xi, yi, rnd);
+         else if (zi == xi || zi == yi) {
+            mpfr_set_prec (mpc_realref (rop), MPC_PREC_RE (zi));
+            mpfr_set_prec (mpc_imagref (rop), MPC_PREC_IM (zi));
+            inex |= mul_naive (rop, xi, yi, rnd, u, v);
+            mpc_set (zi, rop, MPC_RNDNN);
+         }
+         else
+            inex |= mul_naive (zi, xi, yi, rnd, u, v);
+      }
+   }
+
+   mpc_scratch_clear (u);
+   mpc_scratch_clear (v);
+   mpc_scratch_clear (mpc_realref (rop));
+   mpc_scratch_clear (mpc_imagref (rop));
+
+   return inex;
+}
+
+
+void
+mpc_mul_precomp_init (mpc_mul_precomp_ptr pc, mpc_srcptr op, mpfr_prec_t prec)
+{
+   /* prepares pc for multiplications by op with results of precision prec;
+      the sums of the parts of op are computed only if mpc_mul would use
+      Karatsuba or Gauss multiplication at this precision, and at the
+      precision of the first loop in mul_karatsuba resp. mul_gauss */
+   mpc_init3 (pc->op, MPC_PREC_RE (op), MPC_PREC_IM (op));
+   mpc_set (pc->op, op, MPC_RNDNN); /* exact */
+   mpfr_init2 (pc->sum, 2);
+   mpfr_init2 (pc->diff, 2);
+   pc->regular =    mpfr_regular_p (mpc_realref (op))
+                 && mpfr_regular_p (mpc_imagref (op));
+   pc->spread = pc->regular && mul_spread_p (op);
+   pc->swap = pc->regular
+              && mpfr_cmp_abs (mpc_realref (op), mpc_imagref (op)) < 0;
+   pc->gauss = (prec > mul_gauss_threshold);
+   pc->prec = 0;
+   pc->inex_sum = 0;
+   pc->inex_diff = 0;
+
+   if (pc->regular && !pc->spread && pc->gauss) {
+      pc->prec = gauss_prec (prec);
+      mpfr_set_prec (pc->sum, pc->prec);
+      mpfr_set_prec (pc->diff, pc->prec);
+      pc->inex_sum = mpfr_add (pc->sum, mpc_realref (op), mpc_imagref (op),
+                               MPFR_RNDN);
+      pc->inex_diff = mpfr_sub (pc->diff, mpc_realref (op), mpc_imagref (op),
+                                MPFR_RNDN);
+   }
+   else if (pc->regular && !pc->spread && prec > mul_karatsuba_threshold) {
+      mpfr_srcptr c, d;
+
+      if (pc->swap) {
+         c = mpc_imagref (op);
+         d = mpc_realref (op);
+      }
+      else {
+         c = mpc_realref (op);
+         d = mpc_imagref (op);
+      }
+      pc->prec = prec + mpc_ceil_log2 (prec) + 3;
+      mpfr_set_prec (pc->sum, pc->prec);
+      mpfr_set_prec (pc->diff, pc->prec);
+      pc->inex_sum = mpfr_add (pc->sum, c, d, MPFR_RNDA);
+      pc->inex_diff = mpfr_sub (pc->diff, c, d, MPFR_RNDA);
+   }
+}
+
+
+void
+mpc_mul_precomp_clear (mpc_mul_precomp_ptr pc)
+{
+   mpc_clear (pc->op);
+   mpfr_clear (pc->sum);
+   mpfr_clear (pc->diff);
+}
+
+
+int
+mpc_mul_precomp (mpc_ptr rop, mpc_srcptr op, mpc_mul_precomp_srcptr pc,
+                 mpc_rnd_t rnd)
+{
+   /* computes rop = op * pc->op with the same result as mpc_mul */
+   if (   !pc->regular
+       || !mpfr_regular_p (mpc_realref (op))
+       || !mpfr_regular_p (mpc_imagref (op)))
+      return mpc_mul (rop, op, pc->op, rnd);
+   else {
+      mul_func_t f = mul_choose_spread (rop, op, pc->spread);
+      int inex;
+
+      MPC_STATS_CALL (MUL);
+      if ((inex = mpc_mul_dd (rop, op, pc->op, rnd)) != MPC_DD_FAIL)
+         return inex;
+      else if (f == mpc_mul_gauss)
+         return mul_gauss (rop, op, pc->op, rnd, pc);
+      else if (f == mpc_mul_karatsuba)
+         return mul_karatsuba (rop, op, pc->op, rnd, pc);
+      else
+         return mpc_mul_naive (rop, op, pc->op, rnd);
+   }
 }
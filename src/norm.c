@@ -21,162 +21,264 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdio.h>    /* for MPC_ASSERT */
 #include "mpc-impl.h"
 
-/* a <- norm(b) = b * conj(b)
-   (the rounding mode is mpfr_rnd_t here since we return an mpfr number) */
-int
-mpc_norm (mpfr_ptr a, mpc_srcptr b, mpfr_rnd_t rnd)
+/* The norm Re(b)^2 + Im(b)^2 and the absolute value, its square root, are
+   computed by mpc_sum_sqr from the exact squares of the parts of b, which
+   are obtained on the stack for small operands: the norm is their sum,
+   and the absolute value the square root of their exact sum, each rounded
+   once. Since the squares may lie outside of the current exponent range
+   while the result does not, they are computed in the largest one, and
+   the result is moved back by mpfr_check_range, as in fmma.c. Only when
+   the current exponent range is so large that the squares may not be
+   representable at all, norm_loop and mpfr_hypot are used instead. */
+
+/* computes a = norm(b) for b with finite non-zero parts by a Ziv loop,
+   scaling b in case of an underflow of the squares */
+static int
+norm_loop (mpfr_ptr a, mpc_srcptr b, mpfr_rnd_t rnd)
 {
    int inexact;
    int saved_underflow, saved_overflow;
+   mpfr_t u, v, res;
+   mpfr_prec_t prec, prec_u, prec_v;
+   int loops;
+   const int max_loops = 2;
+      /* switch to exact squarings when loops==max_loops */
 
-   /* handling of special values; consistent with abs in that
-      norm = abs^2; so norm (+-inf, xxx) = norm (xxx, +-inf) = +inf */
-   if (!mpc_fin_p (b))
-         return mpc_abs (a, b, rnd);
-   else if (mpfr_zero_p (mpc_realref (b))) {
-      if (mpfr_zero_p (mpc_imagref (b)))
-         return mpfr_set_ui (a, 0, rnd); /* +0 */
-      else
-         return mpfr_sqr (a, mpc_imagref (b), rnd);
-   }
-   else if (mpfr_zero_p (mpc_imagref (b)))
-     return mpfr_sqr (a, mpc_realref (b), rnd); /* Re(b) <> 0 */
-
-   else /* everything finite and non-zero */ {
-      mpfr_t u, v, res;
-      mpfr_prec_t prec, prec_u, prec_v;
-      int loops;
-      const int max_loops = 2;
-         /* switch to exact squarings when loops==max_loops */
-
-      prec = mpfr_get_prec (a);
-
-      mpfr_init (u);
-      mpfr_init (v);
-      mpfr_init (res);
-
-      /* save the underflow or overflow flags from MPFR */
-      saved_underflow = mpfr_underflow_p ();
-      saved_overflow = mpfr_overflow_p ();
-
-      loops = 0;
-      mpfr_clear_underflow ();
-      mpfr_clear_overflow ();
-      do {
-         loops++;
-         prec += mpc_ceil_log2 (prec) + 3;
-         if (loops >= max_loops) {
-            prec_u = 2 * MPC_PREC_RE (b);
-            prec_v = 2 * MPC_PREC_IM (b);
-         }
-         else {
-            prec_u = MPC_MIN (prec, 2 * MPC_PREC_RE (b));
-            prec_v = MPC_MIN (prec, 2 * MPC_PREC_IM (b));
-         }
+   prec = mpfr_get_prec (a);
 
-         mpfr_set_prec (u, prec_u);
-         mpfr_set_prec (v, prec_v);
+   mpc_scratch_init2 (u, 2);
+   mpc_scratch_init2 (v, 2);
+   mpc_scratch_init2 (res, 2);
 
-         inexact  = mpfr_sqr (u, mpc_realref(b), MPFR_RNDD); /* err <= 1 ulp in prec */
-         inexact |= mpfr_sqr (v, mpc_imagref(b), MPFR_RNDD); /* err <= 1 ulp in prec */
+   /* save the underflow or overflow flags from MPFR */
+   saved_underflow = mpfr_underflow_p ();
+   saved_overflow = mpfr_overflow_p ();
 
-         /* If loops = max_loops, inexact should be 0 here, except in case
-               of underflow or overflow.
-            If loops < max_loops and inexact is zero, we can exit the
-            while-loop since it only remains to add u and v into a. */
-         if (inexact) {
-             mpfr_set_prec (res, prec);
-             mpfr_add (res, u, v, MPFR_RNDD); /* err <= 3 ulp in prec */
-         }
+   loops = 0;
+   mpfr_clear_underflow ();
+   mpfr_clear_overflow ();
+   do {
+      loops++;
+      prec += mpc_ceil_log2 (prec) + 3;
+      MPC_STATS_LOOP (NORM, prec);
+      if (loops >= max_loops) {
+         MPC_STATS_FALLBACK (NORM);
+         prec_u = 2 * MPC_PREC_RE (b);
+         prec_v = 2 * MPC_PREC_IM (b);
+      }
+      else {
+         prec_u = MPC_MIN (prec, 2 * MPC_PREC_RE (b));
+         prec_v = MPC_MIN (prec, 2 * MPC_PREC_IM (b));
+      }
 
-      } while (loops < max_loops && inexact != 0
-               && !mpfr_can_round (res, prec - 2, MPFR_RNDD, MPFR_RNDU,
-                                   mpfr_get_prec (a) + (rnd == MPFR_RNDN)));
+      mpfr_set_prec (u, prec_u);
+      mpfr_set_prec (v, prec_v);
 
-      if (!inexact)
-         /* squarings were exact, neither underflow nor overflow */
-         inexact = mpfr_add (a, u, v, rnd);
-      /* if there was an overflow in Re(b)^2 or Im(b)^2 or their sum,
-         since the norm is larger, there is an overflow for the norm */
-      else if (mpfr_overflow_p ()) {
-         /* replace by "correctly rounded overflow" */
-         mpfr_set_ui (a, 1ul, MPFR_RNDN);
-         inexact = mpfr_mul_2ui (a, a, mpfr_get_emax (), rnd);
+      inexact  = mpfr_sqr (u, mpc_realref(b), MPFR_RNDD); /* err <= 1 ulp in prec */
+      inexact |= mpfr_sqr (v, mpc_imagref(b), MPFR_RNDD); /* err <= 1 ulp in prec */
+
+      /* If loops = max_loops, inexact should be 0 here, except in case
+            of underflow or overflow.
+         If loops < max_loops and inexact is zero, we can exit the
+         while-loop since it only remains to add u and v into a. */
+      if (inexact) {
+          mpfr_set_prec (res, prec);
+          mpfr_add (res, u, v, MPFR_RNDD); /* err <= 3 ulp in prec */
       }
-      else if (mpfr_underflow_p ()) {
-         /* necessarily one of the squarings did underflow (otherwise their
-            sum could not underflow), thus one of u, v is zero. */
-         mpfr_exp_t emin = mpfr_get_emin ();
-
-         /* Now either both u and v are zero, or u is zero and v exact,
-            or v is zero and u exact.
-            In the latter case, Im(b)^2 < 2^(emin-1).
-            If ulp(u) >= 2^(emin+1) and norm(b) is not exactly
-            representable at the target precision, then rounding u+Im(b)^2
-            is equivalent to rounding u+2^(emin-1).
-            For instance, if exp(u)>0 and the target precision is smaller
-            than about |emin|, the norm is not representable. To make the
-            scaling in the "else" case work without underflow, we test
-            whether exp(u) is larger than a small negative number instead.
-            The second case is handled analogously.                        */
-         if (!mpfr_zero_p (u)
-             && mpfr_get_exp (u) - 2 * (mpfr_exp_t) prec_u > emin
-             && mpfr_get_exp (u) > -10) {
-               mpfr_set_prec (v, MPFR_PREC_MIN);
-               mpfr_set_ui_2exp (v, 1, emin - 1, MPFR_RNDZ);
-               inexact = mpfr_add (a, u, v, rnd);
-         }
-         else if (!mpfr_zero_p (v)
-             && mpfr_get_exp (v) - 2 * (mpfr_exp_t) prec_v > emin
-             && mpfr_get_exp (v) > -10) {
-               mpfr_set_prec (u, MPFR_PREC_MIN);
-               mpfr_set_ui_2exp (u, 1, emin - 1, MPFR_RNDZ);
-               inexact = mpfr_add (a, u, v, rnd);
-         }
-         else {
-            unsigned long int scale, exp_re, exp_im;
-            int inex_underflow;
-
-            /* scale the input to an average exponent close to 0 */
-            exp_re = (unsigned long int) (-mpfr_get_exp (mpc_realref (b)));
-            exp_im = (unsigned long int) (-mpfr_get_exp (mpc_imagref (b)));
-            scale = exp_re / 2 + exp_im / 2 + (exp_re % 2 + exp_im % 2) / 2;
-               /* (exp_re + exp_im) / 2, computed in a way avoiding
-                  integer overflow                                  */
-            if (mpfr_zero_p (u)) {
-               /* recompute the scaled value exactly */
-               mpfr_mul_2ui (u, mpc_realref (b), scale, MPFR_RNDN);
-               mpfr_sqr (u, u, MPFR_RNDN);
-            }
-            else /* just scale */
-               mpfr_mul_2ui (u, u, 2*scale, MPFR_RNDN);
-            if (mpfr_zero_p (v)) {
-               mpfr_mul_2ui (v, mpc_imagref (b), scale, MPFR_RNDN);
-               mpfr_sqr (v, v, MPFR_RNDN);
-            }
-            else
-               mpfr_mul_2ui (v, v, 2*scale, MPFR_RNDN);
 
+   } while (loops < max_loops && inexact != 0
+            && !mpfr_can_round (res, prec - 2, MPFR_RNDD, MPFR_RNDU,
+                                mpfr_get_prec (a) + (rnd == MPFR_RNDN)));
+
+   if (!inexact)
+      /* squarings were exact, neither underflow nor overflow */
+      inexact = mpfr_add (a, u, v, rnd);
+   /* if there was an overflow in Re(b)^2 or Im(b)^2 or their sum,
+      since the norm is larger, there is an overflow for the norm */
+   else if (mpfr_overflow_p ()) {
+      /* replace by "correctly rounded overflow" */
+      mpfr_set_ui (a, 1ul, MPFR_RNDN);
+      inexact = mpfr_mul_2ui (a, a, mpfr_get_emax (), rnd);
+   }
+   else if (mpfr_underflow_p ()) {
+      /* necessarily one of the squarings did underflow (otherwise their
+         sum could not underflow), thus one of u, v is zero. */
+      mpfr_exp_t emin = mpfr_get_emin ();
+
+      /* Now either both u and v are zero, or u is zero and v exact,
+         or v is zero and u exact.
+         In the latter case, Im(b)^2 < 2^(emin-1).
+         If ulp(u) >= 2^(emin+1) and norm(b) is not exactly
+         representable at the target precision, then rounding u+Im(b)^2
+         is equivalent to rounding u+2^(emin-1).
+         For instance, if exp(u)>0 and the target precision is smaller
+         than about |emin|, the norm is not representable. To make the
+         scaling in the "else" case work without underflow, we test
+         whether exp(u) is larger than a small negative number instead.
+         The second case is handled analogously.                        */
+      if (!mpfr_zero_p (u)
+          && mpfr_get_exp (u) - 2 * (mpfr_exp_t) prec_u > emin
+          && mpfr_get_exp (u) > -10) {
+            mpfr_set_prec (v, MPFR_PREC_MIN);
+            mpfr_set_ui_2exp (v, 1, emin - 1, MPFR_RNDZ);
+            inexact = mpfr_add (a, u, v, rnd);
+      }
+      else if (!mpfr_zero_p (v)
+          && mpfr_get_exp (v) - 2 * (mpfr_exp_t) prec_v > emin
+          && mpfr_get_exp (v) > -10) {
+            mpfr_set_prec (u, MPFR_PREC_MIN);
+            mpfr_set_ui_2exp (u, 1, emin - 1, MPFR_RNDZ);
             inexact = mpfr_add (a, u, v, rnd);
-            mpfr_clear_underflow ();
-            inex_underflow = mpfr_div_2ui (a, a, 2*scale, rnd);
-            if (mpfr_underflow_p ())
-               inexact = inex_underflow;
+      }
+      else {
+         unsigned long int scale, exp_re, exp_im;
+         int inex_underflow;
+
+         /* scale the input to an average exponent close to 0 */
+         exp_re = (unsigned long int) (-mpfr_get_exp (mpc_realref (b)));
+         exp_im = (unsigned long int) (-mpfr_get_exp (mpc_imagref (b)));
+         scale = exp_re / 2 + exp_im / 2 + (exp_re % 2 + exp_im % 2) / 2;
+            /* (exp_re + exp_im) / 2, computed in a way avoiding
+               integer overflow                                  */
+         if (mpfr_zero_p (u)) {
+            /* recompute the scaled value exactly */
+            mpfr_mul_2ui (u, mpc_realref (b), scale, MPFR_RNDN);
+            mpfr_sqr (u, u, MPFR_RNDN);
+         }
+         else /* just scale */
+            mpfr_mul_2ui (u, u, 2*scale, MPFR_RNDN);
+         if (mpfr_zero_p (v)) {
+            mpfr_mul_2ui (v, mpc_imagref (b), scale, MPFR_RNDN);
+            mpfr_sqr (v, v, MPFR_RNDN);
          }
+         else
+            mpfr_mul_2ui (v, v, 2*scale, MPFR_RNDN);
+
+         inexact = mpfr_add (a, u, v, rnd);
+         mpfr_clear_underflow ();
+         inex_underflow = mpfr_div_2ui (a, a, 2*scale, rnd);
+         if (mpfr_underflow_p ())
+            inexact = inex_underflow;
       }
-      else /* no problems, ternary value due to mpfr_can_round trick */
-         inexact = mpfr_set (a, res, rnd);
-
-      /* restore underflow and overflow flags from MPFR */
-      if (saved_underflow)
-        mpfr_set_underflow ();
-      if (saved_overflow)
-        mpfr_set_overflow ();
-
-      mpfr_clear (u);
-      mpfr_clear (v);
-      mpfr_clear (res);
    }
+   else /* no problems, ternary value due to mpfr_can_round trick */
+      inexact = mpfr_set (a, res, rnd);
+
+   /* restore underflow and overflow flags from MPFR */
+   if (saved_underflow)
+     mpfr_set_underflow ();
+   if (saved_overflow)
+     mpfr_set_overflow ();
+
+   mpc_scratch_clear (u);
+   mpc_scratch_clear (v);
+   mpc_scratch_clear (res);
 
    return inexact;
 }
+
+/* sets p to x^2 exactly, with significand in s if x is small; returns 1 if
+   p has been allocated and is to be cleared, 0 otherwise */
+static int
+sqr_exact (mpfr_ptr p, mp_limb_t *s, mpfr_srcptr x)
+{
+   if (mpc_mul_small (p, s, x, x, 0))
+      return 0;
+   mpc_scratch_init2 (p, 2 * mpfr_get_prec (x));
+   mpfr_sqr (p, x, MPFR_RNDN);
+   return 1;
+}
+
+static int
+exp_in_p (mpfr_srcptr x, mpfr_exp_t lo, mpfr_exp_t hi)
+{
+   return mpfr_get_exp (x) >= lo && mpfr_get_exp (x) <= hi;
+}
+
+/* sets a to norm(b) if root is zero, and to abs(b) otherwise, rounded
+   according to rnd, for b finite, and returns the ternary value */
+int
+mpc_sum_sqr (mpfr_ptr a, mpc_srcptr b, int root, mpfr_rnd_t rnd)
+{
+   __mpfr_struct u [2];
+   mp_limb_t s [2 * MPC_SMALL_SIZE];
+   int clear [2];
+   mpfr_t n;
+   mpfr_exp_t emin, emax;
+   mpfr_prec_t prec;
+   int extend, inex;
+
+   if (mpfr_zero_p (mpc_realref (b)))
+      return (root ? mpfr_abs (a, mpc_imagref (b), rnd)
+                   : mpfr_sqr (a, mpc_imagref (b), rnd));
+   else if (mpfr_zero_p (mpc_imagref (b)))
+      return (root ? mpfr_abs (a, mpc_realref (b), rnd)
+                   : mpfr_sqr (a, mpc_realref (b), rnd));
+
+   /* The squares and their sum lie in the current exponent range if the
+      exponents of the parts are at least emin/2+1 and at most emax/2-1. */
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   extend =    !exp_in_p (mpc_realref (b), emin / 2 + 1, emax / 2 - 1)
+            || !exp_in_p (mpc_imagref (b), emin / 2 + 1, emax / 2 - 1);
+   if (extend) {
+      if (emax > mpfr_get_emax_max () / 2 || emin <= mpfr_get_emin_min () / 2)
+         /* the squares may not be representable in any exponent range */
+         return (root ? mpfr_hypot (a, mpc_realref (b), mpc_imagref (b), rnd)
+                      : norm_loop (a, b, rnd));
+      mpfr_set_emin (mpfr_get_emin_min ());
+      mpfr_set_emax (mpfr_get_emax_max ());
+   }
+
+   clear [0] = sqr_exact (u, s, mpc_realref (b));
+   clear [1] = sqr_exact (u + 1, s + MPC_SMALL_SIZE, mpc_imagref (b));
+
+   if (!root) {
+      MPC_STATS_LOOP (NORM, mpfr_get_prec (a));
+      inex = mpfr_add (a, u, u + 1, rnd);
+   }
+   else {
+      /* The exact sum of the squares needs as many bits as there are from
+         the leading bit of the larger square to the last non-zero bit of
+         both; if the exponents differ much, mpfr_hypot is cheaper. */
+      prec = MPC_MAX (mpfr_get_exp (u), mpfr_get_exp (u + 1)) + 1
+             - MPC_MIN (MPC_EXP_ULP (u), MPC_EXP_ULP (u + 1));
+      if (prec <= 2 * MPC_MAX (mpfr_get_prec (a), MPC_MAX_PREC (b))
+                  + 2 * GMP_NUMB_BITS) {
+         mpc_scratch_init2 (n, prec);
+         mpfr_add (n, u, u + 1, MPFR_RNDN); /* exact */
+         inex = mpfr_sqrt (a, n, rnd);
+         mpc_scratch_clear (n);
+      }
+      else
+         inex = mpfr_hypot (a, mpc_realref (b), mpc_imagref (b), rnd);
+   }
+
+   if (clear [0])
+      mpc_scratch_clear (u);
+   if (clear [1])
+      mpc_scratch_clear (u + 1);
+
+   if (extend) {
+      mpfr_set_emin (emin);
+      mpfr_set_emax (emax);
+      inex = mpfr_check_range (a, inex, rnd);
+   }
+
+   return inex;
+}
+
+/* a <- norm(b) = b * conj(b)
+   (the rounding mode is mpfr_rnd_t here since we return an mpfr number) */
+int
+mpc_norm (mpfr_ptr a, mpc_srcptr b, mpfr_rnd_t rnd)
+{
+   MPC_STATS_CALL (NORM);
+
+   /* handling of special values; consistent with abs in that
+      norm = abs^2; so norm (+-inf, xxx) = norm (xxx, +-inf) = +inf */
+   if (!mpc_fin_p (b))
+      return mpc_abs (a, b, rnd);
+   else
+      return mpc_sum_sqr (a, b, 0, rnd);
+}
@@ -483,7 +483,9 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
   mpc_t t, u;
   mpfr_prec_t p, pr, pi, maxprec;
   int saved_underflow, saved_overflow;
-  
+
+  MPC_STATS_CALL (POW);
+
   /* save the underflow or overflow flags from MPFR */
   saved_underflow = mpfr_underflow_p ();
   saved_overflow = mpfr_overflow_p ();
@@ -650,8 +652,6 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
     p = 64;
   mpc_init2 (u, p);
   mpc_init2 (t, p);
-  pr += MPC_RND_RE(rnd) == MPFR_RNDN;
-  pi += MPC_RND_IM(rnd) == MPFR_RNDN;
   maxprec = MPC_MAX_PREC (z);
   x_imag = mpfr_zero_p (mpc_realref(x));
   for (loop = 0;; loop++)
@@ -661,6 +661,7 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
       mpfr_prec_t q=0;
       /* to avoid warning message, real initialisation below */
 
+      MPC_STATS_LOOP (POW, p);
       mpc_log (t, x, MPC_RNDNN);
       mpc_mul (t, t, y, MPC_RNDNN);
 
@@ -702,8 +703,8 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
          (see algorithms.tex) plus one due to the exponent difference: if
          z = a + I*b, where the relative error on z is at most 2^(-p), and
          EXP(a) = EXP(b) + k, the relative error on b is at most 2^(k-p) */
-      if ((z_imag || (p > q + 3 + dr && mpfr_can_round (mpc_realref(u), p - q - 3 - dr, MPFR_RNDN, MPFR_RNDZ, pr))) &&
-          (z_real || (p > q + 3 + di && mpfr_can_round (mpc_imagref(u), p - q - 3 - di, MPFR_RNDN, MPFR_RNDZ, pi))))
+      if ((z_imag || (p > q + 3 + dr && MPC_CAN_ROUND (mpc_realref(u), p - q - 3 - dr, pr, MPC_RND_RE(rnd)))) &&
+          (z_real || (p > q + 3 + di && MPC_CAN_ROUND (mpc_imagref(u), p - q - 3 - di, pi, MPC_RND_IM(rnd)))))
         break;
 
       /* if Re(u) is not known to be zero, assume it is a normal number, i.e.,
@@ -762,7 +763,8 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
       /* copy RE(y) to n since if z==y we will destroy Re(y) below */
       mpfr_set_prec (n, mpfr_get_prec (mpc_realref (y)));
       mpfr_set (n, mpc_realref (y), MPFR_RNDN);
-      ret = mpfr_set (mpc_realref(z), mpc_realref(u), MPC_RND_RE(rnd));
+      ret = mpfr_set (mpc_realref(z), mpc_realref(u),
+                      MPC_RND_FTON (MPC_RND_RE(rnd)));
       if (y_real && (x_real || x_imag))
         {
           /* FIXME: with y_real we assume Im(y) is really 0, which is the case
@@ -784,7 +786,8 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
     }
   else if (z_imag)
     {
-      ret = mpfr_set (mpc_imagref(z), mpc_imagref(u), MPC_RND_IM(rnd));
+      ret = mpfr_set (mpc_imagref(z), mpc_imagref(u),
+                      MPC_RND_FTON (MPC_RND_IM(rnd)));
       /* if z is imaginary and y real, then x cannot be real */
       if (y_real && x_imag)
         {
@@ -803,7 +806,7 @@ mpc_pow (mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
         ret = MPC_INEX(mpfr_set_ui (mpc_realref(z), 0, MPC_RND_RE(rnd)), ret);
     }
   else
-    ret = mpc_set (z, u, rnd);
+    ret = mpc_set (z, u, MPC_RND_FTON_C (rnd));
  exact:
   mpc_clear (t);
   mpc_clear (u);
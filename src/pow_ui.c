@@ -52,6 +52,8 @@ mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
    int has3; /* non-zero if y has '11' in its binary representation */
    int loop, done;
 
+   MPC_STATS_CALL (POW_USI);
+
    /* let mpc_pow deal with special values */
    if (!mpc_fin_p (x) || mpfr_zero_p (mpc_realref (x)) || mpfr_zero_p (mpc_imagref(x))
        || y == 0)
@@ -61,7 +63,7 @@ mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
       if (sign > 0)
          return mpc_set (z, x, rnd);
       else
-         return mpc_ui_div (z, 1ul, x, rnd);
+         return mpc_inv (z, x, rnd);
    }
    else if (y == 2 && sign > 0)
       return mpc_sqr (z, x, rnd);
@@ -91,6 +93,7 @@ mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
    done = 0;
    while (!done) {
       loop++;
+      MPC_STATS_LOOP (POW_USI, p);
 
       mpc_sqr (t, x, MPC_RNDNN);
       if (has3) {
@@ -111,9 +114,10 @@ mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
          }
       }
       if (sign < 0)
-         mpc_ui_div (t, 1ul, t, MPC_RNDNN);
+         mpc_inv (t, t, MPC_RNDNN);
 
       if (mpfr_zero_p (mpc_realref(t)) || mpfr_zero_p (mpc_imagref(t))) {
+         MPC_STATS_FALLBACK (POW_USI);
          inex = mpc_pow_usi_naive (z, x, y, sign, rnd);
             /* since mpfr_get_exp() is not defined for zero */
          done = 1;
@@ -148,6 +152,7 @@ mpc_pow_usi (mpc_ptr z, mpc_srcptr x, unsigned long y, int sign,
          }
          else {
             /* stop the loop and use mpc_pow */
+            MPC_STATS_FALLBACK (POW_USI);
             inex = mpc_pow_usi_naive (z, x, y, sign, rnd);
             done = 1;
          }
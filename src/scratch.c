@@ -0,0 +1,88 @@
+/* mpc_scratch_init2, mpc_scratch_clear, mpc_free_scratch -- Reusable
+   temporary variables
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* Temporary variables released by mpc_scratch_clear are kept, together
+   with their significands, on a stack local to the calling thread, from
+   which mpc_scratch_init2 takes them again. Since mpfr_set_prec only
+   reallocates the significand when it needs to grow, a function using
+   the same precisions over and over does not call the memory allocator
+   any more after its first call. Without thread-local storage, the
+   functions fall back to mpfr_init2 and mpfr_clear. */
+
+#ifdef MPC_THREAD_ATTR
+
+static MPC_THREAD_ATTR mpc_scratch_t mpc_scratch_default;
+
+void
+mpc_scratch_init2 (mpfr_ptr x, mpfr_prec_t prec)
+{
+   __mpc_scratch_struct *s = mpc_scratch_default;
+
+   if (s->size == 0)
+      mpfr_init2 (x, prec);
+   else {
+      x [0] = s->tmp [--s->size];
+      mpfr_set_prec (x, prec);
+   }
+}
+
+void
+mpc_scratch_clear (mpfr_ptr x)
+{
+   __mpc_scratch_struct *s = mpc_scratch_default;
+
+   if (s->size == MPC_SCRATCH_SIZE)
+      mpfr_clear (x);
+   else
+      s->tmp [s->size++] = x [0];
+}
+
+void
+mpc_free_scratch (void)
+{
+   __mpc_scratch_struct *s = mpc_scratch_default;
+
+   while (s->size > 0)
+      mpfr_clear (&(s->tmp [--s->size]));
+}
+
+#else
+
+void
+mpc_scratch_init2 (mpfr_ptr x, mpfr_prec_t prec)
+{
+   mpfr_init2 (x, prec);
+}
+
+void
+mpc_scratch_clear (mpfr_ptr x)
+{
+   mpfr_clear (x);
+}
+
+void
+mpc_free_scratch (void)
+{
+}
+
+#endif
@@ -274,6 +274,8 @@ mpc_sin_cos (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
       rop_cos may be NULL, in which case it is not computed, and the
       corresponding ternary inexact value is set to 0 (exact).       */
 {
+   MPC_STATS_CALL (SIN_COS);
+
    if (!mpc_fin_p (op))
       return mpc_sin_cos_nonfinite (rop_sin, rop_cos, op, rnd_sin, rnd_cos);
    else if (mpfr_zero_p (mpc_imagref (op)))
@@ -317,6 +319,7 @@ mpc_sin_cos (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
       do {
          ok = 1;
          prec += mpc_ceil_log2 (prec) + 5;
+         MPC_STATS_LOOP (SIN_COS, prec);
 
          mpfr_set_prec (s, prec);
          mpfr_set_prec (c, prec);
@@ -332,17 +335,15 @@ mpc_sin_cos (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
             /* real part of sine */
             mpfr_mul (sch, s, ch, MPFR_RNDN);
             ok = (!mpfr_number_p (sch))
-                  || mpfr_can_round (sch, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                        MPC_PREC_RE (rop_sin)
-                        + (MPC_RND_RE (rnd_sin) == MPFR_RNDN));
+                  || MPC_CAN_ROUND (sch, prec - 2, MPC_PREC_RE (rop_sin),
+                        MPC_RND_RE (rnd_sin));
 
             if (ok) {
                /* imaginary part of sine */
                mpfr_mul (csh, c, sh, MPFR_RNDN);
                ok = (!mpfr_number_p (csh))
-                     || mpfr_can_round (csh, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                           MPC_PREC_IM (rop_sin)
-                           + (MPC_RND_IM (rnd_sin) == MPFR_RNDN));
+                     || MPC_CAN_ROUND (csh, prec - 2, MPC_PREC_IM (rop_sin),
+                           MPC_RND_IM (rnd_sin));
             }
          }
 
@@ -350,27 +351,27 @@ mpc_sin_cos (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
             /* real part of cosine */
             mpfr_mul (c, c, ch, MPFR_RNDN);
             ok = (!mpfr_number_p (c))
-                  || mpfr_can_round (c, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                        MPC_PREC_RE (rop_cos)
-                        + (MPC_RND_RE (rnd_cos) == MPFR_RNDN));
+                  || MPC_CAN_ROUND (c, prec - 2, MPC_PREC_RE (rop_cos),
+                        MPC_RND_RE (rnd_cos));
 
             if (ok) {
                /* imaginary part of cosine */
                mpfr_mul (s, s, sh, MPFR_RNDN);
                mpfr_neg (s, s, MPFR_RNDN);
                ok = (!mpfr_number_p (s))
-                     || mpfr_can_round (s, prec - 2, MPFR_RNDN, MPFR_RNDZ,
-                           MPC_PREC_IM (rop_cos)
-                           + (MPC_RND_IM (rnd_cos) == MPFR_RNDN));
+                     || MPC_CAN_ROUND (s, prec - 2, MPC_PREC_IM (rop_cos),
+                           MPC_RND_IM (rnd_cos));
             }
          }
       } while (ok == 0);
 
       if (rop_sin != NULL) {
-         inex_re = mpfr_set (mpc_realref (rop_sin), sch, MPC_RND_RE (rnd_sin));
+         inex_re = mpfr_set (mpc_realref (rop_sin), sch,
+                             MPC_RND_FTON (MPC_RND_RE (rnd_sin)));
          if (mpfr_inf_p (sch))
             inex_re = mpfr_sgn (sch);
-         inex_im = mpfr_set (mpc_imagref (rop_sin), csh, MPC_RND_IM (rnd_sin));
+         inex_im = mpfr_set (mpc_imagref (rop_sin), csh,
+                             MPC_RND_FTON (MPC_RND_IM (rnd_sin)));
          if (mpfr_inf_p (csh))
             inex_im = mpfr_sgn (csh);
          inex_sin = MPC_INEX (inex_re, inex_im);
@@ -379,10 +380,12 @@ mpc_sin_cos (mpc_ptr rop_sin, mpc_ptr rop_cos, mpc_srcptr op,
          inex_sin = MPC_INEX (0,0); /* return exact if not computed */
 
       if (rop_cos != NULL) {
-         inex_re = mpfr_set (mpc_realref (rop_cos), c, MPC_RND_RE (rnd_cos));
+         inex_re = mpfr_set (mpc_realref (rop_cos), c,
+                             MPC_RND_FTON (MPC_RND_RE (rnd_cos)));
          if (mpfr_inf_p (c))
             inex_re = mpfr_sgn (c);
-         inex_im = mpfr_set (mpc_imagref (rop_cos), s, MPC_RND_IM (rnd_cos));
+         inex_im = mpfr_set (mpc_imagref (rop_cos), s,
+                             MPC_RND_FTON (MPC_RND_IM (rnd_cos)));
          if (mpfr_inf_p (s))
             inex_im = mpfr_sgn (s);
          inex_cos = MPC_INEX (inex_re, inex_im);
@@ -0,0 +1,116 @@
+/* small -- Exact products of numbers of one or two limbs
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* The naive algorithms for mpc_mul, mpc_sqr and mpc_fma compute the exact
+   real products and round their sum or difference once per component.
+   When the operands have at most MPC_SMALL_LIMBS limbs, the exact products
+   are obtained here directly from the significands, in limbs provided by
+   the caller on the stack, and turned into MPFR numbers without allocation
+   through the custom interface of MPFR. */
+
+#if defined (__SIZEOF_INT128__) && GMP_NUMB_BITS == 64 && GMP_NAIL_BITS == 0
+#define SMALL_INT128 1
+__extension__ typedef unsigned __int128 small_dlimb_t;
+#endif
+
+#define SMALL_HIGHBIT (((mp_limb_t) 1) << (GMP_NUMB_BITS - 1))
+
+/* If a and b are regular numbers of at most MPC_SMALL_LIMBS limbs each
+   and their product lies in the current exponent range, sets u to a*b,
+   or to -a*b if neg is non-zero, with significand in up, which must have
+   room for 2*MPC_SMALL_LIMBS limbs, and returns 1. Otherwise returns 0.
+   u is not to be cleared nor used once up is out of scope. */
+int
+mpc_mul_small (mpfr_ptr u, mp_limb_t *up, mpfr_srcptr a, mpfr_srcptr b,
+               int neg)
+{
+   mpfr_prec_t pa, pb;
+   mpfr_exp_t ea, eb, e;
+   mp_size_t na, nb, n;
+   mp_limb_t *ap, *bp;
+
+   pa = mpfr_get_prec (a);
+   pb = mpfr_get_prec (b);
+   if (pa > MPC_SMALL_LIMBS * GMP_NUMB_BITS
+       || pb > MPC_SMALL_LIMBS * GMP_NUMB_BITS
+       || !mpfr_regular_p (a) || !mpfr_regular_p (b))
+      return 0;
+
+   /* The exponent of the product is ea+eb or ea+eb-1; since the exponents
+      of MPFR are far from the limits of mpfr_exp_t, their sum does not
+      overflow. */
+   ea = mpfr_get_exp (a);
+   eb = mpfr_get_exp (b);
+   e = ea + eb;
+   if (e > mpfr_get_emax () || e - 1 < mpfr_get_emin ())
+      return 0;
+
+   na = (pa + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+   nb = (pb + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+   n = na + nb;
+   ap = mpfr_custom_get_significand (a);
+   bp = mpfr_custom_get_significand (b);
+
+#ifdef SMALL_INT128
+   if (n == 2) {
+      small_dlimb_t p = (small_dlimb_t) ap [0] * bp [0];
+      up [0] = (mp_limb_t) p;
+      up [1] = (mp_limb_t) (p >> 64);
+   }
+   else
+#endif
+   if (na >= nb)
+      mpn_mul (up, ap, na, bp, nb);
+   else
+      mpn_mul (up, bp, nb, ap, na);
+
+   /* The significands lie in [1/2, 1), so their product in [1/4, 1). */
+   if ((up [n - 1] & SMALL_HIGHBIT) == 0) {
+      mpn_lshift (up, up, n, 1);
+      e--;
+   }
+
+   mpfr_custom_init_set (u,
+      (mpfr_signbit (a) != mpfr_signbit (b)) != (neg != 0) ?
+      -MPFR_REGULAR_KIND : MPFR_REGULAR_KIND,
+      e, (mpfr_prec_t) (n * GMP_NUMB_BITS), up);
+
+   return 1;
+}
+
+/* Sets p to x*y, or to -x*y if neg is non-zero, exactly, with significand
+   in s, which must have room for MPC_SMALL_SIZE limbs, if mpc_mul_small
+   applies, and in a scratch variable otherwise. Returns 1 if p is to be
+   cleared with mpc_scratch_clear, 0 otherwise. The product is computed in
+   the current exponent range. */
+int
+mpc_mul_exact (mpfr_ptr p, mp_limb_t *s, mpfr_srcptr x, mpfr_srcptr y,
+               int neg)
+{
+   if (mpc_mul_small (p, s, x, y, neg))
+      return 0;
+   mpc_scratch_init2 (p, mpfr_get_prec (x) + mpfr_get_prec (y));
+   mpfr_mul (p, x, y, MPFR_RNDZ); /* exact unless out of range */
+   if (neg)
+      mpfr_neg (p, p, MPFR_RNDZ);
+   return 1;
+}
@@ -32,10 +32,16 @@ mpfr_fsss (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr c, mpfr_rnd_t rnd)
 
    int inex;
    mpfr_t u, v;
+   mp_limb_t ul [2 * MPC_SMALL_LIMBS], vl [2 * MPC_SMALL_LIMBS];
+
+   if (mpc_mul_small (u, ul, a, a, 0) && mpc_mul_small (v, vl, c, c, 0))
+      /* The exact squares are in the exponent range, so that a single
+         rounded subtraction yields the correct result. */
+      return mpfr_sub (z, u, v, rnd);
 
    /* u=a^2, v=c^2 exactly */
-   mpfr_init2 (u, 2*mpfr_get_prec (a));
-   mpfr_init2 (v, 2*mpfr_get_prec (c));
+   mpc_scratch_init2 (u, 2*mpfr_get_prec (a));
+   mpc_scratch_init2 (v, 2*mpfr_get_prec (c));
    mpfr_sqr (u, a, MPFR_RNDN);
    mpfr_sqr (v, c, MPFR_RNDN);
 
@@ -152,8 +158,8 @@ mpfr_fsss (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr c, mpfr_rnd_t rnd)
          /* works also when a == c */
    }
 
-   mpfr_clear (u);
-   mpfr_clear (v);
+   mpc_scratch_clear (u);
+   mpc_scratch_clear (v);
 
    return inex;
 }
@@ -164,6 +170,9 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 {
    int ok;
    mpfr_t u, v;
+   mpfr_t us, vs;
+   mp_limb_t ul [2 * MPC_SMALL_LIMBS], vl [2 * MPC_SMALL_LIMBS];
+      /* exact squares of small parts of op, see small.c */
    mpfr_t x;
       /* temporary variable to hold the real part of op,
          needed in the case rop==op */
@@ -172,6 +181,8 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
    mpfr_exp_t emin;
    int saved_underflow;
 
+   MPC_STATS_CALL (SQR);
+
    /* special values: NaN and infinities */
    if (!mpc_fin_p (op)) {
       if (mpfr_nan_p (mpc_realref (op)) || mpfr_nan_p (mpc_imagref (op))) {
@@ -225,9 +236,12 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       return MPC_INEX(inex_re, inex_im);
    }
 
+   if ((inexact = mpc_sqr_dd (rop, op, rnd)) != MPC_DD_FAIL)
+      return inexact;
+
    if (rop == op)
    {
-      mpfr_init2 (x, MPC_PREC_RE (op));
+      mpc_scratch_init2 (x, MPC_PREC_RE (op));
       mpfr_set (x, op->re, MPFR_RNDN);
    }
    else
@@ -235,7 +249,20 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
    /* From here on, use x instead of op->re and safely overwrite rop->re. */
 
    /* Compute real part of result. */
-   if (SAFE_ABS (mpfr_exp_t,
+   if (   MPC_SMALL_C_P (op)
+       && mpc_mul_small (us, ul, x, x, 0)
+       && mpc_mul_small (vs, vl, mpc_imagref (op), mpc_imagref (op), 0))
+      /* For arguments of at most MPC_SMALL_LIMBS limbs, the exact squares
+         are obtained without allocation; when they are in the exponent
+         range, a single rounded subtraction yields the real part. */
+   {
+      inex_re = mpfr_sub (rop->re, us, vs, MPC_RND_RE (rnd));
+      if (mpfr_zero_p (mpc_realref (rop)))
+         /* x^2 = y^2 exactly; as in the Karatsuba loop below, the real
+            part is +0 whatever the rounding mode */
+         mpfr_set_ui (mpc_realref (rop), 0, MPFR_RNDN);
+   }
+   else if (SAFE_ABS (mpfr_exp_t,
                  mpfr_get_exp (mpc_realref (op)) - mpfr_get_exp (mpc_imagref (op)))
        > (mpfr_exp_t) MPC_MAX_PREC (op) / 2) {
       /* If the real and imaginary parts of the argument have very different
@@ -250,14 +277,15 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       /* Karatsuba squaring: we compute the real part as (x+y)*(x-y) and the
          imaginary part as 2*x*y, with a total of 2M instead of 2S+1M for the
          naive algorithm, which computes x^2-y^2 and 2*y*y */
-      mpfr_init (u);
-      mpfr_init (v);
+      mpc_scratch_init2 (u, 2);
+      mpc_scratch_init2 (v, 2);
 
       emin = mpfr_get_emin ();
 
       do
       {
          prec += mpc_ceil_log2 (prec) + 5;
+         MPC_STATS_LOOP (SQR, prec);
 
          mpfr_set_prec (u, prec);
          mpfr_set_prec (v, prec);
@@ -282,6 +310,7 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
             inexact |= mpfr_mul (u, u, v, MPFR_RNDA); /* error 5 */
             if (mpfr_get_exp (u) == emin || mpfr_inf_p (u)) {
                /* under- or overflow */
+               MPC_STATS_FALLBACK (SQR);
                inex_re = mpfr_fsss (rop->re, x, op->im, MPC_RND_RE (rnd));
                ok = 1;
             }
@@ -300,8 +329,8 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       }
       while (!ok);
 
-      mpfr_clear (u);
-      mpfr_clear (v);
+      mpc_scratch_clear (u);
+      mpc_scratch_clear (v);
    }
 
    saved_underflow = mpfr_underflow_p ();
@@ -315,7 +344,7 @@ mpc_sqr (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
       mpfr_set_underflow ();
 
    if (rop == op)
-      mpfr_clear (x);
+      mpc_scratch_clear (x);
 
    return MPC_INEX (inex_re, inex_im);
 }
@@ -49,6 +49,8 @@ mpc_sqrt (mpc_ptr a, mpc_srcptr b, mpc_rnd_t rnd)
   const mpfr_rnd_t r = im_sgn ? MPFR_RNDD : MPFR_RNDU;
      /* rounding mode used when computing t */
 
+  MPC_STATS_CALL (SQRT);
+
   /* special values */
   if (!mpc_fin_p (b)) {
    /* sqrt(x +i*Inf) = +Inf +I*Inf, even if x = NaN */
@@ -206,6 +208,7 @@ mpc_sqrt (mpc_ptr a, mpc_srcptr b, mpc_rnd_t rnd)
     {
       loops ++;
       prec += (loops <= 2) ? mpc_ceil_log2 (prec) + 4 : prec / 2;
+      MPC_STATS_LOOP (SQRT, prec);
       mpfr_set_prec (w, prec);
       mpfr_set_prec (t, prec);
       /* let b = x + iy */
@@ -0,0 +1,102 @@
+/* mpc_stats_get, mpc_stats_reset -- Statistics on Ziv loops
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <string.h>
+#include "mpc-impl.h"
+
+/* When GNU MPC is configured with --enable-stats, the functions with a
+   Ziv loop count their calls, the iterations of the loop, the calls that
+   resort to a slower fallback algorithm (for instance mpc_mul_naive after
+   a failed mpc_mul_gauss) and the maximal working precision, through the
+   macros MPC_STATS_CALL, MPC_STATS_LOOP and MPC_STATS_FALLBACK of
+   mpc-impl.h. The counters are local to the calling thread if thread-local
+   storage is available. Without --enable-stats, the macros expand to
+   nothing and mpc_stats_get always fails. */
+
+/* in the order of the MPC_STATS_ constants */
+static const char *mpc_stats_name [MPC_STATS_NUMBER] = {
+   "acos", "agm", "asin", "atan", "div", "elliptic", "exp", "fma", "inv",
+   "log", "log10", "mul", "norm", "pow", "pow_usi", "sin_cos", "sqr", "sqrt",
+   "tan"
+};
+
+#ifdef MPC_WANT_STATS
+
+#ifndef MPC_THREAD_ATTR
+#define MPC_THREAD_ATTR
+#endif
+
+static MPC_THREAD_ATTR __mpc_stats_struct mpc_stats [MPC_STATS_NUMBER];
+
+void
+mpc_stats_call (int f)
+{
+   mpc_stats [f].calls++;
+}
+
+void
+mpc_stats_loop (int f, mpfr_prec_t prec)
+{
+   mpc_stats [f].loops++;
+   if (prec > mpc_stats [f].max_prec)
+      mpc_stats [f].max_prec = prec;
+}
+
+void
+mpc_stats_fallback (int f)
+{
+   mpc_stats [f].fallbacks++;
+}
+
+#endif
+
+/* Copies into s the counters of the function called name, that is, the
+   name of its mpc_ function without the prefix, for instance "mul", and
+   returns 0. If the function is unknown or GNU MPC has been configured
+   without --enable-stats, sets s to zero and returns -1. */
+int
+mpc_stats_get (mpc_stats_ptr s, const char *name)
+{
+   int f;
+
+   for (f = 0; f < MPC_STATS_NUMBER; f++)
+      if (strcmp (name, mpc_stats_name [f]) == 0) {
+#ifdef MPC_WANT_STATS
+         *s = mpc_stats [f];
+         return 0;
+#else
+         break;
+#endif
+      }
+
+   s->calls = 0;
+   s->loops = 0;
+   s->fallbacks = 0;
+   s->max_prec = 0;
+   return -1;
+}
+
+void
+mpc_stats_reset (void)
+{
+#ifdef MPC_WANT_STATS
+   memset (mpc_stats, 0, sizeof (mpc_stats));
+#endif
+}
@@ -0,0 +1,54 @@
+/* mpc_sum -- Sum of an array of complex numbers.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include "mpc-impl.h"
+
+/* Each part of the sum is computed by mpfr_sum on the corresponding parts
+   of the terms, so that it is rounded only once. */
+
+int
+mpc_sum (mpc_ptr rop, const mpc_ptr *tab, size_t n, mpc_rnd_t rnd)
+{
+   void * (*allocfunc) (size_t);
+   void (*freefunc) (void *, size_t);
+   mpfr_ptr *t;
+   size_t i;
+   int inex_re, inex_im;
+
+   if (n == 0)
+      return mpc_set_ui (rop, 0, MPC_RNDNN);
+
+   mp_get_memory_functions (&allocfunc, NULL, &freefunc);
+   t = (mpfr_ptr *) (*allocfunc) (n * sizeof (mpfr_ptr));
+
+   for (i = 0; i < n; i++)
+      t [i] = mpc_realref (tab [i]);
+   inex_re = mpfr_sum (mpc_realref (rop), t, (unsigned long) n,
+                       MPC_RND_RE (rnd));
+   /* rop may be one of the terms, but the imaginary parts are unchanged */
+   for (i = 0; i < n; i++)
+      t [i] = mpc_imagref (tab [i]);
+   inex_im = mpfr_sum (mpc_imagref (rop), t, (unsigned long) n,
+                       MPC_RND_IM (rnd));
+
+   (*freefunc) (t, n * sizeof (mpfr_ptr));
+
+   return MPC_INEX (inex_re, inex_im);
+}
@@ -31,6 +31,8 @@ mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
   int ok = 0;
   int inex;
 
+  MPC_STATS_CALL (TAN);
+
   /* special values */
   if (!mpc_fin_p (op))
     {
@@ -187,6 +189,7 @@ mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 
       /* FIXME: prevent addition overflow */
       prec += mpc_ceil_log2 (prec) + err;
+      MPC_STATS_LOOP (TAN, prec);
       mpc_set_prec (x, prec);
       mpc_set_prec (y, prec);
 
@@ -261,20 +264,20 @@ mpc_tan (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
 
       /* Can the real part be rounded? */
       ok = (!mpfr_number_p (mpc_realref (x)))
-           || mpfr_can_round (mpc_realref(x), prec - err, MPFR_RNDN, MPFR_RNDZ,
-                      MPC_PREC_RE(rop) + (MPC_RND_RE(rnd) == MPFR_RNDN));
+           || MPC_CAN_ROUND (mpc_realref(x), prec - err, MPC_PREC_RE(rop),
+                             MPC_RND_RE(rnd));
 
       if (ok)
         {
           /* Can the imaginary part be rounded? */
           ok = (!mpfr_number_p (mpc_imagref (x)))
-               || mpfr_can_round (mpc_imagref(x), prec - 6, MPFR_RNDN, MPFR_RNDZ,
-                      MPC_PREC_IM(rop) + (MPC_RND_IM(rnd) == MPFR_RNDN));
+               || MPC_CAN_ROUND (mpc_imagref(x), prec - 6, MPC_PREC_IM(rop),
+                                 MPC_RND_IM(rnd));
         }
     }
   while (ok == 0);
 
-  inex = mpc_set (rop, x, rnd);
+  inex = mpc_set (rop, x, MPC_RND_FTON_C (rnd));
 
  end:
   mpc_clear (x);
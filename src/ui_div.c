@@ -1,6 +1,6 @@
 /* mpc_ui_div -- Divide an unsigned long int by a complex number.
 
-Copyright (C) 2002, 2009 INRIA
+Copyright (C) 2002, 2009, 2012 INRIA
 
 This file is part of GNU MPC.
 
@@ -21,16 +21,22 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <limits.h>
 #include "mpc-impl.h"
 
+/* b is converted exactly into a real number with significand on the stack,
+   so that the quotient is computed by mpc_real_div without allocation */
+#define UI_LIMBS ((sizeof (unsigned long int) * CHAR_BIT - 1) / GMP_NUMB_BITS + 1)
+
 int
 mpc_ui_div (mpc_ptr a, unsigned long int b, mpc_srcptr c, mpc_rnd_t rnd)
 {
-  int inex;
-  mpc_t bb;
+  mpfr_t bb;
+  mp_limb_t s [UI_LIMBS];
+
+  if (b == 1)
+    return mpc_inv (a, c, rnd);
 
-  mpc_init2 (bb, sizeof(unsigned long int) * CHAR_BIT);
-  mpc_set_ui (bb, b, rnd); /* exact */
-  inex = mpc_div (a, bb, c, rnd);
-  mpc_clear (bb);
+  mpfr_custom_init_set (bb, MPFR_ZERO_KIND, 0,
+                        sizeof (unsigned long int) * CHAR_BIT, s);
+  mpfr_set_ui (bb, b, MPFR_RNDN); /* exact */
 
-  return inex;
+  return mpc_real_div (a, bb, c, rnd);
 }
@@ -94,6 +94,8 @@ test_end (void)
       rands_initialized = 0;
       gmp_randclear (rands);
     }
+  mpc_free_scratch ();
+  mpc_free_cache ();
   mpfr_free_cache ();
 }
 
@@ -18,8 +18,76 @@ You should have received a copy of the GNU Lesser General Public License
 along with this program. If not, see http://www.gnu.org/licenses/ .
 */
 
+#include <stdlib.h>
 #include "mpc-tests.h"
 
+/* compares mpc_abs with mpfr_hypot for random operands with parts of close
+   and of very different exponents, for exact results such as |3+4i| = 5,
+   and for an exponent range in which the squares over- or underflow */
+static void
+test_random (void)
+{
+  mpfr_exp_t emin = mpfr_get_emin ();
+  mpfr_exp_t emax = mpfr_get_emax ();
+  mpc_t z;
+  mpfr_t f, g;
+  mpfr_prec_t prec;
+  int i, r, inex, inex_ref;
+
+  mpc_init2 (z, 2);
+  mpfr_init2 (f, 2);
+  mpfr_init2 (g, 2);
+
+  for (prec = 3; prec < 1000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (i = 0; i < 5; i++)
+      {
+        mpc_set_prec (z, prec);
+        mpfr_set_prec (f, prec + 5 * (i % 2));
+        mpfr_set_prec (g, prec + 5 * (i % 2));
+        test_default_random (z, -100, 100, 128, 0);
+        if (i == 1)
+          mpfr_div_2ui (mpc_imagref (z), mpc_imagref (z), 1000, MPFR_RNDN);
+        else if (i == 2)
+          mpc_set_si_si (z, -3, 4, MPC_RNDNN);
+        else if (i >= 3)
+          /* squares of exponent about 2000 or -2000 */
+          mpc_mul_2si (z, z, (i == 3 ? 1000 : -1000), MPC_RNDNN);
+        if (i >= 3)
+          {
+            if (i == 3)
+              mpfr_set_emax (1500);
+            else
+              mpfr_set_emin (-1500);
+          }
+        for (r = 0; r < 4; r++)
+          {
+            inex_ref = mpfr_hypot (g, mpc_realref (z), mpc_imagref (z),
+                                   (mpfr_rnd_t) r);
+            inex = mpc_abs (f, z, (mpfr_rnd_t) r);
+            if (mpfr_cmp (f, g) != 0
+                || (inex > 0) != (inex_ref > 0)
+                || (inex < 0) != (inex_ref < 0))
+              {
+                printf ("Error in mpc_abs for rnd=%s\n",
+                        mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+                MPC_OUT (z);
+                printf ("got      ");
+                mpfr_dump (f);
+                printf ("expected ");
+                mpfr_dump (g);
+                printf ("inex = %d, expected %d\n", inex, inex_ref);
+                exit (1);
+              }
+          }
+        mpfr_set_emin (emin);
+        mpfr_set_emax (emax);
+      }
+
+  mpc_clear (z);
+  mpfr_clear (f);
+  mpfr_clear (g);
+}
+
 int
 main (void)
 {
@@ -29,6 +97,7 @@ main (void)
 
   tgeneric (f, 2, 1024, 1, 0);
   data_check (f, "abs.dat");
+  test_random ();
 
   test_end ();
 
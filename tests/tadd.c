@@ -52,6 +52,57 @@ check_ternary_value (void)
   mpc_clear (z);
 }
 
+static void
+check_vec (void)
+{
+  /* compares mpc_add_vec with element-wise calls to mpc_add */
+#define N 9
+  mpc_t x[N], y[N], z[N], t[N];
+  int i, inex_z, inex_t;
+  known_signs_t ks = {1, 1};
+
+  for (i = 0; i < N; i++)
+    {
+      mpc_init2 (x[i], 53);
+      mpc_init2 (y[i], 53 + i);
+      mpc_init2 (z[i], 20 + 10 * i);
+      mpc_init2 (t[i], 20 + 10 * i);
+      test_default_random (x[i], -64, 64, 128, 25);
+      test_default_random (y[i], -64, 64, 128, 25);
+    }
+  mpfr_set_inf (mpc_imagref (x[2]), +1);
+
+  inex_t = 0;
+  for (i = 0; i < N; i++)
+    inex_t |= mpc_add (t[i], x[i], y[i], MPC_RNDDU);
+  inex_z = mpc_add_vec (z[0], x[0], y[0], N, MPC_RNDDU);
+  for (i = 0; i < N; i++)
+    if (!same_mpc_value (z[i], t[i], ks))
+      {
+        fprintf (stderr, "mpc_add_vec and mpc_add differ at index %d\n", i);
+        MPC_OUT (x[i]);
+        MPC_OUT (y[i]);
+        MPC_OUT (z[i]);
+        MPC_OUT (t[i]);
+        exit (1);
+      }
+  if (inex_z != inex_t)
+    {
+      fprintf (stderr, "mpc_add_vec returned %d instead of %d\n",
+               inex_z, inex_t);
+      exit (1);
+    }
+
+  for (i = 0; i < N; i++)
+    {
+      mpc_clear (x[i]);
+      mpc_clear (y[i]);
+      mpc_clear (z[i]);
+      mpc_clear (t[i]);
+    }
+#undef N
+}
+
 int
 main (void)
 {
@@ -61,6 +112,7 @@ main (void)
   test_start ();
 
   check_ternary_value();
+  check_vec ();
   data_check (f, "add.dat");
   tgeneric (f, 2, 1024, 7, -1);
 
@@ -0,0 +1,170 @@
+/* tagm -- test file for mpc_agm and mpc_agm1.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+static void
+report (const char *what, mpc_srcptr a, mpc_srcptr b, mpc_srcptr got,
+        int inex, mpc_srcptr expected, int inex_ref, mpc_rnd_t rnd)
+{
+  printf ("Error: %s for rnd=(%s,%s)\n", what,
+          mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+          mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+  MPC_OUT (a);
+  MPC_OUT (b);
+  printf ("got      ");
+  MPC_OUT (got);
+  printf ("expected ");
+  MPC_OUT (expected);
+  printf ("inex = %s, expected %s\n", MPC_INEX_STR (inex),
+          MPC_INEX_STR (inex_ref));
+  exit (1);
+}
+
+/* compares, for random operands a and b and all rounding modes,
+   - mpc_agm1 (b) with mpc_agm (1, b), also on the negative real axis with
+     both signs of zero;
+   - mpc_agm (a, b) with mpc_agm (b, a);
+   - mpc_agm (2^k a, 2^k b) with 2^k mpc_agm (a, b);
+   - mpc_agm (conj (a), conj (b)) with conj (mpc_agm (a, b)). */
+static void
+check_identities (void)
+{
+  mpc_t one, a, b, c, d, r1, r2;
+  mpfr_prec_t prec;
+  int i, rnd_re, rnd_im, inex1, inex2;
+  mpc_rnd_t rnd;
+  known_signs_t ks = {1, 1};
+  /* the rounding modes of conj (z) for the ones of z */
+  const mpfr_rnd_t rnd_conj [4] = {MPFR_RNDN, MPFR_RNDZ, MPFR_RNDD,
+                                   MPFR_RNDU};
+
+  mpc_init2 (one, 2);
+  mpc_init2 (a, 2);
+  mpc_init2 (b, 2);
+  mpc_init2 (c, 2);
+  mpc_init2 (d, 2);
+  mpc_init2 (r1, 2);
+  mpc_init2 (r2, 2);
+  mpc_set_ui (one, 1, MPC_RNDNN);
+
+  for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (i = 0; i < 6; i++)
+      {
+        mpc_set_prec (a, prec + 5 * (i % 2));
+        mpc_set_prec (b, prec + 7 * (i % 3));
+        mpc_set_prec (c, MPC_MAX_PREC (a));
+        mpc_set_prec (d, MPC_MAX_PREC (b));
+        mpc_set_prec (r1, prec);
+        mpc_set_prec (r2, prec);
+        do
+          {
+            test_default_random (a, -20, 20, 128, 0);
+            test_default_random (b, -20, 20, 128, 0);
+          }
+        while (mpc_cmp (a, b) == 0);
+        if (i == 2)
+          /* close to the branch cut */
+          mpfr_div_2ui (mpc_imagref (b), mpc_imagref (b), prec + 10,
+                        MPFR_RNDN);
+        else if (i == 3)
+          /* on the branch cut */
+          mpfr_set_ui (mpc_imagref (b), 0, MPFR_RNDN);
+        else if (i == 4)
+          /* on the branch cut, with the other sign of the zero */
+          {
+            mpfr_set_ui (mpc_imagref (b), 0, MPFR_RNDN);
+            mpfr_neg (mpc_imagref (b), mpc_imagref (b), MPFR_RNDN);
+          }
+        if (i >= 3)
+          mpfr_set_si (mpc_realref (b), -1 - (long) prec, MPFR_RNDN);
+
+        for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+          for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+            {
+              rnd = MPC_RND (rnd_re, rnd_im);
+
+              inex1 = mpc_agm (r1, one, b, rnd);
+              inex2 = mpc_agm1 (r2, b, rnd);
+              if (!same_mpc_value (r2, r1, ks) || inex2 != inex1)
+                report ("mpc_agm1 (b) != mpc_agm (1, b)", one, b, r2, inex2,
+                        r1, inex1, rnd);
+
+              if (i >= 2)
+                /* the operands are close to or on the branch cut, where the
+                   other identities need not hold */
+                continue;
+
+              inex1 = mpc_agm (r1, a, b, rnd);
+              inex2 = mpc_agm (r2, b, a, rnd);
+              if (!same_mpc_value (r2, r1, ks) || inex2 != inex1)
+                report ("mpc_agm not symmetric", a, b, r2, inex2, r1, inex1,
+                        rnd);
+
+              mpc_mul_2si (c, a, (long) i - 3, MPC_RNDNN);
+              mpc_mul_2si (d, b, (long) i - 3, MPC_RNDNN);
+              inex2 = mpc_agm (r2, c, d, rnd);
+              mpc_mul_2si (r1, r1, (long) i - 3, MPC_RNDNN);
+              if (!same_mpc_value (r2, r1, ks) || inex2 != inex1)
+                report ("mpc_agm not homogeneous", c, d, r2, inex2, r1,
+                        inex1, rnd);
+
+              mpc_conj (c, a, MPC_RNDNN);
+              mpc_conj (d, b, MPC_RNDNN);
+              inex1 = mpc_agm (r1, a, b, MPC_RND (rnd_re, rnd_conj[rnd_im]));
+              mpc_conj (r1, r1, MPC_RNDNN);
+              inex1 = MPC_INEX (MPC_INEX_RE (inex1), -MPC_INEX_IM (inex1));
+              inex2 = mpc_agm (r2, c, d, rnd);
+              if (!same_mpc_value (r2, r1, ks) || inex2 != inex1)
+                report ("mpc_agm (conj) != conj (mpc_agm)", c, d, r2, inex2,
+                        r1, inex1, rnd);
+            }
+      }
+
+  mpc_clear (one);
+  mpc_clear (a);
+  mpc_clear (b);
+  mpc_clear (c);
+  mpc_clear (d);
+  mpc_clear (r1);
+  mpc_clear (r2);
+}
+
+int
+main (void)
+{
+  DECL_FUNC (C_CC, f, mpc_agm);
+
+  test_start ();
+
+  data_check (f, "agm.dat");
+  tgeneric (f, 2, 512, 7, 128);
+  {
+    DECL_FUNC (CC, f1, mpc_agm1);
+    tgeneric (f1, 2, 512, 7, 128);
+  }
+
+  check_identities ();
+
+  test_end ();
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/* tcache -- test file for mpc_cache_save, mpc_cache_load and
+   mpc_free_cache.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+#define CACHE_FILE "mpc_test_cache"
+
+#ifdef MPC_THREAD_ATTR
+#define LOAD_OK 0
+#else
+#define LOAD_OK (-1)
+#endif
+   /* return value of mpc_cache_load for a valid file */
+
+/* compares mpc_log10 (-1) = i*pi/log(10) at precisions up to max_prec,
+   with the constants of the file loaded before each call, with the value
+   computed from an empty cache */
+static void
+check_log10 (mpfr_prec_t max_prec)
+{
+   mpc_t op, z, ref;
+   mpfr_prec_t prec;
+   int r, inex, inex_ref;
+   known_signs_t ks = {1, 1};
+
+   mpc_init2 (op, 2);
+   mpc_init2 (z, 2);
+   mpc_init2 (ref, 2);
+   mpc_set_si (op, -1, MPC_RNDNN);
+
+   for (prec = 2; prec <= max_prec; prec = (mpfr_prec_t) (prec * 1.5 + 1)) {
+      mpc_set_prec (z, prec);
+      mpc_set_prec (ref, prec);
+      for (r = 0; r < 4; r++) {
+         mpc_free_cache ();
+         inex_ref = mpc_log10 (ref, op, MPC_RND (MPFR_RNDN, r));
+         mpc_free_cache ();
+         if (mpc_cache_load (CACHE_FILE) != LOAD_OK) {
+            printf ("Error: cannot load %s\n", CACHE_FILE);
+            exit (1);
+         }
+         inex = mpc_log10 (z, op, MPC_RND (MPFR_RNDN, r));
+         if (!same_mpc_value (z, ref, ks) || inex != inex_ref) {
+            printf ("Error in mpc_log10 with loaded constants for rnd=%s\n",
+                    mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+            printf ("got      ");
+            MPC_OUT (z);
+            printf ("expected ");
+            MPC_OUT (ref);
+            exit (1);
+         }
+      }
+   }
+
+   mpc_clear (op);
+   mpc_clear (z);
+   mpc_clear (ref);
+}
+
+/* changes the byte at the given offset of the file */
+static void
+corrupt (long offset)
+{
+   FILE *f;
+   int c;
+
+   f = fopen (CACHE_FILE, "r+b");
+   if (f == NULL || fseek (f, offset, SEEK_SET) != 0
+       || (c = getc (f)) == EOF || fseek (f, offset, SEEK_SET) != 0
+       || putc (c ^ 1, f) == EOF || fclose (f) != 0) {
+      printf ("Error: cannot change %s\n", CACHE_FILE);
+      exit (1);
+   }
+}
+
+/* replaces the precision of the first constant, which follows the header
+   of 18 characters and 4 unsigned int, by prec */
+static void
+set_first_prec (long prec)
+{
+   FILE *f;
+
+   f = fopen (CACHE_FILE, "r+b");
+   if (f == NULL
+       || fseek (f, (long) (18 + 4 * sizeof (unsigned int)), SEEK_SET) != 0
+       || fwrite (&prec, sizeof (long), 1, f) != 1 || fclose (f) != 0) {
+      printf ("Error: cannot change %s\n", CACHE_FILE);
+      exit (1);
+   }
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   if (mpc_cache_save (CACHE_FILE, 2000) != 0) {
+      printf ("Error: cannot write %s\n", CACHE_FILE);
+      exit (1);
+   }
+   check_log10 (2000);
+
+   /* a change of the header, of a significand or of the checksum makes the
+      file invalid */
+   corrupt (20);
+   if (mpc_cache_load (CACHE_FILE) != -1) {
+      printf ("Error: mpc_cache_load accepts a wrong header\n");
+      exit (1);
+   }
+   corrupt (20);
+   corrupt (100);
+   if (mpc_cache_load (CACHE_FILE) != -1) {
+      printf ("Error: mpc_cache_load accepts a wrong significand\n");
+      exit (1);
+   }
+   corrupt (100);
+   if (mpc_cache_load (CACHE_FILE) != LOAD_OK) {
+      printf ("Error: mpc_cache_load rejects a valid file\n");
+      exit (1);
+   }
+   /* a precision larger than the rest of the file is rejected before any
+      memory is allocated for the significand */
+   set_first_prec ((long) (MPFR_PREC_MAX / 2));
+   if (mpc_cache_load (CACHE_FILE) != -1) {
+      printf ("Error: mpc_cache_load accepts a wrong precision\n");
+      exit (1);
+   }
+   if (mpc_cache_load ("mpc_test_nonexistent") != -1) {
+      printf ("Error: mpc_cache_load accepts a missing file\n");
+      exit (1);
+   }
+
+   remove (CACHE_FILE);
+   test_end ();
+
+   return 0;
+}
@@ -0,0 +1,266 @@
+/* tdd -- test file for the fast paths in double precision.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+/* mpc_mul, mpc_sqr, mpc_div and mpc_fma use hardware double precision
+   arithmetic when the operands have a precision of at most 53 bits and the
+   result a precision of 53 bits. The results are compared to the ones of
+   the general algorithms, obtained with the same operands stored with a
+   precision of 54 bits. */
+
+#define MUL 0
+#define SQR 1
+#define DIV 2
+#define FMA 3
+
+static const char *names [] = {"mpc_mul", "mpc_sqr", "mpc_div", "mpc_fma"};
+
+static int
+call (int op, mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_srcptr w,
+      mpc_rnd_t rnd)
+{
+   switch (op) {
+   case MUL:
+      return mpc_mul (z, x, y, rnd);
+   case SQR:
+      return mpc_sqr (z, x, rnd);
+   case DIV:
+      return mpc_div (z, x, y, rnd);
+   default:
+      return mpc_fma (z, x, y, w, rnd);
+   }
+}
+
+/* checks op for the operands x, y, w of precision 53 in all rounding
+   modes */
+static void
+check (int op, mpc_srcptr x, mpc_srcptr y, mpc_srcptr w)
+{
+   const mpfr_rnd_t r [] = {MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD};
+   known_signs_t ks = {1, 1};
+   mpc_t x54, y54, w54, z, z54;
+   mpc_rnd_t rnd;
+   int i, j, inex, inex54;
+
+   mpc_init2 (x54, 54);
+   mpc_init2 (y54, 54);
+   mpc_init2 (w54, 54);
+   mpc_init2 (z, 53);
+   mpc_init2 (z54, 53);
+   mpc_set (x54, x, MPC_RNDNN);
+   mpc_set (y54, y, MPC_RNDNN);
+   mpc_set (w54, w, MPC_RNDNN);
+
+   for (i = 0; i < 4; i++)
+      for (j = 0; j < 4; j++) {
+         rnd = MPC_RND (r [i], r [j]);
+         inex = call (op, z, x, y, w, rnd);
+         inex54 = call (op, z54, x54, y54, w54, rnd);
+         if (inex != inex54 || !same_mpc_value (z, z54, ks)) {
+            printf ("Error in %s for rounding mode (%s,%s)\n", names [op],
+                    mpfr_print_rnd_mode (r [i]), mpfr_print_rnd_mode (r [j]));
+            MPC_OUT (x);
+            if (op != SQR)
+               MPC_OUT (y);
+            if (op == FMA)
+               MPC_OUT (w);
+            printf ("got      ");
+            MPC_OUT (z);
+            printf ("expected ");
+            MPC_OUT (z54);
+            printf ("ternary values %i and %i\n", inex, inex54);
+            exit (1);
+         }
+      }
+
+   mpc_clear (x54);
+   mpc_clear (y54);
+   mpc_clear (w54);
+   mpc_clear (z);
+   mpc_clear (z54);
+}
+
+static void
+check_random (void)
+{
+   mpc_t x, y, w;
+   int i, op;
+   mpfr_prec_t prec;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (y, 53);
+   mpc_init2 (w, 53);
+
+   for (i = 0; i < 1000; i++) {
+      /* operands of a smaller precision give exact results more often */
+      prec = (i % 4 == 0 ? 20 : 53);
+      mpc_set_prec (x, prec);
+      mpc_set_prec (y, prec);
+      mpc_set_prec (w, prec);
+      test_default_random (x, -100, 100, 128, 25);
+      test_default_random (y, -100, 100, 128, 25);
+      test_default_random (w, -100, 100, 128, 25);
+      for (op = MUL; op <= FMA; op++)
+         check (op, x, y, w);
+   }
+
+   /* exponents near the limits of the fast paths */
+   mpc_set_prec (x, 53);
+   mpc_set_prec (y, 53);
+   mpc_set_prec (w, 53);
+   for (i = 0; i < 100; i++) {
+      test_default_random (x, -500, 500, 128, 0);
+      test_default_random (y, -500, 500, 128, 0);
+      test_default_random (w, -1000, 1000, 128, 0);
+      for (op = MUL; op <= FMA; op++)
+         check (op, x, y, w);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+}
+
+static void
+check_cancellation (void)
+{
+   /* a*c and b*d resp. a*d and b*c are close */
+   mpc_t x, y, w;
+   int i, k;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (y, 53);
+   mpc_init2 (w, 53);
+
+   for (i = 0; i < 200; i++) {
+      test_default_random (x, -10, 10, 128, 0);
+      k = (int) (gmp_urandomm_ui (rands, 53));
+      mpfr_set (mpc_realref (y), mpc_imagref (x), MPFR_RNDN);
+      mpfr_set (mpc_imagref (y), mpc_realref (x), MPFR_RNDN);
+      mpfr_mul_2si (mpc_realref (w), mpc_imagref (x), -k, MPFR_RNDN);
+      mpfr_add (mpc_imagref (y), mpc_imagref (y), mpc_realref (w), MPFR_RNDN);
+      mpc_conj (w, x, MPC_RNDNN);
+      mpc_neg (w, w, MPC_RNDNN);
+      check (MUL, x, y, w);
+      check (DIV, x, y, w);
+      check (FMA, x, y, w);
+      mpc_set (y, x, MPC_RNDNN);
+      mpfr_mul_2si (mpc_realref (w), mpc_realref (x), -k, MPFR_RNDN);
+      mpfr_add (mpc_imagref (x), mpc_realref (x), mpc_realref (w), MPFR_RNDN);
+      check (SQR, x, y, w);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+}
+
+static void
+check_exact (void)
+{
+   /* exact results and results in the middle of two doubles */
+   mpc_t x, y, w;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (y, 53);
+   mpc_init2 (w, 53);
+
+   mpc_set_si_si (x, 3, -5, MPC_RNDNN);
+   mpc_set_si_si (y, 7, 2, MPC_RNDNN);
+   mpc_set_si_si (w, -1, 4, MPC_RNDNN);
+   check (MUL, x, y, w);
+   check (SQR, x, y, w);
+   check (FMA, x, y, w);
+   mpc_mul (x, x, y, MPC_RNDNN);
+   check (DIV, x, y, w);
+
+   /* (1 + 2^-52)^2 = 1 + 2^-51 + 2^-104 and (1 + 2^-52) * (1 + 2^-53)
+      are not doubles, 1 + 2^-53 is a tie */
+   mpfr_set_ui_2exp (mpc_realref (x), (1ul << 26) + 1, -26, MPFR_RNDN);
+   mpfr_mul (mpc_realref (x), mpc_realref (x), mpc_realref (x), MPFR_RNDN);
+   mpfr_set_ui (mpc_imagref (x), 1, MPFR_RNDN);
+   mpfr_set_ui (mpc_realref (y), 1, MPFR_RNDN);
+   mpfr_set_ui_2exp (mpc_imagref (y), 1, -53, MPFR_RNDN);
+   mpc_set_ui_ui (w, 1, 1, MPC_RNDNN);
+   check (MUL, x, y, w);
+   check (SQR, x, y, w);
+   check (DIV, x, y, w);
+   check (FMA, x, y, w);
+   mpc_swap (x, y);
+   check (MUL, x, y, w);
+   check (SQR, x, y, w);
+   check (DIV, x, y, w);
+   check (FMA, x, y, w);
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+}
+
+static void
+check_spread (void)
+{
+   /* parts of very different exponents, for which the terms of the
+      remainder of the division are far below the quotient */
+   mpc_t x, y, w;
+   int i;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (y, 53);
+   mpc_init2 (w, 53);
+
+   mpc_set_str (x, "(2@-50 1@43)", 16, MPC_RNDNN);
+   mpc_set_str (y, "(1@43 2.0000000004@-50)", 16, MPC_RNDNN);
+   mpc_set_ui (w, 1, MPC_RNDNN);
+   check (DIV, x, y, w);
+   check (DIV, y, x, w);
+
+   for (i = 0; i < 200; i++) {
+      test_default_random (x, -250, 250, 128, 0);
+      test_default_random (y, -10, 10, 128, 0);
+      mpfr_mul_2si (mpc_realref (y), mpc_realref (y), 240, MPFR_RNDN);
+      mpfr_mul_2si (mpc_imagref (y), mpc_imagref (y), -240, MPFR_RNDN);
+      if (i % 2)
+         mpc_swap (x, y);
+      check (DIV, x, y, w);
+      check (DIV, y, x, w);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_exact ();
+   check_cancellation ();
+   check_spread ();
+   check_random ();
+
+   test_end ();
+
+   return 0;
+}
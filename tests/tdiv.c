@@ -21,6 +21,222 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdlib.h>
 #include "mpc-tests.h"
 
+static void
+check_precomp (void)
+{
+  /* compares mpc_div_precomp with mpc_div, for random fixed divisors
+     including special values, parts of very different exponents and exact
+     quotients, and for all rounding modes; the same precomputed data is
+     used for increasing precisions of the results */
+  mpc_t x, y, z, t;
+  mpc_div_precomp_t pc;
+  mpfr_prec_t prec, p;
+  int i, j, k, inex_z, inex_t;
+  mpc_rnd_t rnd;
+  known_signs_t ks = {1, 1};
+
+  mpc_init2 (x, 2);
+  mpc_init2 (y, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (t, 2);
+
+  for (prec = 2; prec < 2000; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+    for (i = 0; i < 7; i++)
+      {
+        mpc_set_prec (y, prec);
+        test_default_random (y, -1024, 1024, 128, 10);
+        if (i == 1)
+          mpfr_set_inf (mpc_imagref (y), 1);
+        else if (i == 2)
+          mpfr_mul_2ui (mpc_realref (y), mpc_imagref (y), prec, MPFR_RNDN);
+        else if (i == 3)
+          mpc_set_si_si (y, -3, 4, MPC_RNDNN);
+        else if (i == 4)
+          mpc_set_ui (y, 0, MPC_RNDNN);
+        else if (i == 5)
+          mpc_set_ui_ui (y, 1, 1, MPC_RNDNN);
+        mpc_div_precomp_init (pc, y, (i == 6 ? prec / 2 + 2 : prec));
+
+        for (j = 0; j < 4; j++)
+          {
+            /* the precision of the results need not match the one given
+               to mpc_div_precomp_init */
+            p = prec + 10 * j;
+            mpc_set_prec (x, p);
+            test_default_random (x, -1024, 1024, 128, 10);
+            if (j == 1)
+              /* exact quotient for y = -3+4i or y = 1+i */
+              mpc_set_si_si (x, 7, -1, MPC_RNDNN);
+            mpc_set_prec (z, p);
+            mpc_set_prec (t, p);
+            for (k = 0; k < 16; k++)
+              {
+                rnd = MPC_RND (k % 4, k / 4);
+                inex_t = mpc_div (t, x, y, rnd);
+                inex_z = mpc_div_precomp (z, x, pc, rnd);
+                if (!same_mpc_value (z, t, ks) || inex_z != inex_t)
+                  {
+                    fprintf (stderr, "mpc_div_precomp and mpc_div differ"
+                             " for rnd=(%s,%s)\n",
+                             mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                             mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                    MPC_OUT (x);
+                    MPC_OUT (y);
+                    MPC_OUT (z);
+                    MPC_OUT (t);
+                    fprintf (stderr, "inex_z=%d inex_t=%d\n", inex_z,
+                             inex_t);
+                    exit (1);
+                  }
+              }
+            /* in-place computation */
+            mpc_div (t, x, y, MPC_RNDZU);
+            mpc_div_precomp (x, x, pc, MPC_RNDZU);
+            if (!same_mpc_value (x, t, ks))
+              {
+                fprintf (stderr, "mpc_div_precomp with overlap and mpc_div"
+                         " differ\n");
+                MPC_OUT (x);
+                MPC_OUT (y);
+                MPC_OUT (t);
+                exit (1);
+              }
+          }
+        mpc_div_precomp_clear (pc);
+      }
+
+  mpc_clear (x);
+  mpc_clear (y);
+  mpc_clear (z);
+  mpc_clear (t);
+}
+
+static void
+check_single (void)
+{
+  /* compares mpc_div, which rounds each part of the quotient once below
+     the multiplication thresholds, with the loop used above them, for
+     parts of very different exponents, nearly cancelling numerators and
+     exact quotients, and with the correctly rounded quotient for an
+     overflow or an underflow, for all rounding modes */
+  mpc_t x, y, z, t;
+  mpfr_prec_t prec, karatsuba, gauss;
+  int i, k, inex_z, inex_t;
+  mpc_rnd_t rnd;
+  mpfr_exp_t emin = mpfr_get_emin ();
+  mpfr_exp_t emax = mpfr_get_emax ();
+  known_signs_t ks = {1, 1};
+
+  mpc_get_mul_threshold (&karatsuba, &gauss);
+  mpc_init2 (x, 2);
+  mpc_init2 (y, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (t, 2);
+
+  for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+    for (i = 0; i < 7; i++)
+      {
+        mpc_set_prec (x, prec);
+        mpc_set_prec (y, prec + 7 * (i == 0));
+        mpc_set_prec (z, prec);
+        mpc_set_prec (t, prec);
+        test_default_random (x, -50, 50, 128, 0);
+        test_default_random (y, -50, 50, 128, 0);
+        if (i == 1)
+          {
+            /* parts of very different exponents */
+            mpfr_div_2ui (mpc_imagref (x), mpc_imagref (x), 300, MPFR_RNDN);
+            mpfr_mul_2ui (mpc_imagref (y), mpc_imagref (y), 300, MPFR_RNDN);
+          }
+        else if (i == 2 || i == 3)
+          {
+            /* x*conj(y) with a nearly cancelling, respectively a zero,
+               real part */
+            mpc_mul_i (x, y, 1, MPC_RNDNN);
+            if (i == 2)
+              mpfr_nextabove (mpc_realref (x));
+          }
+        else if (i == 4)
+          {
+            /* exact quotient (7-i)/(-3+4i) = -1-i */
+            mpc_set_si_si (x, 7, -1, MPC_RNDNN);
+            mpc_set_si_si (y, -3, 4, MPC_RNDNN);
+          }
+        else if (i == 5)
+          {
+            /* quotient of large magnitude, which overflows for emax=2500
+               while the operands do not */
+            mpc_mul_2ui (x, x, 1100, MPC_RNDNN);
+            mpc_div_2ui (y, y, 1500, MPC_RNDNN);
+          }
+        else if (i == 6)
+          {
+            /* quotient of small magnitude, which underflows for
+               emin=-10000 while the operands do not */
+            mpc_div_2ui (x, x, 3000, MPC_RNDNN);
+            mpc_mul_2ui (y, y, 7100, MPC_RNDNN);
+          }
+        for (k = 0; k < 16; k++)
+          {
+            rnd = MPC_RND (k % 4, k / 4);
+            if (i >= 5)
+              {
+                /* the quotient in the large exponent range, moved into
+                   the small one */
+                inex_t = mpc_div (t, x, y, rnd);
+                if (i == 5)
+                  mpfr_set_emax (2500);
+                else
+                  mpfr_set_emin (-10000);
+                inex_t = MPC_INEX (
+                  mpfr_check_range (mpc_realref (t), MPC_INEX_RE (inex_t),
+                                    MPC_RND_RE (rnd)),
+                  mpfr_check_range (mpc_imagref (t), MPC_INEX_IM (inex_t),
+                                    MPC_RND_IM (rnd)));
+                inex_z = mpc_div (z, x, y, rnd);
+                mpfr_set_emax (emax);
+                mpfr_set_emin (emin);
+              }
+            else
+              {
+                inex_z = mpc_div (z, x, y, rnd);
+                mpc_set_mul_threshold (2, 2);
+                inex_t = mpc_div (t, x, y, rnd);
+                mpc_set_mul_threshold (karatsuba, gauss);
+              }
+            if (!same_mpc_value (z, t, ks) || inex_z != inex_t)
+              {
+                fprintf (stderr, "mpc_div differs from the reference"
+                         " for rnd=(%s,%s)\n",
+                         mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                         mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                MPC_OUT (x);
+                MPC_OUT (y);
+                MPC_OUT (z);
+                MPC_OUT (t);
+                fprintf (stderr, "inex_z=%d inex_t=%d\n", inex_z, inex_t);
+                exit (1);
+              }
+          }
+        /* in-place computation */
+        mpc_div (t, x, y, MPC_RNDDU);
+        mpc_div (x, x, y, MPC_RNDDU);
+        if (!same_mpc_value (x, t, ks))
+          {
+            fprintf (stderr, "mpc_div with overlap differs\n");
+            MPC_OUT (x);
+            MPC_OUT (y);
+            MPC_OUT (t);
+            exit (1);
+          }
+      }
+
+  mpc_clear (x);
+  mpc_clear (y);
+  mpc_clear (z);
+  mpc_clear (t);
+}
+
 int
 main (void)
 {
@@ -28,6 +244,9 @@ main (void)
 
   test_start ();
 
+  check_single ();
+  check_precomp ();
+
   data_check (f, "div.dat");
   tgeneric (f, 2, 1024, 7, 4096);
 
@@ -0,0 +1,170 @@
+/* tdot -- test file for mpc_dot.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+#define N 13
+#define EXACT_PREC 3000
+   /* large enough for the exact sum of N products of operands of precision
+      at most 500 and exponents between -50 and 50 */
+
+/* compares mpc_dot (z, x, y, n, rnd) with the exact sum rounded once */
+static void
+check_dot (mpc_ptr z, mpc_ptr *x, mpc_ptr *y, size_t n, mpc_rnd_t rnd)
+{
+   mpc_t s, p, ref;
+   size_t i;
+   int inex, inex_ref;
+   /* the sign of an exact zero is not specified */
+   known_signs_t ks = {0, 0};
+
+   mpc_init2 (s, EXACT_PREC);
+   mpc_init2 (p, EXACT_PREC);
+   mpc_init2 (ref, MPC_MAX_PREC (z));
+   mpc_set_ui (s, 0, MPC_RNDNN);
+   for (i = 0; i < n; i++)
+      if (mpc_mul (p, x [i], y [i], MPC_RNDNN) != 0
+          || mpc_add (s, s, p, MPC_RNDNN) != 0) {
+         printf ("Error in check_dot: inexact reference sum\n");
+         exit (1);
+      }
+   inex_ref = mpc_set (ref, s, rnd);
+
+   inex = mpc_dot (z, x, y, n, rnd);
+   if (!same_mpc_value (z, ref, ks) || inex != inex_ref) {
+      printf ("Error in mpc_dot for n=%lu and rnd=(%s,%s)\n",
+              (unsigned long) n,
+              mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+              mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+      for (i = 0; i < n; i++) {
+         MPC_OUT (x [i]);
+         MPC_OUT (y [i]);
+      }
+      printf ("got      ");
+      MPC_OUT (z);
+      printf ("expected ");
+      MPC_OUT (ref);
+      printf ("inex = %s, expected %s\n", MPC_INEX_STR (inex),
+              MPC_INEX_STR (inex_ref));
+      exit (1);
+   }
+
+   mpc_clear (s);
+   mpc_clear (p);
+   mpc_clear (ref);
+}
+
+static void
+check_random (void)
+{
+   mpc_t a [N], b [N], z;
+   mpc_ptr x [N], y [N];
+   mpfr_prec_t prec;
+   size_t n;
+   int i, rnd_re, rnd_im;
+
+   for (i = 0; i < N; i++) {
+      mpc_init2 (a [i], 2);
+      mpc_init2 (b [i], 2);
+      x [i] = a [i];
+      y [i] = b [i];
+   }
+   mpc_init2 (z, 2);
+
+   for (prec = 2; prec < 500; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+      for (n = 0; n <= N; n += 3) {
+         for (i = 0; i < (int) n; i++) {
+            /* different precisions of the operands, so that both the small
+               and the large products are used */
+            mpc_set_prec (a [i], prec);
+            mpc_set_prec (b [i], prec + 37 * (i % 2));
+            test_default_random (a [i], -50, 50, 128, 0);
+            test_default_random (b [i], -50, 50, 128, 0);
+         }
+         /* cancellation of the leading products */
+         if (n >= 3) {
+            mpc_set (a [1], a [0], MPC_RNDNN);
+            mpc_neg (b [1], b [0], MPC_RNDNN);
+         }
+         mpc_set_prec (z, prec);
+         for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+            for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+               check_dot (z, x, y, n, MPC_RND (rnd_re, rnd_im));
+      }
+
+   for (i = 0; i < N; i++) {
+      mpc_clear (a [i]);
+      mpc_clear (b [i]);
+   }
+   mpc_clear (z);
+}
+
+static void
+check_overlap (void)
+{
+   /* the result may be one of the operands */
+   mpc_t a [2], b [2], z;
+   mpc_ptr x [2], y [2];
+   int i;
+
+   for (i = 0; i < 2; i++) {
+      mpc_init2 (a [i], 53);
+      mpc_init2 (b [i], 53);
+      x [i] = a [i];
+      y [i] = b [i];
+   }
+   mpc_init2 (z, 53);
+
+   /* (1+2i)*(3-i) + (-5+i)*(1+i) = 5+5i - 6-4i = -1+i */
+   mpc_set_ui_ui (a [0], 1, 2, MPC_RNDNN);
+   mpc_set_si_si (b [0], 3, -1, MPC_RNDNN);
+   mpc_set_si_si (a [1], -5, 1, MPC_RNDNN);
+   mpc_set_ui_ui (b [1], 1, 1, MPC_RNDNN);
+   mpc_dot (z, x, y, 2, MPC_RNDNN);
+   mpc_dot (b [0], x, y, 2, MPC_RNDNN);
+   if (mpc_cmp (z, b [0]) != 0 || mpc_cmp_si_si (z, -1, 1) != 0) {
+      printf ("Error in mpc_dot with the result as operand\n");
+      printf ("got      ");
+      MPC_OUT (b [0]);
+      printf ("expected ");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   for (i = 0; i < 2; i++) {
+      mpc_clear (a [i]);
+      mpc_clear (b [i]);
+   }
+   mpc_clear (z);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_overlap ();
+   check_random ();
+
+   test_end ();
+
+   return 0;
+}
@@ -0,0 +1,280 @@
+/* telliptic -- test file for mpc_elliptic_k and mpc_elliptic_e.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+typedef int (*elliptic_t) (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+
+/* checks that f (m, rnd) is x + i*0 with x = X correctly rounded, where
+   X is approximated by ref with an error of at most one ulp */
+static void
+check_real (const char *name, elliptic_t f, mpc_srcptr m, mpfr_srcptr ref)
+{
+  mpc_t z;
+  mpfr_t x;
+  mpfr_prec_t prec;
+  int rnd_re, rnd_im, inex, inex_x;
+
+  mpc_init2 (z, 2);
+  mpfr_init2 (x, 2);
+  for (prec = 2; prec + 20 < mpfr_get_prec (ref); prec += 13)
+    for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+      for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+        {
+          if (!mpfr_can_round (ref, mpfr_get_prec (ref) - 1, MPFR_RNDN,
+                               MPFR_RNDZ,
+                               prec + ((mpfr_rnd_t) rnd_re == MPFR_RNDN)))
+            continue;
+          mpc_set_prec (z, prec);
+          mpfr_set_prec (x, prec);
+          inex_x = mpfr_set (x, ref, (mpfr_rnd_t) rnd_re);
+          inex = f (z, m, MPC_RND (rnd_re, rnd_im));
+          if (   mpfr_cmp (mpc_realref (z), x) != 0
+              || !mpfr_zero_p (mpc_imagref (z))
+              || mpfr_signbit (mpc_imagref (z))
+                 != mpfr_signbit (mpc_imagref (m))
+              || MPC_INEX_IM (inex) != 0
+              || (MPC_INEX_RE (inex) > 0) != (inex_x > 0)
+              || (MPC_INEX_RE (inex) < 0) != (inex_x < 0))
+            {
+              printf ("Error in %s for rnd=(%s,%s)\n", name,
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) rnd_re),
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) rnd_im));
+              MPC_OUT (m);
+              printf ("got      ");
+              MPC_OUT (z);
+              printf ("expected ");
+              MPFR_OUT (x);
+              printf ("inex = %s, expected %d\n", MPC_INEX_STR (inex),
+                      inex_x);
+              exit (1);
+            }
+        }
+  mpc_clear (z);
+  mpfr_clear (x);
+}
+
+/* checks K (0) = E (0) = pi/2, K (1/2) = Gamma (1/4)^2 / (4 sqrt (pi)) and
+   E (1/2) = (pi/2 + K (1/2)^2) / (2 K (1/2)) by the Legendre relation */
+static void
+check_values (void)
+{
+  mpc_t m;
+  mpfr_t pi, k, e, t;
+  mpfr_prec_t p = 600;
+
+  mpc_init2 (m, 2);
+  mpfr_init2 (pi, p);
+  mpfr_init2 (k, p);
+  mpfr_init2 (e, p);
+  mpfr_init2 (t, p);
+
+  mpfr_const_pi (pi, MPFR_RNDN);
+  mpfr_div_2ui (t, pi, 1, MPFR_RNDN);
+  mpc_set_ui (m, 0, MPC_RNDNN);
+  check_real ("mpc_elliptic_k", mpc_elliptic_k, m, t);
+  check_real ("mpc_elliptic_e", mpc_elliptic_e, m, t);
+  mpc_conj (m, m, MPC_RNDNN);
+  check_real ("mpc_elliptic_k", mpc_elliptic_k, m, t);
+  check_real ("mpc_elliptic_e", mpc_elliptic_e, m, t);
+
+  mpfr_set_ui (k, 1, MPFR_RNDN);
+  mpfr_div_2ui (k, k, 2, MPFR_RNDN);
+  mpfr_gamma (k, k, MPFR_RNDN);
+  mpfr_sqr (k, k, MPFR_RNDN);
+  mpfr_sqrt (t, pi, MPFR_RNDN);
+  mpfr_div (k, k, t, MPFR_RNDN);
+  mpfr_div_2ui (k, k, 2, MPFR_RNDN);
+  mpfr_sqr (e, k, MPFR_RNDN);
+  mpfr_div_2ui (t, pi, 1, MPFR_RNDN);
+  mpfr_add (e, e, t, MPFR_RNDN);
+  mpfr_div (e, e, k, MPFR_RNDN);
+  mpfr_div_2ui (e, e, 1, MPFR_RNDN);
+  /* k and e have an error of a few ulps, which check_real covers by
+     rounding at a lower precision */
+  mpfr_prec_round (k, p - 8, MPFR_RNDN);
+  mpfr_prec_round (e, p - 8, MPFR_RNDN);
+  mpc_set_ui (m, 1, MPC_RNDNN);
+  mpc_div_2ui (m, m, 1, MPC_RNDNN);
+  check_real ("mpc_elliptic_k", mpc_elliptic_k, m, k);
+  check_real ("mpc_elliptic_e", mpc_elliptic_e, m, e);
+
+  mpc_clear (m);
+  mpfr_clear (pi);
+  mpfr_clear (k);
+  mpfr_clear (e);
+  mpfr_clear (t);
+}
+
+/* checks K (conj (m)) = conj (K (m)) and the same for E with all rounding
+   modes, and the Legendre relation
+   E (m) K (1-m) + E (1-m) K (m) - K (m) K (1-m) = pi/2
+   up to a relative error of 2^(10-prec), for random m off the real axis */
+static void
+check_random (void)
+{
+  mpc_t m, m1, c, k, e, k1, e1, t, u;
+  mpfr_t pi, d;
+  mpfr_prec_t prec;
+  int i, rnd_re, rnd_im, second, inex1, inex2;
+  mpc_rnd_t rnd;
+  elliptic_t f;
+  known_signs_t ks = {1, 1};
+  const mpfr_rnd_t rnd_conj [4] = {MPFR_RNDN, MPFR_RNDZ, MPFR_RNDD,
+                                   MPFR_RNDU};
+
+  mpc_init2 (m, 2);
+  mpc_init2 (m1, 2);
+  mpc_init2 (c, 2);
+  mpc_init2 (k, 2);
+  mpc_init2 (e, 2);
+  mpc_init2 (k1, 2);
+  mpc_init2 (e1, 2);
+  mpc_init2 (t, 2);
+  mpc_init2 (u, 2);
+  mpfr_init2 (pi, 2);
+  mpfr_init2 (d, 2);
+
+  for (prec = 2; prec < 800; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (i = 0; i < 4; i++)
+      {
+        mpc_set_prec (m, prec + 5 * (i % 2));
+        mpc_set_prec (c, MPC_MAX_PREC (m));
+        do
+          test_default_random (m, -10, 10, 128, 0);
+        while (   mpfr_zero_p (mpc_realref (m))
+               || mpfr_zero_p (mpc_imagref (m)));
+        if (i == 2)
+          /* close to the branch cut [1, +inf[ */
+          {
+            mpfr_add_ui (mpc_realref (m), mpc_realref (m), 2, MPFR_RNDN);
+            mpfr_abs (mpc_realref (m), mpc_realref (m), MPFR_RNDN);
+            mpfr_div_2ui (mpc_imagref (m), mpc_imagref (m), prec / 2,
+                          MPFR_RNDN);
+          }
+        mpc_conj (c, m, MPC_RNDNN);
+
+        for (second = 0; second < 2; second++)
+          {
+            f = (second ? mpc_elliptic_e : mpc_elliptic_k);
+            mpc_set_prec (t, prec);
+            mpc_set_prec (u, prec);
+            for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+              for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+                {
+                  rnd = MPC_RND (rnd_re, rnd_im);
+                  inex1 = f (t, m, MPC_RND (rnd_re, rnd_conj[rnd_im]));
+                  mpc_conj (t, t, MPC_RNDNN);
+                  inex1 = MPC_INEX (MPC_INEX_RE (inex1),
+                                    -MPC_INEX_IM (inex1));
+                  inex2 = f (u, c, rnd);
+                  if (!same_mpc_value (u, t, ks) || inex2 != inex1)
+                    {
+                      printf ("Error: %s (conj (m)) != conj (%s (m)) for "
+                              "rnd=(%s,%s)\n",
+                              second ? "E" : "K", second ? "E" : "K",
+                              mpfr_print_rnd_mode ((mpfr_rnd_t) rnd_re),
+                              mpfr_print_rnd_mode ((mpfr_rnd_t) rnd_im));
+                      MPC_OUT (m);
+                      printf ("got      ");
+                      MPC_OUT (u);
+                      printf ("expected ");
+                      MPC_OUT (t);
+                      printf ("inex = %s, expected %s\n",
+                              MPC_INEX_STR (inex2), MPC_INEX_STR (inex1));
+                      exit (1);
+                    }
+                }
+          }
+
+        /* the Legendre relation, computed with prec+20 bits */
+        mpc_set_prec (m1, MPC_MAX_PREC (m) + 20);
+        mpc_ui_sub (m1, 1, m, MPC_RNDNN);
+        mpc_set_prec (k, prec + 20);
+        mpc_set_prec (e, prec + 20);
+        mpc_set_prec (k1, prec + 20);
+        mpc_set_prec (e1, prec + 20);
+        mpc_set_prec (t, prec + 20);
+        mpc_set_prec (u, prec + 20);
+        mpfr_set_prec (pi, prec + 20);
+        mpfr_set_prec (d, prec + 20);
+        mpc_elliptic_k (k, m, MPC_RNDNN);
+        mpc_elliptic_e (e, m, MPC_RNDNN);
+        mpc_elliptic_k (k1, m1, MPC_RNDNN);
+        mpc_elliptic_e (e1, m1, MPC_RNDNN);
+        mpc_mul (t, e, k1, MPC_RNDNN);
+        mpc_mul (u, e1, k, MPC_RNDNN);
+        mpc_add (t, t, u, MPC_RNDNN);
+        mpc_mul (u, k, k1, MPC_RNDNN);
+        mpc_sub (t, t, u, MPC_RNDNN);
+        mpfr_const_pi (pi, MPFR_RNDN);
+        mpfr_div_2ui (pi, pi, 1, MPFR_RNDN);
+        mpc_sub_fr (t, t, pi, MPC_RNDNN);
+        /* the terms of the sum may be larger than pi/2 */
+        mpc_abs (d, u, MPFR_RNDU);
+        if (mpfr_cmp (d, pi) < 0)
+          mpfr_set (d, pi, MPFR_RNDN);
+        mpfr_div_2ui (d, d, prec + 10, MPFR_RNDN);
+        mpc_abs (pi, t, MPFR_RNDU);
+        if (mpfr_cmp (pi, d) > 0)
+          {
+            printf ("Error: Legendre relation for precision %lu\n",
+                    (unsigned long) prec);
+            MPC_OUT (m);
+            printf ("difference ");
+            MPFR_OUT (pi);
+            exit (1);
+          }
+      }
+
+  mpc_clear (m);
+  mpc_clear (m1);
+  mpc_clear (c);
+  mpc_clear (k);
+  mpc_clear (e);
+  mpc_clear (k1);
+  mpc_clear (e1);
+  mpc_clear (t);
+  mpc_clear (u);
+  mpfr_clear (pi);
+  mpfr_clear (d);
+}
+
+int
+main (void)
+{
+  DECL_FUNC (CC, f, mpc_elliptic_k);
+
+  test_start ();
+
+  tgeneric (f, 2, 512, 7, 10);
+  {
+    DECL_FUNC (CC, g, mpc_elliptic_e);
+    tgeneric (g, 2, 512, 7, 10);
+  }
+
+  check_values ();
+  check_random ();
+
+  test_end ();
+
+  return 0;
+}
@@ -0,0 +1,232 @@
+/* tfaithful -- test file for faithful rounding.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+#ifdef MPC_RNDFF
+
+/* A part rounded faithfully has to be the rounding of the exact value
+   either downwards or upwards; a part rounded correctly in the same call
+   has to be the same as with the corresponding complex rounding mode. */
+
+typedef int (*unary_t) (mpc_ptr, mpc_srcptr, mpc_rnd_t);
+typedef int (*binary_t) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+
+static int
+sin_wrapper (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   return mpc_sin (rop, op, rnd);
+}
+
+static int
+cos_wrapper (mpc_ptr rop, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   return mpc_cos (rop, op, rnd);
+}
+
+static const struct {
+   const char *name;
+   unary_t f;
+} unary [] = {
+   {"mpc_exp", mpc_exp}, {"mpc_log", mpc_log}, {"mpc_log10", mpc_log10},
+   {"mpc_sin", sin_wrapper}, {"mpc_cos", cos_wrapper}, {"mpc_tan", mpc_tan},
+   {"mpc_asin", mpc_asin}, {"mpc_acos", mpc_acos}, {"mpc_atan", mpc_atan},
+   {"mpc_sqr", mpc_sqr}, {"mpc_sqrt", mpc_sqrt}
+};
+
+static const struct {
+   const char *name;
+   binary_t f;
+} binary [] = {
+   {"mpc_div", mpc_div}, {"mpc_mul", mpc_mul}, {"mpc_pow", mpc_pow}
+};
+
+/* returns 1 if x is the rounding of some value downwards, to the value d,
+   or upwards, to the value u */
+static int
+faithful_p (mpfr_ptr x, mpfr_ptr d, mpfr_ptr u)
+{
+   return same_mpfr_value (x, d, 1) || same_mpfr_value (x, u, 1);
+}
+
+static void
+error (const char *name, const char *rnd, mpc_srcptr x, mpc_srcptr y,
+       mpc_srcptr z, mpc_srcptr d, mpc_srcptr u)
+{
+   printf ("Error in %s for rounding mode %s\n", name, rnd);
+   MPC_OUT (x);
+   if (y != NULL)
+      MPC_OUT (y);
+   printf ("got      ");
+   MPC_OUT (z);
+   printf ("expected ");
+   MPC_OUT (d);
+   printf ("or       ");
+   MPC_OUT (u);
+   exit (1);
+}
+
+/* checks the i-th unary function in x for the rounding modes MPC_RNDFF,
+   MPC_RNDFN and MPC_RNDNF against its correct roundings */
+static void
+check_unary (int i, mpc_srcptr x, mpfr_prec_t prec)
+{
+   mpc_t z, d, u, n;
+   int inex, inex_n;
+
+   mpc_init2 (z, prec);
+   mpc_init2 (d, prec);
+   mpc_init2 (u, prec);
+   mpc_init2 (n, prec);
+
+   unary [i].f (d, x, MPC_RNDDD);
+   unary [i].f (u, x, MPC_RNDUU);
+   inex_n = unary [i].f (n, x, MPC_RNDNN);
+
+   unary [i].f (z, x, MPC_RNDFF);
+   if (!faithful_p (mpc_realref (z), mpc_realref (d), mpc_realref (u))
+       || !faithful_p (mpc_imagref (z), mpc_imagref (d), mpc_imagref (u)))
+      error (unary [i].name, "MPC_RNDFF", x, NULL, z, d, u);
+
+   inex = unary [i].f (z, x, MPC_RNDFN);
+   if (!faithful_p (mpc_realref (z), mpc_realref (d), mpc_realref (u))
+       || !same_mpfr_value (mpc_imagref (z), mpc_imagref (n), 1)
+       || MPC_INEX_IM (inex) != MPC_INEX_IM (inex_n))
+      error (unary [i].name, "MPC_RNDFN", x, NULL, z, d, u);
+
+   inex = unary [i].f (z, x, MPC_RNDNF);
+   if (!same_mpfr_value (mpc_realref (z), mpc_realref (n), 1)
+       || MPC_INEX_RE (inex) != MPC_INEX_RE (inex_n)
+       || !faithful_p (mpc_imagref (z), mpc_imagref (d), mpc_imagref (u)))
+      error (unary [i].name, "MPC_RNDNF", x, NULL, z, d, u);
+
+   mpc_clear (z);
+   mpc_clear (d);
+   mpc_clear (u);
+   mpc_clear (n);
+}
+
+/* checks the i-th binary function in x and y for MPC_RNDFF */
+static void
+check_binary (int i, mpc_srcptr x, mpc_srcptr y, mpfr_prec_t prec)
+{
+   mpc_t z, d, u;
+
+   mpc_init2 (z, prec);
+   mpc_init2 (d, prec);
+   mpc_init2 (u, prec);
+
+   binary [i].f (d, x, y, MPC_RNDDD);
+   binary [i].f (u, x, y, MPC_RNDUU);
+   binary [i].f (z, x, y, MPC_RNDFF);
+   if (!faithful_p (mpc_realref (z), mpc_realref (d), mpc_realref (u))
+       || !faithful_p (mpc_imagref (z), mpc_imagref (d), mpc_imagref (u)))
+      error (binary [i].name, "MPC_RNDFF", x, y, z, d, u);
+
+   mpc_clear (z);
+   mpc_clear (d);
+   mpc_clear (u);
+}
+
+static void
+check_random (void)
+{
+   const mpfr_prec_t precs [] = {2, 17, 53, 64, 113, 200};
+   mpc_t x, y;
+   mpfr_prec_t prec;
+   int i, k;
+
+   mpc_init2 (x, 2);
+   mpc_init2 (y, 2);
+
+   for (k = 0; k < 100; k++) {
+      prec = precs [k % 6];
+      mpc_set_prec (x, prec);
+      mpc_set_prec (y, prec);
+      test_default_random (x, -4, 4, 128, 0);
+      test_default_random (y, -4, 4, 128, 0);
+      for (i = 0; i < (int) (sizeof (unary) / sizeof (unary [0])); i++)
+         check_unary (i, x, prec);
+      for (i = 0; i < (int) (sizeof (binary) / sizeof (binary [0])); i++)
+         check_binary (i, x, y, prec);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+}
+
+static void
+check_exact (void)
+{
+   /* exact results have to be returned unchanged */
+   mpc_t x, y, z;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (y, 53);
+   mpc_init2 (z, 53);
+
+   /* log10 (6 + 8i) = 1 + i*atan2 (8, 6) / log (10) */
+   mpc_set_ui_ui (x, 6, 8, MPC_RNDNN);
+   mpc_log10 (z, x, MPC_RNDFF);
+   if (mpfr_cmp_ui (mpc_realref (z), 1) != 0) {
+      printf ("Error in mpc_log10 for rounding mode MPC_RNDFF\n");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   /* (3 + 4i)^2 = -7 + 24i */
+   mpc_set_ui_ui (x, 3, 4, MPC_RNDNN);
+   mpc_set_ui (y, 2, MPC_RNDNN);
+   mpc_pow (z, x, y, MPC_RNDFF);
+   if (mpfr_cmp_si (mpc_realref (z), -7) != 0
+       || mpfr_cmp_ui (mpc_imagref (z), 24) != 0) {
+      printf ("Error in mpc_pow for rounding mode MPC_RNDFF\n");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (z);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_exact ();
+   check_random ();
+
+   test_end ();
+
+   return 0;
+}
+
+#else
+
+int
+main (void)
+{
+   return 77;
+}
+
+#endif
@@ -89,6 +89,151 @@ check_random (void)
 }
 
 
+static void
+check_vec (void)
+{
+  /* compares mpc_fma_vec with element-wise calls to mpc_fma, including
+     special values and an overlap of the result with an operand */
+#define N 13
+  mpc_t a[N], b[N], c[N], z[N], t[N];
+  mpfr_prec_t prec;
+  int i, inex_z, inex_t;
+  known_signs_t ks = {1, 1};
+
+  for (i = 0; i < N; i++)
+    {
+      mpc_init2 (a[i], 2);
+      mpc_init2 (b[i], 2);
+      mpc_init2 (c[i], 2);
+      mpc_init2 (z[i], 2);
+      mpc_init2 (t[i], 2);
+    }
+
+  for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+    {
+      for (i = 0; i < N; i++)
+        {
+          mpc_set_prec (a[i], prec);
+          mpc_set_prec (b[i], prec);
+          mpc_set_prec (c[i], prec);
+          mpc_set_prec (z[i], prec + i);
+          mpc_set_prec (t[i], prec + i);
+          test_default_random (a[i], -256, 256, 128, 25);
+          test_default_random (b[i], -256, 256, 128, 25);
+          test_default_random (c[i], -256, 256, 128, 25);
+        }
+      mpfr_set_inf (mpc_realref (b[4]), +1);
+      mpfr_set_nan (mpc_realref (c[9]));
+
+      inex_t = 0;
+      for (i = 0; i < N; i++)
+        inex_t |= mpc_fma (t[i], a[i], b[i], c[i], MPC_RNDZU);
+      inex_z = mpc_fma_vec (z[0], a[0], b[0], c[0], N, MPC_RNDZU);
+      for (i = 0; i < N; i++)
+        if (!same_mpc_value (z[i], t[i], ks))
+          {
+            fprintf (stderr, "mpc_fma_vec and mpc_fma differ at index %d\n",
+                     i);
+            MPC_OUT (a[i]);
+            MPC_OUT (b[i]);
+            MPC_OUT (c[i]);
+            MPC_OUT (z[i]);
+            MPC_OUT (t[i]);
+            exit (1);
+          }
+      if (inex_z != inex_t)
+        {
+          fprintf (stderr, "mpc_fma_vec returned %d instead of %d\n",
+                   inex_z, inex_t);
+          exit (1);
+        }
+
+      /* in-place computation */
+      for (i = 0; i < N; i++)
+        mpc_set (z[i], c[i], MPC_RNDNN); /* exact */
+      mpc_fma_vec (z[0], a[0], b[0], z[0], N, MPC_RNDZU);
+      for (i = 0; i < N; i++)
+        if (!same_mpc_value (z[i], t[i], ks))
+          {
+            fprintf (stderr, "mpc_fma_vec with overlap and mpc_fma differ"
+                     " at index %d\n", i);
+            MPC_OUT (z[i]);
+            MPC_OUT (t[i]);
+            exit (1);
+          }
+    }
+
+  for (i = 0; i < N; i++)
+    {
+      mpc_clear (a[i]);
+      mpc_clear (b[i]);
+      mpc_clear (c[i]);
+      mpc_clear (z[i]);
+      mpc_clear (t[i]);
+    }
+#undef N
+}
+
+static void
+check_range (void)
+{
+  /* the real products may overflow while the result does not, and the
+     result may overflow in a way depending on the rounding mode */
+  mpc_t a, b, c, z;
+  mpfr_exp_t emax = mpfr_get_emax ();
+  mpfr_prec_t prec;
+  int inex;
+
+  mpc_init2 (a, 2);
+  mpc_init2 (b, 2);
+  mpc_init2 (c, 2);
+  mpc_init2 (z, 2);
+
+  for (prec = 53; prec <= 200; prec += 147)
+    {
+      mpc_set_prec (a, prec);
+      mpc_set_prec (b, prec);
+      mpc_set_prec (c, prec);
+      mpc_set_prec (z, prec);
+
+      /* 2^(emax-2) * (4+4i) - 3 * 2^(emax-2) * (1+i) = 2^(emax-2) * (1+i) */
+      mpc_set_ui (a, 1, MPC_RNDNN);
+      mpc_mul_2si (a, a, emax - 2, MPC_RNDNN);
+      mpc_set_ui_ui (b, 4, 4, MPC_RNDNN);
+      mpc_set_si_si (c, -3, -3, MPC_RNDNN);
+      mpc_mul_2si (c, c, emax - 2, MPC_RNDNN);
+      inex = mpc_fma (z, a, b, c, MPC_RNDNN);
+      if (inex != 0 || mpfr_cmp (mpc_realref (z), mpc_realref (a)) != 0
+          || mpfr_cmp (mpc_imagref (z), mpc_realref (a)) != 0)
+        {
+          fprintf (stderr, "mpc_fma fails for products out of the exponent"
+                   " range\n");
+          MPC_OUT (z);
+          exit (1);
+        }
+
+      /* 2^(emax-2) * (4+4i) - 2^(emax-2-prec) * (1+i) lies between the
+         largest representable number and 2^emax */
+      mpc_set_si_si (c, -1, -1, MPC_RNDNN);
+      mpc_mul_2si (c, c, emax - 2 - prec, MPC_RNDNN);
+      mpfr_clear_overflow ();
+      inex = mpc_fma (z, a, b, c, MPC_RNDZU);
+      if (!mpfr_inf_p (mpc_imagref (z)) || MPC_INEX_IM (inex) <= 0
+          || mpfr_inf_p (mpc_realref (z)) || MPC_INEX_RE (inex) >= 0
+          || !mpfr_overflow_p ())
+        {
+          fprintf (stderr, "mpc_fma fails for an overflow\n");
+          MPC_OUT (z);
+          exit (1);
+        }
+    }
+
+  mpc_clear (a);
+  mpc_clear (b);
+  mpc_clear (c);
+  mpc_clear (z);
+}
+
 int
 main (void)
 {
@@ -97,6 +242,8 @@ main (void)
   test_start ();
 
   check_random ();
+  check_vec ();
+  check_range ();
 
   data_check (f, "fma.dat");
   tgeneric (f, 2, 1024, 1, 256);
@@ -0,0 +1,213 @@
+/* tfmma -- test file for mpc_fmma and mpc_fmms.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+#define EXACT_PREC 3000
+   /* large enough for the exact value of a*b+c*d for operands of precision
+      at most 1000 and exponents between -100 and 100 */
+
+typedef int (*fmma_t) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_srcptr,
+                       mpc_srcptr, mpc_rnd_t);
+
+static void
+error (const char *name, mpc_rnd_t rnd, mpc_srcptr a, mpc_srcptr b,
+       mpc_srcptr c, mpc_srcptr d, mpc_srcptr z, mpc_srcptr ref, int inex,
+       int inex_ref)
+{
+   printf ("Error in %s for rnd=(%s,%s)\n", name,
+           mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+           mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+   MPC_OUT (a);
+   MPC_OUT (b);
+   MPC_OUT (c);
+   MPC_OUT (d);
+   printf ("got      ");
+   MPC_OUT (z);
+   printf ("expected ");
+   MPC_OUT (ref);
+   printf ("inex = %s, expected %s\n", MPC_INEX_STR (inex),
+           MPC_INEX_STR (inex_ref));
+   exit (1);
+}
+
+/* compares f (z, a, b, c, d, rnd) with the exact value rounded once, and
+   the same computation with z identical to a */
+static void
+check_fmma (const char *name, fmma_t f, int sign, mpc_ptr z, mpc_srcptr a,
+            mpc_srcptr b, mpc_srcptr c, mpc_srcptr d, mpc_rnd_t rnd)
+{
+   mpc_t u, v, ref, x;
+   int inex, inex_ref;
+   /* the sign of an exact zero is not specified */
+   known_signs_t ks = {0, 0};
+
+   mpc_init2 (u, EXACT_PREC);
+   mpc_init2 (v, EXACT_PREC);
+   mpc_init2 (ref, MPC_MAX_PREC (z));
+   if (mpc_mul (u, a, b, MPC_RNDNN) != 0 || mpc_mul (v, c, d, MPC_RNDNN) != 0
+       || (sign < 0 ? mpc_sub (u, u, v, MPC_RNDNN)
+                    : mpc_add (u, u, v, MPC_RNDNN)) != 0) {
+      printf ("Error in check_fmma: inexact reference value\n");
+      exit (1);
+   }
+   inex_ref = mpc_set (ref, u, rnd);
+
+   inex = f (z, a, b, c, d, rnd);
+   if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+      error (name, rnd, a, b, c, d, z, ref, inex, inex_ref);
+
+   /* a and z have the same precision, so that x is a copy of a */
+   mpc_init2 (x, MPC_MAX_PREC (z));
+   mpc_set (x, a, MPC_RNDNN);
+   inex = f (x, x, b, c, d, rnd);
+   if (!same_mpc_value (x, ref, ks) || inex != inex_ref)
+      error (name, rnd, a, b, c, d, x, ref, inex, inex_ref);
+
+   mpc_clear (u);
+   mpc_clear (v);
+   mpc_clear (ref);
+   mpc_clear (x);
+}
+
+static void
+check_random (void)
+{
+   mpc_t a, b, c, d, z;
+   mpfr_prec_t prec;
+   int k, rnd_re, rnd_im;
+
+   mpc_init2 (a, 2);
+   mpc_init2 (b, 2);
+   mpc_init2 (c, 2);
+   mpc_init2 (d, 2);
+   mpc_init2 (z, 2);
+
+   for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+      for (k = 0; k < 3; k++) {
+         mpc_set_prec (a, prec);
+         mpc_set_prec (b, prec);
+         mpc_set_prec (c, prec + 17 * k);
+         mpc_set_prec (d, prec);
+         mpc_set_prec (z, prec);
+         test_default_random (a, -100, 100, 128, 16);
+         test_default_random (b, -100, 100, 128, 16);
+         test_default_random (c, -100, 100, 128, 16);
+         test_default_random (d, -100, 100, 128, 16);
+         if (k == 2) {
+            /* cancellation of a*b and c*d */
+            mpc_set_prec (c, prec);
+            mpc_set (c, a, MPC_RNDNN);
+            mpc_set (d, b, MPC_RNDNN);
+            if (!mpfr_zero_p (mpc_realref (d)))
+               mpfr_nextabove (mpc_realref (d));
+         }
+         for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+            for (rnd_im = 0; rnd_im < 4; rnd_im ++) {
+               check_fmma ("mpc_fmma", mpc_fmma, 1, z, a, b, c, d,
+                           MPC_RND (rnd_re, rnd_im));
+               check_fmma ("mpc_fmms", mpc_fmms, -1, z, a, b, c, d,
+                           MPC_RND (rnd_re, rnd_im));
+            }
+      }
+
+   mpc_clear (a);
+   mpc_clear (b);
+   mpc_clear (c);
+   mpc_clear (d);
+   mpc_clear (z);
+}
+
+static void
+check_range (void)
+{
+   /* the exact products may overflow or underflow while the result does
+      not */
+   mpc_t a, b, c, d, z;
+   mpfr_exp_t emax = mpfr_get_emax ();
+   mpfr_exp_t emin = mpfr_get_emin ();
+   int inex;
+
+   mpc_init2 (a, 53);
+   mpc_init2 (b, 53);
+   mpc_init2 (c, 53);
+   mpc_init2 (d, 53);
+   mpc_init2 (z, 53);
+
+   /* 2^(emax-1) * (4+4i) - 2^(emax-1) * (3+3i) = 2^(emax-1) * (1+i) */
+   mpc_set_ui_ui (a, 1, 0, MPC_RNDNN);
+   mpc_mul_2si (a, a, emax - 1, MPC_RNDNN);
+   mpc_set_ui_ui (b, 4, 4, MPC_RNDNN);
+   mpc_set (c, a, MPC_RNDNN);
+   mpc_set_ui_ui (d, 3, 3, MPC_RNDNN);
+   inex = mpc_fmms (z, a, b, c, d, MPC_RNDNN);
+   if (inex != 0 || mpfr_cmp (mpc_realref (z), mpc_realref (a)) != 0
+       || mpfr_cmp (mpc_imagref (z), mpc_realref (a)) != 0) {
+      printf ("Error in mpc_fmms for products out of the exponent range\n");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   /* 2^emin * 2^emin rounded upwards is the smallest positive number */
+   mpc_set_ui_ui (a, 1, 1, MPC_RNDNN);
+   mpc_mul_2si (a, a, emin, MPC_RNDNN);
+   mpc_set_ui (c, 0, MPC_RNDNN);
+   mpfr_clear_underflow ();
+   inex = mpc_fmma (z, a, a, c, c, MPC_RNDUU);
+   if (!mpfr_zero_p (mpc_realref (z)) || MPC_INEX_IM (inex) <= 0
+       || mpfr_cmp_ui_2exp (mpc_imagref (z), 1, emin - 1) != 0
+       || !mpfr_underflow_p ()) {
+      printf ("Error in mpc_fmma for an underflow\n");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   /* (+inf + i) * (1 + 0i) + (1 + i) * (1 + i) = +inf + i*NaN */
+   mpc_set_ui_ui (a, 0, 1, MPC_RNDNN);
+   mpfr_set_inf (mpc_realref (a), 1);
+   mpc_set_ui_ui (b, 1, 0, MPC_RNDNN);
+   mpc_set_ui_ui (c, 1, 1, MPC_RNDNN);
+   mpc_fmma (z, a, b, c, c, MPC_RNDNN);
+   if (!mpfr_inf_p (mpc_realref (z)) || mpfr_signbit (mpc_realref (z))) {
+      printf ("Error in mpc_fmma for an infinite operand\n");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   mpc_clear (a);
+   mpc_clear (b);
+   mpc_clear (c);
+   mpc_clear (d);
+   mpc_clear (z);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_range ();
+   check_random ();
+
+   test_end ();
+
+   return 0;
+}
@@ -0,0 +1,103 @@
+/* tinv -- test file for mpc_inv.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+/* compares mpc_inv (z, op, rnd) with mpc_div (z, 1, op, rnd) */
+static void
+check_inv (mpc_ptr z, mpc_srcptr op, mpc_rnd_t rnd)
+{
+   mpc_t one, ref;
+   int inex, inex_ref;
+   known_signs_t ks = {1, 1};
+
+   mpc_init2 (one, 2);
+   mpc_init3 (ref, MPC_PREC_RE (z), MPC_PREC_IM (z));
+   mpc_set_ui (one, 1, MPC_RNDNN);
+   inex_ref = mpc_div (ref, one, op, rnd);
+
+   inex = mpc_inv (z, op, rnd);
+   if (!same_mpc_value (z, ref, ks) || inex != inex_ref) {
+      printf ("Error in mpc_inv for rnd=(%s,%s)\n",
+              mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+              mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+      MPC_OUT (op);
+      printf ("got      ");
+      MPC_OUT (z);
+      printf ("expected ");
+      MPC_OUT (ref);
+      printf ("inex = %s, expected %s\n", MPC_INEX_STR (inex),
+              MPC_INEX_STR (inex_ref));
+      exit (1);
+   }
+
+   mpc_clear (one);
+   mpc_clear (ref);
+}
+
+static void
+check_random (void)
+{
+   mpc_t op, z;
+   mpfr_prec_t prec;
+   int k, rnd_re, rnd_im;
+
+   mpc_init2 (op, 2);
+   mpc_init2 (z, 2);
+
+   for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+      for (k = 0; k < 4; k++) {
+         mpc_set_prec (op, prec + 50 * (k == 1));
+         mpc_set_prec (z, prec);
+         test_default_random (op, -100, 100, 128, 16);
+         if (k == 2)
+            /* exact inverse (1-i)/2 */
+            mpc_set_si_si (op, 1, 1, MPC_RNDNN);
+         else if (k == 3) {
+            /* exact inverse 2^29*(1+i) of an operand of large precision */
+            mpc_set_prec (op, 1000);
+            mpc_set_si_si (op, 1, -1, MPC_RNDNN);
+            mpc_div_2ui (op, op, 30, MPC_RNDNN);
+         }
+         for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+            for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+               check_inv (z, op, MPC_RND (rnd_re, rnd_im));
+      }
+
+   mpc_clear (op);
+   mpc_clear (z);
+}
+
+int
+main (void)
+{
+   DECL_FUNC (CC, f, mpc_inv);
+
+   test_start ();
+
+   check_random ();
+
+   tgeneric (f, 2, 1024, 7, 4096);
+
+   test_end ();
+
+   return 0;
+}
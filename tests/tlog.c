@@ -21,6 +21,76 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdlib.h>
 #include "mpc-tests.h"
 
+/* internal function of log.c, to select the AGM at small precisions */
+extern void mpc_set_log_agm_threshold (mpfr_prec_t);
+
+/* compares mpc_log with the AGM to mpc_log without it, for operands in
+   the four quadrants, close to the real axis, close to the unit circle
+   and of large and small absolute value */
+static void
+check_agm (void)
+{
+  mpc_t z, r1, r2;
+  mpfr_prec_t prec;
+  int k, rnd_re, rnd_im, inex1, inex2;
+  known_signs_t ks = {1, 1};
+
+  mpc_init2 (z, 2);
+  mpc_init2 (r1, 2);
+  mpc_init2 (r2, 2);
+
+  for (prec = 2; prec < 1500; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (k = 0; k < 8; k++)
+      {
+        mpc_set_prec (z, prec + (k % 3) * 7);
+        mpc_set_prec (r1, prec);
+        mpc_set_prec (r2, prec);
+        do
+          test_default_random (z, -2, 2, 128, 0);
+        while (mpfr_zero_p (mpc_realref (z))
+               || mpfr_zero_p (mpc_imagref (z)));
+        if (k == 2)
+          mpfr_div_2ui (mpc_imagref (z), mpc_imagref (z), prec / 2 + 10,
+                        MPFR_RNDN);
+        else if (k == 3)
+          mpc_mul_2ui (z, z, 100000, MPC_RNDNN);
+        else if (k == 4)
+          mpc_div_2ui (z, z, 100000, MPC_RNDNN);
+        else if (k == 5)
+          {
+            /* |z| = 1 + 2^(-2 prec/3) approximately */
+            mpfr_set_si (mpc_realref (z), -1, MPFR_RNDN);
+            mpfr_set_exp (mpc_imagref (z), -prec / 3);
+          }
+        for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+          for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+            {
+              mpc_set_log_agm_threshold (MPFR_PREC_MAX);
+              inex1 = mpc_log (r1, z, MPC_RND (rnd_re, rnd_im));
+              mpc_set_log_agm_threshold (2);
+              inex2 = mpc_log (r2, z, MPC_RND (rnd_re, rnd_im));
+              if (!same_mpc_value (r1, r2, ks) || inex1 != inex2)
+                {
+                  printf ("Error in mpc_log with the AGM for rnd=(%s,%s)\n",
+                          mpfr_print_rnd_mode ((mpfr_rnd_t) rnd_re),
+                          mpfr_print_rnd_mode ((mpfr_rnd_t) rnd_im));
+                  MPC_OUT (z);
+                  printf ("got      ");
+                  MPC_OUT (r2);
+                  printf ("expected ");
+                  MPC_OUT (r1);
+                  printf ("inex = %s, expected %s\n", MPC_INEX_STR (inex2),
+                          MPC_INEX_STR (inex1));
+                  exit (1);
+                }
+            }
+      }
+
+  mpc_clear (z);
+  mpc_clear (r1);
+  mpc_clear (r2);
+}
+
 int
 main (void)
 {
@@ -31,6 +101,11 @@ main (void)
   data_check (f, "log.dat");
   tgeneric (f, 2, 512, 7, 128);
 
+  check_agm ();
+  /* the special values and the reuse of the operand with the AGM */
+  tgeneric (f, 2, 512, 7, 128);
+  mpc_set_log_agm_threshold (MPFR_PREC_MAX);
+
   test_end ();
 
   return 0;
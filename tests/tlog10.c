@@ -21,6 +21,56 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 #include <stdlib.h>
 #include "mpc-tests.h"
 
+/* compares mpc_log10 (-1) = i*pi/log(10) at decreasing and increasing
+   precisions, with log(10) served from the cache filled by previous calls,
+   with the value computed after emptying the cache */
+static void
+check_cache (void)
+{
+  mpc_t op, z, ref, big;
+  mpfr_prec_t prec;
+  int i, r, inex, inex_ref;
+  known_signs_t ks = {1, 1};
+
+  mpc_init2 (op, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (ref, 2);
+  mpc_init2 (big, 3000);
+  mpc_set_si (op, -1, MPC_RNDNN);
+
+  for (i = 0; i < 2; i++)
+    for (prec = 2; prec < 3000; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+      {
+        /* first from large to small precisions, then the other way */
+        mpc_set_prec (z, i == 0 ? 3000 - prec : prec);
+        mpc_set_prec (ref, mpc_get_prec (z));
+        for (r = 0; r < 4; r++)
+          {
+            if (i == 0)
+              /* fill the cache at a large precision */
+              mpc_log10 (big, op, MPC_RNDNN);
+            inex = mpc_log10 (z, op, MPC_RND (MPFR_RNDN, r));
+            mpc_free_cache ();
+            inex_ref = mpc_log10 (ref, op, MPC_RND (MPFR_RNDN, r));
+            if (!same_mpc_value (z, ref, ks) || inex != inex_ref)
+              {
+                printf ("Error in mpc_log10 with cached log(10) for "
+                        "rnd=%s\n", mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+                printf ("got      ");
+                MPC_OUT (z);
+                printf ("expected ");
+                MPC_OUT (ref);
+                exit (1);
+              }
+          }
+      }
+
+  mpc_clear (op);
+  mpc_clear (z);
+  mpc_clear (ref);
+  mpc_clear (big);
+}
+
 int
 main (void)
 {
@@ -30,6 +80,7 @@ main (void)
 
   data_check (f, "log10.dat");
   tgeneric (f, 2, 512, 7, 128);
+  check_cache ();
 
   test_end ();
 
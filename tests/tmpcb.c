@@ -0,0 +1,438 @@
+/* tmpcb -- test file for complex ball arithmetic.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+/* The balls computed from exact operands have to contain the exact
+   results, which are approximated by the mpc functions at a much larger
+   precision REF_PREC. */
+
+#define REF_PREC 500
+
+#define ADD 0
+#define MUL 1
+#define SQR 2
+#define DIV 3
+#define EXP 4
+#define LOG 5
+#define SIN 6
+#define COS 7
+#define SQRT 8
+#define POW 9
+
+static const char *names [] = {"mpcb_add", "mpcb_mul", "mpcb_sqr",
+   "mpcb_div", "mpcb_exp", "mpcb_log", "mpcb_sin_cos (sin)",
+   "mpcb_sin_cos (cos)", "mpcb_sqrt", "mpcb_pow"};
+
+static void
+call_ball (int op, mpcb_ptr z, mpcb_srcptr x, mpcb_srcptr y)
+{
+   switch (op) {
+   case ADD:
+      mpcb_add (z, x, y);
+      break;
+   case MUL:
+      mpcb_mul (z, x, y);
+      break;
+   case SQR:
+      mpcb_sqr (z, x);
+      break;
+   case DIV:
+      mpcb_div (z, x, y);
+      break;
+   case EXP:
+      mpcb_exp (z, x);
+      break;
+   case LOG:
+      mpcb_log (z, x);
+      break;
+   case SIN:
+      mpcb_sin_cos (z, NULL, x);
+      break;
+   case COS:
+      mpcb_sin_cos (NULL, z, x);
+      break;
+   case SQRT:
+      mpcb_sqrt (z, x);
+      break;
+   default:
+      mpcb_pow (z, x, y);
+   }
+}
+
+static void
+call_ref (int op, mpc_ptr z, mpc_srcptr x, mpc_srcptr y)
+{
+   switch (op) {
+   case ADD:
+      mpc_add (z, x, y, MPC_RNDNN);
+      break;
+   case MUL:
+      mpc_mul (z, x, y, MPC_RNDNN);
+      break;
+   case SQR:
+      mpc_sqr (z, x, MPC_RNDNN);
+      break;
+   case DIV:
+      mpc_div (z, x, y, MPC_RNDNN);
+      break;
+   case EXP:
+      mpc_exp (z, x, MPC_RNDNN);
+      break;
+   case LOG:
+      mpc_log (z, x, MPC_RNDNN);
+      break;
+   case SIN:
+      mpc_sin (z, x, MPC_RNDNN);
+      break;
+   case COS:
+      mpc_cos (z, x, MPC_RNDNN);
+      break;
+   case SQRT:
+      mpc_sqrt (z, x, MPC_RNDNN);
+      break;
+   default:
+      mpc_pow (z, x, y, MPC_RNDNN);
+   }
+}
+
+/* returns non-zero if the ball z contains the value approximated by ref,
+   up to the error of ref */
+static int
+contains_p (mpcb_srcptr z, mpc_srcptr ref)
+{
+   mpc_t d;
+   mpfr_t dist, bound, t;
+   int res;
+
+   if (mpfr_inf_p (z->r))
+      return 1;
+
+   mpc_init2 (d, REF_PREC);
+   mpfr_init2 (dist, 64);
+   mpfr_init2 (bound, 64);
+   mpfr_init2 (t, 64);
+
+   mpc_sub (d, ref, z->c, MPC_RNDNN);
+   mpc_abs (dist, d, MPFR_RNDD);
+   mpc_abs (bound, z->c, MPFR_RNDU);
+   mpfr_mul (bound, bound, z->r, MPFR_RNDU);
+   mpc_abs (t, ref, MPFR_RNDU);
+   mpfr_mul_2si (t, t, 4 - REF_PREC, MPFR_RNDU);
+   mpfr_add (bound, bound, t, MPFR_RNDU);
+   res = (mpfr_cmp (dist, bound) <= 0);
+
+   mpc_clear (d);
+   mpfr_clear (dist);
+   mpfr_clear (bound);
+   mpfr_clear (t);
+
+   return res;
+}
+
+static void
+error (const char *name, mpc_srcptr x, mpc_srcptr y, mpcb_srcptr z,
+       mpc_srcptr ref)
+{
+   printf ("Error in %s for\n", name);
+   MPC_OUT (x);
+   if (y != NULL)
+      MPC_OUT (y);
+   printf ("got centre ");
+   MPC_OUT (z->c);
+   printf ("and radius ");
+   mpfr_out_str (stdout, 2, 0, z->r, MPFR_RNDU);
+   printf ("\nexpected   ");
+   MPC_OUT (ref);
+   exit (1);
+}
+
+/* checks op for the exact operands x and y and a result of precision p;
+   for operands of moderate size, the radius has to be small unless
+   cancellation may occur */
+static void
+check_op (int op, mpc_srcptr x, mpc_srcptr y, mpfr_prec_t p)
+{
+   mpcb_t xb, yb, z;
+   mpc_t ref;
+
+   mpcb_init2 (xb, mpc_get_prec (x));
+   mpcb_init2 (yb, mpc_get_prec (y));
+   mpcb_init2 (z, p);
+   mpc_init2 (ref, REF_PREC);
+
+   mpcb_set_c (xb, x);
+   mpcb_set_c (yb, y);
+   call_ball (op, z, xb, yb);
+   call_ref (op, ref, x, y);
+   if (!contains_p (z, ref))
+      error (names [op], x, y, z, ref);
+   if (p >= 10
+       && (op == MUL || op == SQR || op == DIV || op == EXP || op == SQRT)
+       && (mpfr_inf_p (z->r) || mpfr_cmp_ui_2exp (z->r, 1, 5 - p) > 0)) {
+      printf ("Radius too large in %s\n", names [op]);
+      error (names [op], x, y, z, ref);
+   }
+
+   /* the same in place */
+   mpcb_set_prec (xb, p);
+   mpcb_set_c (xb, x);
+   call_ball (op, xb, xb, yb);
+   if (!contains_p (xb, ref))
+      error (names [op], x, y, xb, ref);
+
+   mpcb_clear (xb);
+   mpcb_clear (yb);
+   mpcb_clear (z);
+   mpc_clear (ref);
+}
+
+static void
+check_random (void)
+{
+   const mpfr_prec_t precs [] = {2, 10, 53, 64, 113, 200};
+   mpc_t x, y;
+   mpfr_prec_t p;
+   int i, op;
+
+   mpc_init2 (x, 2);
+   mpc_init2 (y, 2);
+
+   for (i = 0; i < 200; i++) {
+      p = precs [i % 6];
+      mpc_set_prec (x, p + i % 3);
+      mpc_set_prec (y, p);
+      test_default_random (x, -4, 4, 128, 0);
+      test_default_random (y, -4, 4, 128, 0);
+      for (op = ADD; op <= POW; op++)
+         check_op (op, x, y, p);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+}
+
+static void
+check_chain (void)
+{
+   /* The radius grows along a chain of operations, but the final ball
+      still contains the exact result. */
+   mpc_t x, y, ref, t;
+   mpcb_t xb, yb, z, s, c;
+   int i;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (y, 53);
+   mpc_init2 (ref, REF_PREC);
+   mpc_init2 (t, REF_PREC);
+   mpcb_init2 (xb, 53);
+   mpcb_init2 (yb, 53);
+   mpcb_init2 (z, 100);
+   mpcb_init2 (s, 100);
+   mpcb_init2 (c, 100);
+
+   for (i = 0; i < 50; i++) {
+      test_default_random (x, -2, 2, 128, 0);
+      test_default_random (y, -2, 2, 128, 0);
+      mpcb_set_c (xb, x);
+      mpcb_set_c (yb, y);
+
+      /* z = sqrt (exp (x) * y / (x^2 + sin (y)^2 + cos (y)^2)) ^ x */
+      mpcb_sin_cos (s, c, yb);
+      mpcb_sqr (s, s);
+      mpcb_sqr (c, c);
+      mpcb_add (s, s, c);
+      mpcb_sqr (c, xb);
+      mpcb_add (s, s, c);
+      mpcb_exp (z, xb);
+      mpcb_mul (z, z, yb);
+      mpcb_div (z, z, s);
+      mpcb_sqrt (z, z);
+      mpcb_pow (z, z, xb);
+
+      mpc_sin (ref, y, MPC_RNDNN);
+      mpc_sqr (ref, ref, MPC_RNDNN);
+      mpc_cos (t, y, MPC_RNDNN);
+      mpc_sqr (t, t, MPC_RNDNN);
+      mpc_add (ref, ref, t, MPC_RNDNN);
+      mpc_sqr (t, x, MPC_RNDNN);
+      mpc_add (ref, ref, t, MPC_RNDNN);
+      mpc_exp (t, x, MPC_RNDNN);
+      mpc_mul (t, t, y, MPC_RNDNN);
+      mpc_div (ref, t, ref, MPC_RNDNN);
+      mpc_sqrt (ref, ref, MPC_RNDNN);
+      mpc_pow (ref, ref, x, MPC_RNDNN);
+
+      if (!contains_p (z, ref))
+         error ("chain", x, y, z, ref);
+      if (mpfr_inf_p (z->r) || mpfr_cmp_ui_2exp (z->r, 1, -80) > 0) {
+         printf ("Radius too large in chain\n");
+         error ("chain", x, y, z, ref);
+      }
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (ref);
+   mpc_clear (t);
+   mpcb_clear (xb);
+   mpcb_clear (yb);
+   mpcb_clear (z);
+   mpcb_clear (s);
+   mpcb_clear (c);
+}
+
+static void
+check_round (void)
+{
+   /* When mpcb_can_round succeeds, mpcb_round yields the correct
+      rounding. */
+   const mpfr_rnd_t r [] = {MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD};
+   mpc_t x, z, ref;
+   mpcb_t xb, zb;
+   mpc_rnd_t rnd;
+   int i, j, k, inex, rounded = 0;
+
+   mpc_init2 (x, 53);
+   mpc_init2 (z, 53);
+   mpc_init2 (ref, 53);
+   mpcb_init2 (xb, 53);
+   mpcb_init2 (zb, 73);
+
+   for (i = 0; i < 100; i++) {
+      test_default_random (x, -4, 4, 128, 0);
+      mpcb_set_c (xb, x);
+      mpcb_exp (zb, xb);
+      for (j = 0; j < 4; j++)
+         for (k = 0; k < 4; k++) {
+            rnd = MPC_RND (r [j], r [k]);
+            if (!mpcb_can_round (zb, 53, 53, rnd))
+               continue;
+            rounded++;
+            inex = mpcb_round (z, zb, rnd);
+            if (mpc_exp (ref, x, rnd) != inex || mpc_cmp (z, ref) != 0) {
+               printf ("Error in mpcb_round for rounding mode (%s,%s)\n",
+                       mpfr_print_rnd_mode (r [j]),
+                       mpfr_print_rnd_mode (r [k]));
+               MPC_OUT (x);
+               MPC_OUT (z);
+               MPC_OUT (ref);
+               exit (1);
+            }
+         }
+   }
+   if (rounded < 1000) {
+      printf ("Error: mpcb_can_round succeeded only %i times\n", rounded);
+      exit (1);
+   }
+
+   mpc_clear (x);
+   mpc_clear (z);
+   mpc_clear (ref);
+   mpcb_clear (xb);
+   mpcb_clear (zb);
+}
+
+static void
+check_special (void)
+{
+   mpc_t x;
+   mpcb_t xb, yb, z;
+
+   mpc_init2 (x, 200);
+   mpcb_init2 (xb, 53);
+   mpcb_init2 (yb, 53);
+   mpcb_init2 (z, 53);
+
+   /* exact results have a zero radius */
+   mpc_set_si_si (x, -7, 24, MPC_RNDNN);
+   mpcb_set_c (xb, x);
+   mpcb_sqrt (z, xb);
+   if (mpc_cmp_si_si (z->c, 3, 4) != 0 || !mpfr_zero_p (z->r)) {
+      printf ("Error in mpcb_sqrt for an exact result\n");
+      exit (1);
+   }
+   mpcb_neg (yb, xb);
+   mpcb_add (z, xb, yb);
+   if (mpc_cmp_si (z->c, 0) != 0 || !mpfr_zero_p (z->r)) {
+      printf ("Error in mpcb_add for an exact zero\n");
+      exit (1);
+   }
+
+   /* an inexact zero is not the exact zero */
+   mpc_set_ui_ui (x, 1, 1, MPC_RNDNN);
+   mpc_div_ui (x, x, 3, MPC_RNDNN);
+   mpcb_set_c (xb, x);
+   mpcb_neg (yb, xb);
+   mpcb_add (z, xb, yb);
+   if (!mpfr_inf_p (z->r)) {
+      printf ("Error in mpcb_add for an inexact zero\n");
+      exit (1);
+   }
+
+   /* a ball meeting the negative real axis */
+   mpc_set_si (x, -1, MPC_RNDNN);
+   mpfr_set_ui (mpc_imagref (x), 1, MPFR_RNDN);
+   mpfr_div_ui (mpc_imagref (x), mpc_imagref (x), 3, MPFR_RNDN);
+   mpfr_mul_2si (mpc_imagref (x), mpc_imagref (x), -70, MPFR_RNDN);
+   mpcb_set_c (xb, x);
+   mpcb_log (z, xb);
+   if (!mpfr_inf_p (z->r)) {
+      printf ("Error in mpcb_log near the branch cut\n");
+      exit (1);
+   }
+   mpcb_sqrt (z, xb);
+   if (!mpfr_inf_p (z->r)) {
+      printf ("Error in mpcb_sqrt near the branch cut\n");
+      exit (1);
+   }
+
+   /* overflow yields an infinite radius without raising the flag */
+   mpc_set_ui (x, 1, MPC_RNDNN);
+   mpc_mul_2ui (x, x, 40, MPC_RNDNN);
+   mpcb_set_c (xb, x);
+   mpfr_clear_flags ();
+   mpcb_exp (z, xb);
+   if (!mpfr_inf_p (z->r) || mpfr_overflow_p ()) {
+      printf ("Error in mpcb_exp for an overflow\n");
+      exit (1);
+   }
+
+   mpc_clear (x);
+   mpcb_clear (xb);
+   mpcb_clear (yb);
+   mpcb_clear (z);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_special ();
+   check_random ();
+   check_chain ();
+   check_round ();
+
+   test_end ();
+
+   return 0;
+}
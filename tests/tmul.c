@@ -26,21 +26,23 @@ along with this program. If not, see http://www.gnu.org/licenses/ .
 
 static void
 cmpmul (mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
-   /* computes the product of x and y with the naive and Karatsuba methods */
-   /* using the rounding mode rnd and compares the results and return      */
-   /* values.                                                              */
+   /* computes the product of x and y with the naive, Karatsuba and Gauss  */
+   /* methods using the rounding mode rnd and compares the results and     */
+   /* return values.                                                       */
    /* In our current test suite, the real and imaginary parts of x and y   */
    /* all have the same precision, and we use this precision also for the  */
    /* result.                                                              */
 {
-   mpc_t z, t;
-   int   inex_z, inex_t;
+   mpc_t z, t, u;
+   int   inex_z, inex_t, inex_u;
 
    mpc_init2 (z, MPC_MAX_PREC (x));
    mpc_init2 (t, MPC_MAX_PREC (x));
+   mpc_init2 (u, MPC_MAX_PREC (x));
 
    inex_z = mpc_mul_naive (z, x, y, rnd);
    inex_t = mpc_mul_karatsuba (t, x, y, rnd);
+   inex_u = mpc_mul_gauss (u, x, y, rnd);
 
    if (mpc_cmp (z, t) != 0 || inex_z != inex_t) {
       fprintf (stderr, "mul_naive and mul_karatsuba differ for rnd=(%s,%s)\n",
@@ -56,9 +58,24 @@ cmpmul (mpc_srcptr x, mpc_srcptr y, mpc_rnd_t rnd)
       }
       exit (1);
    }
+   if (mpc_cmp (z, u) != 0 || inex_z != inex_u) {
+      fprintf (stderr, "mul_naive and mul_gauss differ for rnd=(%s,%s)\n",
+               mpfr_print_rnd_mode(MPC_RND_RE(rnd)),
+               mpfr_print_rnd_mode(MPC_RND_IM(rnd)));
+      MPC_OUT (x);
+      MPC_OUT (y);
+      MPC_OUT (z);
+      MPC_OUT (u);
+      if (inex_z != inex_u) {
+         fprintf (stderr, "inex_re (z): %s\n", MPC_INEX_STR (inex_z));
+         fprintf (stderr, "inex_re (u): %s\n", MPC_INEX_STR (inex_u));
+      }
+      exit (1);
+   }
 
    mpc_clear (z);
    mpc_clear (t);
+   mpc_clear (u);
 }
 
 
@@ -124,10 +141,306 @@ check_regular (void)
       for (rnd_re = 0; rnd_re < 4; rnd_re ++)
         for (rnd_im = 0; rnd_im < 4; rnd_im ++)
           cmpmul (x, y, MPC_RND (rnd_re, rnd_im));
+
+      /* cancellation in the real part, then in the imaginary part */
+      mpfr_set (mpc_realref (y), mpc_imagref (x), MPFR_RNDN);
+      mpfr_set (mpc_imagref (y), mpc_realref (x), MPFR_RNDN);
+      mpfr_nextabove (mpc_realref (y));
+      for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+        cmpmul (x, y, MPC_RND (rnd_re, 3 - rnd_re));
+      mpfr_neg (mpc_realref (y), mpc_imagref (x), MPFR_RNDN);
+      mpfr_set (mpc_imagref (y), mpc_realref (x), MPFR_RNDN);
+      mpfr_nextbelow (mpc_imagref (y));
+      for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+        cmpmul (x, y, MPC_RND (rnd_re, 3 - rnd_re));
+    }
+
+  mpc_clear (x);
+  mpc_clear (y);
+}
+
+
+static void
+check_vec (void)
+{
+  /* compares mpc_mul_vec with element-wise calls to mpc_mul, including
+     special values and an overlap of the result with an operand */
+#define N 17
+  mpc_t x[N], y[N], z[N], t[N];
+  mpfr_prec_t prec;
+  int i, inex_z, inex_t;
+  known_signs_t ks = {1, 1};
+
+  for (i = 0; i < N; i++)
+    {
+      mpc_init2 (x[i], 2);
+      mpc_init2 (y[i], 2);
+      mpc_init2 (z[i], 2);
+      mpc_init2 (t[i], 2);
+    }
+
+  for (prec = 2; prec < 3000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    {
+      for (i = 0; i < N; i++)
+        {
+          mpc_set_prec (x[i], prec);
+          mpc_set_prec (y[i], prec);
+          mpc_set_prec (z[i], prec + i);
+          mpc_set_prec (t[i], prec + i);
+          test_default_random (x[i], -1024, 1024, 128, 25);
+          test_default_random (y[i], -1024, 1024, 128, 25);
+        }
+      mpfr_set_inf (mpc_realref (x[3]), -1);
+      mpfr_set_nan (mpc_imagref (y[5]));
+      mpfr_mul_2ui (mpc_imagref (x[7]), mpc_realref (x[7]), prec,
+                    MPFR_RNDN);
+
+      inex_t = 0;
+      for (i = 0; i < N; i++)
+        inex_t |= mpc_mul (t[i], x[i], y[i], MPC_RNDNZ);
+      inex_z = mpc_mul_vec (z[0], x[0], y[0], N, MPC_RNDNZ);
+      for (i = 0; i < N; i++)
+        if (!same_mpc_value (z[i], t[i], ks))
+          {
+            fprintf (stderr, "mpc_mul_vec and mpc_mul differ at index %d\n",
+                     i);
+            MPC_OUT (x[i]);
+            MPC_OUT (y[i]);
+            MPC_OUT (z[i]);
+            MPC_OUT (t[i]);
+            exit (1);
+          }
+      if (inex_z != inex_t)
+        {
+          fprintf (stderr, "mpc_mul_vec returned %d instead of %d\n",
+                   inex_z, inex_t);
+          exit (1);
+        }
+
+      /* in-place computation */
+      for (i = 0; i < N; i++)
+        mpc_set (z[i], y[i], MPC_RNDNN); /* exact */
+      mpc_mul_vec (z[0], x[0], z[0], N, MPC_RNDNZ);
+      for (i = 0; i < N; i++)
+        if (!same_mpc_value (z[i], t[i], ks))
+          {
+            fprintf (stderr, "mpc_mul_vec with overlap and mpc_mul differ"
+                     " at index %d\n", i);
+            MPC_OUT (x[i]);
+            MPC_OUT (y[i]);
+            MPC_OUT (z[i]);
+            MPC_OUT (t[i]);
+            exit (1);
+          }
+    }
+
+  for (i = 0; i < N; i++)
+    {
+      mpc_clear (x[i]);
+      mpc_clear (y[i]);
+      mpc_clear (z[i]);
+      mpc_clear (t[i]);
+    }
+#undef N
+}
+
+
+static void
+check_precomp (void)
+{
+  /* compares mpc_mul_precomp with mpc_mul, for random fixed factors
+     including special values, parts of very different exponents and
+     exact products, and for all rounding modes */
+  mpc_t x, y, z, t;
+  mpc_mul_precomp_t pc;
+  mpfr_prec_t prec;
+  int i, j, k, inex_z, inex_t;
+  mpc_rnd_t rnd;
+  known_signs_t ks = {1, 1};
+
+  mpc_init2 (x, 2);
+  mpc_init2 (y, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (t, 2);
+
+  for (prec = 2; prec < 4000; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+    for (i = 0; i < 6; i++)
+      {
+        mpc_set_prec (y, prec);
+        test_default_random (y, -1024, 1024, 128, 10);
+        if (i == 1)
+          mpfr_set_inf (mpc_imagref (y), 1);
+        else if (i == 2)
+          mpfr_mul_2ui (mpc_realref (y), mpc_imagref (y), prec, MPFR_RNDN);
+        else if (i == 3)
+          mpc_set_si_si (y, -3, 5, MPC_RNDNN);
+        else if (i == 4)
+          mpfr_neg (mpc_realref (y), mpc_imagref (y), MPFR_RNDN);
+        /* the precision of the results need not match the one given to
+           mpc_mul_precomp_init */
+        mpc_mul_precomp_init (pc, y, (i == 5 ? prec / 2 + 2 : prec));
+
+        for (j = 0; j < 4; j++)
+          {
+            mpc_set_prec (x, prec);
+            test_default_random (x, -1024, 1024, 128, 10);
+            if (j == 1)
+              mpc_set_si_si (x, 7, -2, MPC_RNDNN);
+            mpc_set_prec (z, prec);
+            mpc_set_prec (t, prec);
+            for (k = 0; k < 16; k++)
+              {
+                rnd = MPC_RND (k % 4, k / 4);
+                inex_t = mpc_mul (t, x, y, rnd);
+                inex_z = mpc_mul_precomp (z, x, pc, rnd);
+                if (!same_mpc_value (z, t, ks) || inex_z != inex_t)
+                  {
+                    fprintf (stderr, "mpc_mul_precomp and mpc_mul differ"
+                             " for rnd=(%s,%s)\n",
+                             mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                             mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                    MPC_OUT (x);
+                    MPC_OUT (y);
+                    MPC_OUT (z);
+                    MPC_OUT (t);
+                    fprintf (stderr, "inex_z=%d inex_t=%d\n", inex_z,
+                             inex_t);
+                    exit (1);
+                  }
+              }
+            /* in-place computation */
+            mpc_mul (t, x, y, MPC_RNDZU);
+            mpc_mul_precomp (x, x, pc, MPC_RNDZU);
+            if (!same_mpc_value (x, t, ks))
+              {
+                fprintf (stderr, "mpc_mul_precomp with overlap and mpc_mul"
+                         " differ\n");
+                MPC_OUT (x);
+                MPC_OUT (y);
+                MPC_OUT (t);
+                exit (1);
+              }
+          }
+        mpc_mul_precomp_clear (pc);
+      }
+
+  mpc_clear (x);
+  mpc_clear (y);
+  mpc_clear (z);
+  mpc_clear (t);
+}
+
+
+static void
+check_threshold (void)
+{
+  /* checks that mpc_mul gives the same results whichever algorithm is
+     selected by mpc_set_mul_threshold, and that the thresholds are
+     restored */
+  mpc_t x, y, z, t;
+  mpfr_prec_t prec, karatsuba, gauss, k, g;
+  int i;
+  known_signs_t ks = {1, 1};
+
+  mpc_get_mul_threshold (&karatsuba, &gauss);
+
+  mpc_init2 (x, 2);
+  mpc_init2 (y, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (t, 2);
+  for (prec = 2; prec < 2000; prec = (mpfr_prec_t) (prec * 1.4 + 1))
+    {
+      mpc_set_prec (x, prec);
+      mpc_set_prec (y, prec);
+      mpc_set_prec (z, prec);
+      mpc_set_prec (t, prec);
+      test_default_random (x, -1024, 1024, 128, 0);
+      test_default_random (y, -1024, 1024, 128, 0);
+      mpc_set_mul_threshold (MPFR_PREC_MAX, MPFR_PREC_MAX);
+      mpc_mul (t, x, y, MPC_RNDZN);
+      for (i = 0; i < 2; i++)
+        {
+          mpc_set_mul_threshold (i == 0 ? 0 : MPFR_PREC_MAX,
+                                 i == 0 ? MPFR_PREC_MAX : 0);
+          mpc_mul (z, x, y, MPC_RNDZN);
+          if (!same_mpc_value (z, t, ks))
+            {
+              fprintf (stderr, "mpc_mul differs with %s multiplication\n",
+                       i == 0 ? "Karatsuba" : "Gauss");
+              MPC_OUT (x);
+              MPC_OUT (y);
+              MPC_OUT (z);
+              MPC_OUT (t);
+              exit (1);
+            }
+        }
+    }
+  mpc_clear (x);
+  mpc_clear (y);
+  mpc_clear (z);
+  mpc_clear (t);
+
+  mpc_set_mul_threshold (karatsuba, gauss);
+  mpc_get_mul_threshold (&k, &g);
+  if (k != karatsuba || g != gauss)
+    {
+      fprintf (stderr, "mpc_set_mul_threshold does not restore the "
+               "thresholds\n");
+      exit (1);
     }
+}
 
+
+static void
+check_zero_sign (void)
+{
+  /* checks that exact zero parts of (1+i)*(1-i) and (1+i)^2 get the same
+     sign with the naive and Gauss multiplications for all rounding modes;
+     cmpmul cannot see this since mpc_cmp does not distinguish +0 and -0 */
+  mpc_t x, y, z, t;
+  mpfr_prec_t prec;
+  int i, rnd_re, rnd_im, inex_z, inex_t;
+  mpc_rnd_t rnd;
+  known_signs_t ks = {1, 1};
+
+  mpc_init2 (x, 2);
+  mpc_init2 (y, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (t, 2);
+  for (prec = 1100; prec <= 3000; prec += 950)
+    for (i = 0; i < 2; i++)
+      {
+        mpc_set_prec (x, prec);
+        mpc_set_prec (y, prec);
+        mpc_set_prec (z, prec);
+        mpc_set_prec (t, prec);
+        mpc_set_si_si (x, 1, 1, MPC_RNDNN);
+        mpc_set_si_si (y, 1, i == 0 ? -1 : 1, MPC_RNDNN);
+        for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+          for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+            {
+              rnd = MPC_RND (rnd_re, rnd_im);
+              inex_z = mpc_mul_naive (z, x, y, rnd);
+              inex_t = (i == 0 ? mpc_mul_gauss (t, x, y, rnd)
+                        : mpc_mul_gauss (t, x, x, rnd));
+              if (!same_mpc_value (t, z, ks) || inex_t != inex_z)
+                {
+                  fprintf (stderr, "mul_naive and mul_gauss differ in the "
+                           "sign of zero for rnd=(%s,%s)\n",
+                           mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                           mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                  MPC_OUT (x);
+                  MPC_OUT (y);
+                  MPC_OUT (z);
+                  MPC_OUT (t);
+                  exit (1);
+                }
+            }
+      }
   mpc_clear (x);
   mpc_clear (y);
+  mpc_clear (z);
+  mpc_clear (t);
 }
 
 
@@ -192,6 +505,10 @@ main (void)
 #endif
 
   check_regular ();
+  check_vec ();
+  check_precomp ();
+  check_threshold ();
+  check_zero_sign ();
 
   data_check (f, "mul.dat");
   tgeneric (f, 2, 4096, 41, 100);
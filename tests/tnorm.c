@@ -93,6 +93,81 @@ test_underflow (void)
   mpfr_set_emin (emin);
 }
 
+/* compares mpc_norm with the exact sum of the exact squares rounded once,
+   for random operands with parts of close and of very different
+   exponents, and for an exponent range in which the squares or the norm
+   over- or underflow */
+static void
+test_random (void)
+{
+  mpfr_exp_t emin = mpfr_get_emin ();
+  mpfr_exp_t emax = mpfr_get_emax ();
+  mpc_t z;
+  mpfr_t f, g, u, v;
+  mpfr_prec_t prec;
+  int i, r, inex, inex_ref;
+
+  mpc_init2 (z, 2);
+  mpfr_init2 (f, 2);
+  mpfr_init2 (g, 2);
+  mpfr_init2 (u, 2);
+  mpfr_init2 (v, 2);
+
+  for (prec = 2; prec < 1000; prec = (mpfr_prec_t) (prec * 1.3 + 1))
+    for (i = 0; i < 4; i++)
+      {
+        mpc_set_prec (z, prec);
+        mpfr_set_prec (f, prec + 5 * i);
+        mpfr_set_prec (g, prec + 5 * i);
+        mpfr_set_prec (u, 2 * prec);
+        mpfr_set_prec (v, 2 * prec);
+        test_default_random (z, -100, 100, 128, 0);
+        if (i == 1)
+          mpfr_div_2ui (mpc_imagref (z), mpc_imagref (z), 1000, MPFR_RNDN);
+        else if (i >= 2)
+          /* squares of exponent about 2000 or -2000 */
+          mpc_mul_2si (z, z, (i == 2 ? 1000 : -1000), MPC_RNDNN);
+        mpfr_sqr (u, mpc_realref (z), MPFR_RNDN); /* exact */
+        mpfr_sqr (v, mpc_imagref (z), MPFR_RNDN); /* exact */
+        for (r = 0; r < 4; r++)
+          {
+            inex_ref = mpfr_add (g, u, v, (mpfr_rnd_t) r);
+            if (i >= 2)
+              {
+                /* the norm itself over- or underflows */
+                if (i == 2)
+                  mpfr_set_emax (1500);
+                else
+                  mpfr_set_emin (-1500);
+                inex_ref = mpfr_check_range (g, inex_ref, (mpfr_rnd_t) r);
+              }
+            inex = mpc_norm (f, z, (mpfr_rnd_t) r);
+            mpfr_set_emin (emin);
+            mpfr_set_emax (emax);
+            if (mpfr_cmp (f, g) != 0
+                || (inex > 0) != (inex_ref > 0)
+                || (inex < 0) != (inex_ref < 0))
+              {
+                printf ("Error in mpc_norm for rnd=%s\n",
+                        mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+                MPC_OUT (z);
+                printf ("got      ");
+                mpfr_dump (f);
+                printf ("expected ");
+                mpfr_dump (g);
+                printf ("inex = %d, expected %d\n", inex, inex_ref);
+                exit (1);
+              }
+          }
+      }
+
+  mpc_clear (z);
+  mpfr_clear (f);
+  mpfr_clear (g);
+  mpfr_clear (u);
+  mpfr_clear (v);
+}
+
 int
 main (void)
 {
@@ -103,6 +178,7 @@ main (void)
   data_check (f, "norm.dat");
   tgeneric (f, 2, 1024, 1, 4096);
   test_underflow ();
+  test_random ();
 
   test_end ();
 
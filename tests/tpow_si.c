@@ -43,6 +43,10 @@ compare_mpc_pow (mpfr_prec_t pmax, int iter, unsigned long nbits)
         mpc_set_si (y, n, MPC_RNDNN);
         for (rnd = 0; rnd < 16; rnd ++)
           {
+#ifdef MPC_RNDFF
+            if (MPC_RND_RE (rnd) == MPFR_RNDF)
+              continue; /* faithful roundings need not agree */
+#endif
             inex_pow = mpc_pow (z, x, y, rnd);
             inex_pow_si = mpc_pow_si (t, x, n, rnd);
             if (mpc_cmp (z, t) != 0)
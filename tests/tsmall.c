@@ -0,0 +1,207 @@
+/* tsmall -- test file for the exact products of small operands.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+/* mpc_mul, mpc_sqr and mpc_fma compute the exact real products without
+   allocation when the operands have at most two limbs. The results are
+   compared to the ones of the general algorithms, obtained with the same
+   operands stored with a precision of three limbs. */
+
+#define MUL 0
+#define SQR 1
+#define FMA 2
+
+#define BIG_PREC (3 * GMP_NUMB_BITS)
+
+static const char *names [] = {"mpc_mul", "mpc_sqr", "mpc_fma"};
+
+static int
+call (int op, mpc_ptr z, mpc_srcptr x, mpc_srcptr y, mpc_srcptr w,
+      mpc_rnd_t rnd)
+{
+   switch (op) {
+   case MUL:
+      return mpc_mul (z, x, y, rnd);
+   case SQR:
+      return mpc_sqr (z, x, rnd);
+   default:
+      return mpc_fma (z, x, y, w, rnd);
+   }
+}
+
+/* checks op for the operands x, y, w and a result of precision prec in
+   all rounding modes */
+static void
+check (int op, mpc_srcptr x, mpc_srcptr y, mpc_srcptr w, mpfr_prec_t prec)
+{
+   const mpfr_rnd_t r [] = {MPFR_RNDN, MPFR_RNDZ, MPFR_RNDU, MPFR_RNDD};
+   known_signs_t ks = {1, 1};
+   mpc_t xb, yb, wb, z, zb;
+   mpc_rnd_t rnd;
+   int i, j, inex, inexb;
+
+   mpc_init2 (xb, BIG_PREC);
+   mpc_init2 (yb, BIG_PREC);
+   mpc_init2 (wb, BIG_PREC);
+   mpc_init2 (z, prec);
+   mpc_init2 (zb, prec);
+   mpc_set (xb, x, MPC_RNDNN);
+   mpc_set (yb, y, MPC_RNDNN);
+   mpc_set (wb, w, MPC_RNDNN);
+
+   for (i = 0; i < 4; i++)
+      for (j = 0; j < 4; j++) {
+         rnd = MPC_RND (r [i], r [j]);
+         inex = call (op, z, x, y, w, rnd);
+         inexb = call (op, zb, xb, yb, wb, rnd);
+         if (inex != inexb || !same_mpc_value (z, zb, ks)) {
+            printf ("Error in %s for rounding mode (%s,%s)\n", names [op],
+                    mpfr_print_rnd_mode (r [i]), mpfr_print_rnd_mode (r [j]));
+            MPC_OUT (x);
+            if (op != SQR)
+               MPC_OUT (y);
+            if (op == FMA)
+               MPC_OUT (w);
+            printf ("got      ");
+            MPC_OUT (z);
+            printf ("expected ");
+            MPC_OUT (zb);
+            printf ("ternary values %i and %i\n", inex, inexb);
+            exit (1);
+         }
+      }
+
+   mpc_clear (xb);
+   mpc_clear (yb);
+   mpc_clear (wb);
+   mpc_clear (z);
+   mpc_clear (zb);
+}
+
+static void
+check_random (void)
+{
+   mpc_t x, y, w;
+   mpfr_prec_t prec;
+   int i, op;
+
+   mpc_init2 (x, 2);
+   mpc_init2 (y, 2);
+   mpc_init2 (w, 2);
+
+   for (i = 0; i < 1000; i++) {
+      prec = 54 + (mpfr_prec_t) gmp_urandomm_ui (rands, 2 * GMP_NUMB_BITS - 53);
+      mpfr_set_prec (mpc_realref (x), prec);
+      mpfr_set_prec (mpc_imagref (y), prec);
+      prec = 2 + (mpfr_prec_t) gmp_urandomm_ui (rands, 2 * GMP_NUMB_BITS - 1);
+      mpfr_set_prec (mpc_imagref (x), prec);
+      mpfr_set_prec (mpc_realref (y), prec);
+      mpc_set_prec (w, (i % 2 == 0 ? GMP_NUMB_BITS : 2 * GMP_NUMB_BITS));
+      test_default_random (x, -100, 100, 128, 25);
+      test_default_random (y, -100, 100, 128, 25);
+      test_default_random (w, -100, 100, 128, 25);
+      prec = (i % 3 == 0 ? 2 * GMP_NUMB_BITS : 54 + i % GMP_NUMB_BITS);
+      for (op = MUL; op <= FMA; op++)
+         check (op, x, y, w, prec);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+}
+
+static void
+check_cancellation (void)
+{
+   /* the real products cancel in the real part of x*y and of x^2 */
+   mpc_t x, y, w;
+   int i;
+
+   mpc_init2 (x, 2 * GMP_NUMB_BITS);
+   mpc_init2 (y, 2 * GMP_NUMB_BITS);
+   mpc_init2 (w, 2 * GMP_NUMB_BITS);
+
+   for (i = 0; i < 200; i++) {
+      test_default_random (x, -10, 10, 128, 0);
+      mpc_conj (y, x, MPC_RNDNN);
+      mpc_mul_i (y, y, 1, MPC_RNDNN);
+      mpfr_nextabove (mpc_realref (y));
+      test_default_random (w, -300, -200, 128, 0);
+      check (MUL, x, y, w, GMP_NUMB_BITS);
+      check (FMA, x, y, w, GMP_NUMB_BITS);
+      mpfr_set (mpc_imagref (x), mpc_realref (x), MPFR_RNDN);
+      mpfr_nextbelow (mpc_imagref (x));
+      check (SQR, x, y, w, GMP_NUMB_BITS);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+}
+
+static void
+check_range (void)
+{
+   /* products near the largest exponent; mpc_fma is not tested since the
+      general algorithm does not round overflows correctly */
+   mpfr_exp_t emin, emax;
+   mpc_t x, y, w;
+   int i;
+
+   emin = mpfr_get_emin ();
+   emax = mpfr_get_emax ();
+   mpfr_set_emin (-200);
+   mpfr_set_emax (200);
+
+   mpc_init2 (x, GMP_NUMB_BITS);
+   mpc_init2 (y, 2 * GMP_NUMB_BITS);
+   mpc_init2 (w, GMP_NUMB_BITS);
+
+   for (i = 0; i < 200; i++) {
+      test_default_random (x, 60, 120, 128, 0);
+      test_default_random (y, 60, 120, 128, 0);
+      test_default_random (w, -200, 200, 128, 0);
+      check (MUL, x, y, w, GMP_NUMB_BITS);
+      check (SQR, x, y, w, GMP_NUMB_BITS);
+   }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (w);
+
+   mpfr_set_emin (emin);
+   mpfr_set_emax (emax);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_cancellation ();
+   check_random ();
+   check_range ();
+
+   test_end ();
+
+   return 0;
+}
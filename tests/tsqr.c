@@ -164,6 +164,58 @@ reuse_bug (void)
   mpc_clear (z1);
 }
 
+
+static void
+check_zero_sign (void)
+{
+  /* Re ((a+i*b)^2) with |a| = |b| is an exact +0 for all rounding modes,
+     whether mpc_sqr takes its path for small operands or the Karatsuba
+     loop; mpc_cmp in cmpsqr does not see the sign of zero */
+  mpc_t x, z, t;
+  mpfr_prec_t prec;
+  long a, b;
+  int rnd_re, rnd_im, inex;
+  mpc_rnd_t rnd;
+  known_signs_t ks = {1, 1};
+
+  mpc_init2 (x, 2);
+  mpc_init2 (z, 2);
+  mpc_init2 (t, 2);
+  for (prec = 2; prec <= 300; prec += 7)
+    for (a = -1; a <= 1; a += 2)
+      for (b = -1; b <= 1; b += 2)
+        {
+          mpc_set_prec (x, prec);
+          mpc_set_prec (z, prec);
+          mpc_set_prec (t, prec);
+          mpc_set_si_si (x, a, b, MPC_RNDNN);
+          mpc_set_si_si (t, 0, 2 * a * b, MPC_RNDNN);
+          for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+            for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+              {
+                rnd = MPC_RND (rnd_re, rnd_im);
+                inex = mpc_sqr (z, x, rnd);
+                if (!same_mpc_value (z, t, ks) || inex != 0)
+                  {
+                    printf ("Error: wrong sign of zero in mpc_sqr for "
+                            "rnd=(%s,%s)\n",
+                            mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+                            mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+                    MPC_OUT (x);
+                    printf ("got      ");
+                    MPC_OUT (z);
+                    printf ("expected ");
+                    MPC_OUT (t);
+                    printf ("inex = %s\n", MPC_INEX_STR (inex));
+                    exit (1);
+                  }
+              }
+        }
+  mpc_clear (x);
+  mpc_clear (z);
+  mpc_clear (t);
+}
+
 int
 main (void)
 {
@@ -184,6 +236,7 @@ main (void)
   tgeneric (f, 2, 1024, 1, 0);
 
   reuse_bug ();
+  check_zero_sign ();
 
   test_end ();
 
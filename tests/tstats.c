@@ -0,0 +1,111 @@
+/* tstats -- test file for mpc_stats_get and mpc_stats_reset.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+static void
+check_zero (mpc_stats_t s, const char *name)
+{
+   if (s->calls != 0 || s->loops != 0 || s->fallbacks != 0
+       || s->max_prec != 0) {
+      printf ("Error in mpc_stats_get for %s: non-zero counters\n", name);
+      exit (1);
+   }
+}
+
+static void
+check_unknown (void)
+{
+   mpc_stats_t s;
+
+   s->calls = 17;
+   if (mpc_stats_get (s, "no_such_function") != -1) {
+      printf ("Error in mpc_stats_get: unknown function accepted\n");
+      exit (1);
+   }
+   check_zero (s, "no_such_function");
+}
+
+static void
+check_counters (void)
+{
+   mpc_t x, y, z;
+   mpc_stats_t s;
+   mpfr_prec_t prec = 2000;
+   int i;
+
+   mpc_init2 (x, prec);
+   mpc_init2 (y, prec);
+   mpc_init2 (z, prec);
+
+   mpc_stats_reset ();
+   if (mpc_stats_get (s, "mul") != 0) {
+      /* statistics are disabled */
+      check_zero (s, "mul");
+      mpc_clear (x);
+      mpc_clear (y);
+      mpc_clear (z);
+      return;
+   }
+   check_zero (s, "mul");
+
+   for (i = 0; i < 10; i++) {
+      test_default_random (x, -20, 20, 128, 0);
+      test_default_random (y, -20, 20, 128, 0);
+      mpc_mul (z, x, y, MPC_RNDNN);
+      mpc_exp (z, x, MPC_RNDNN);
+   }
+
+   mpc_stats_get (s, "mul");
+   if (s->calls < 10 || s->fallbacks > s->calls) {
+      printf ("Error in mpc_stats_get for mul: %lu calls, %lu fallbacks\n",
+              s->calls, s->fallbacks);
+      exit (1);
+   }
+   mpc_stats_get (s, "exp");
+   if (s->calls != 10 || s->loops < 10 || s->max_prec <= prec) {
+      printf ("Error in mpc_stats_get for exp: %lu calls, %lu loops, "
+              "maximal precision %lu\n", s->calls, s->loops,
+              (unsigned long) s->max_prec);
+      exit (1);
+   }
+
+   mpc_stats_reset ();
+   mpc_stats_get (s, "exp");
+   check_zero (s, "exp");
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (z);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_unknown ();
+   check_counters ();
+
+   test_end ();
+
+   return 0;
+}
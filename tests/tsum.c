@@ -0,0 +1,153 @@
+/* tsum -- test file for mpc_sum.
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+#include <stdlib.h>
+#include "mpc-tests.h"
+
+#define N 17
+#define EXACT_PREC 2000
+   /* large enough for the exact sum of N terms of precision at most 500
+      and exponents between -50 and 50 */
+
+/* compares mpc_sum (z, x, n, rnd) with the exact sum rounded once */
+static void
+check_sum (mpc_ptr z, mpc_ptr *x, size_t n, mpc_rnd_t rnd)
+{
+   mpc_t s, ref;
+   size_t i;
+   int inex, inex_ref;
+   /* the sign of an exact zero is not specified */
+   known_signs_t ks = {0, 0};
+
+   mpc_init2 (s, EXACT_PREC);
+   mpc_init2 (ref, MPC_MAX_PREC (z));
+   mpc_set_ui (s, 0, MPC_RNDNN);
+   for (i = 0; i < n; i++)
+      if (mpc_add (s, s, x [i], MPC_RNDNN) != 0) {
+         printf ("Error in check_sum: inexact reference sum\n");
+         exit (1);
+      }
+   inex_ref = mpc_set (ref, s, rnd);
+
+   inex = mpc_sum (z, x, n, rnd);
+   if (!same_mpc_value (z, ref, ks) || inex != inex_ref) {
+      printf ("Error in mpc_sum for n=%lu and rnd=(%s,%s)\n",
+              (unsigned long) n,
+              mpfr_print_rnd_mode (MPC_RND_RE (rnd)),
+              mpfr_print_rnd_mode (MPC_RND_IM (rnd)));
+      for (i = 0; i < n; i++)
+         MPC_OUT (x [i]);
+      printf ("got      ");
+      MPC_OUT (z);
+      printf ("expected ");
+      MPC_OUT (ref);
+      printf ("inex = %s, expected %s\n", MPC_INEX_STR (inex),
+              MPC_INEX_STR (inex_ref));
+      exit (1);
+   }
+
+   mpc_clear (s);
+   mpc_clear (ref);
+}
+
+static void
+check_random (void)
+{
+   mpc_t t [N], z;
+   mpc_ptr x [N];
+   mpfr_prec_t prec;
+   size_t n;
+   int i, rnd_re, rnd_im;
+
+   for (i = 0; i < N; i++) {
+      mpc_init2 (t [i], 2);
+      x [i] = t [i];
+   }
+   mpc_init2 (z, 2);
+
+   for (prec = 2; prec < 500; prec = (mpfr_prec_t) (prec * 1.5 + 1))
+      for (n = 0; n <= N; n += 4) {
+         for (i = 0; i < (int) n; i++) {
+            mpc_set_prec (t [i], prec);
+            test_default_random (t [i], -50, 50, 128, 0);
+         }
+         /* cancellation of the leading terms */
+         if (n >= 4) {
+            mpc_neg (t [1], t [0], MPC_RNDNN);
+            mpfr_neg (mpc_imagref (t [3]), mpc_imagref (t [2]), MPFR_RNDN);
+         }
+         mpc_set_prec (z, prec);
+         for (rnd_re = 0; rnd_re < 4; rnd_re ++)
+            for (rnd_im = 0; rnd_im < 4; rnd_im ++)
+               check_sum (z, x, n, MPC_RND (rnd_re, rnd_im));
+      }
+
+   for (i = 0; i < N; i++)
+      mpc_clear (t [i]);
+   mpc_clear (z);
+}
+
+static void
+check_overlap (void)
+{
+   /* the result may be one of the terms */
+   mpc_t t [3], z;
+   mpc_ptr x [3];
+   int i;
+
+   for (i = 0; i < 3; i++) {
+      mpc_init2 (t [i], 53);
+      x [i] = t [i];
+   }
+   mpc_init2 (z, 53);
+
+   mpc_set_si_si (t [0], 1, -3, MPC_RNDNN);
+   mpc_set_ui_ui (t [1], 1, 1, MPC_RNDNN);
+   mpc_div_2ui (t [1], t [1], 60, MPC_RNDNN);
+   mpc_set_si_si (t [2], -1, 3, MPC_RNDNN);
+   mpc_sum (z, x, 3, MPC_RNDNN);
+   mpc_sum (t [1], x, 3, MPC_RNDNN);
+   if (mpc_cmp (z, t [1]) != 0 || mpfr_cmp_ui_2exp (mpc_realref (z), 1, -60)
+       != 0) {
+      printf ("Error in mpc_sum with the result as operand\n");
+      printf ("got      ");
+      MPC_OUT (t [1]);
+      printf ("expected ");
+      MPC_OUT (z);
+      exit (1);
+   }
+
+   for (i = 0; i < 3; i++)
+      mpc_clear (t [i]);
+   mpc_clear (z);
+}
+
+int
+main (void)
+{
+   test_start ();
+
+   check_overlap ();
+   check_random ();
+
+   test_end ();
+
+   return 0;
+}
@@ -0,0 +1,55 @@
+/* mpcconst -- write a file of precomputed constants for mpc_cache_load
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* Computes pi, log(2) and log(10) with at least the precision given as
+   first argument and writes them with mpc_cache_save into the file given
+   as second argument. A program calling mpc_cache_load with this file
+   then obtains these constants at any smaller precision without computing
+   them. The file may only be used on machines of the same kind, with the
+   same size of limbs of GMP.                                           */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mpc.h"
+
+int
+main (int argc, char *argv[])
+{
+   long prec;
+   clock_t start;
+
+   prec = (argc == 3 ? atol (argv[1]) : 0);
+   if (prec < MPFR_PREC_MIN || prec > MPFR_PREC_MAX) {
+      fprintf (stderr, "Usage: mpcconst precision file\n");
+      return 1;
+   }
+
+   start = clock ();
+   if (mpc_cache_save (argv[2], (mpfr_prec_t) prec) != 0) {
+      fprintf (stderr, "mpcconst: cannot write %s\n", argv[2]);
+      return 1;
+   }
+   fprintf (stderr, "Constants with %ld bits written to %s in %.3fs\n",
+            prec, argv[2], (double) (clock () - start) / CLOCKS_PER_SEC);
+   mpc_free_cache ();
+
+   return 0;
+}
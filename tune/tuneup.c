@@ -0,0 +1,248 @@
+/* tuneup -- determine the thresholds for the multiplication algorithms
+
+Copyright (C) 2012 INRIA
+
+This file is part of GNU MPC.
+
+GNU MPC is free software; you can redistribute it and/or modify it under
+the terms of the GNU Lesser General Public License as published by the
+Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+GNU MPC is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see http://www.gnu.org/licenses/ .
+*/
+
+/* Measures mpc_mul_naive, mpc_mul_karatsuba and mpc_mul_gauss for
+   precisions of 1 up to MAX_LIMBS limbs (the optional argument) and
+   prints definitions of MUL_KARATSUBA_THRESHOLD and MUL_GAUSS_THRESHOLD
+   to stdout, in the format of src/mpc-tuned.h; progress is reported on
+   stderr. For each precision, the timings are summed over random
+   operands whose real and imaginary parts have exponents differing by 0,
+   1/8 and 1/4 of the precision, since mpc_mul uses the naive algorithm
+   anyway for larger spreads. Then measures mpc_log with and without the
+   AGM for precisions of LOG_MIN_LIMBS up to LOG_MAX_LIMBS limbs, doubling
+   each time, and prints LOG_AGM_THRESHOLD if the AGM is faster from some
+   precision on.                                                        */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mpc-impl.h"
+
+#define MAX_LIMBS 100
+#define SAMPLES 6    /* number of random operand pairs per spread */
+#define MIN_TIME 0.002 /* minimal measuring time for one operand pair */
+#define LOG_MIN_LIMBS 16
+#define LOG_MAX_LIMBS 16384
+
+typedef int (*mul_func_t) (mpc_ptr, mpc_srcptr, mpc_srcptr, mpc_rnd_t);
+
+static gmp_randstate_t state;
+
+
+/* returns the time in seconds of one call of f (z, x, y) */
+static double
+time_one (mul_func_t f, mpc_ptr z, mpc_srcptr x, mpc_srcptr y)
+{
+   clock_t start, elapsed;
+   long n, i;
+
+   n = 1;
+   for (;;) {
+      start = clock ();
+      for (i = 0; i < n; i++)
+         f (z, x, y, MPC_RNDNN);
+      elapsed = clock () - start;
+      if ((double) elapsed / CLOCKS_PER_SEC >= MIN_TIME)
+         return (double) elapsed / CLOCKS_PER_SEC / n;
+      n *= 2;
+   }
+}
+
+
+/* sets x to a random number of exponent between -1 and 0 whose
+   imaginary part has an exponent by spread lower than the real part */
+static void
+random_spread (mpc_ptr x, mpfr_exp_t spread)
+{
+   do
+      mpc_urandom (x, state);
+   while (mpfr_zero_p (mpc_realref (x)) || mpfr_zero_p (mpc_imagref (x)));
+   mpfr_set_exp (mpc_realref (x), 0);
+   mpfr_set_exp (mpc_imagref (x), -spread);
+   if (gmp_urandomb_ui (state, 1))
+      mpfr_neg (mpc_realref (x), mpc_realref (x), MPFR_RNDN);
+   if (gmp_urandomb_ui (state, 1))
+      mpfr_neg (mpc_imagref (x), mpc_imagref (x), MPFR_RNDN);
+}
+
+
+/* stores in t[0], t[1], t[2] the times of mpc_mul_naive,
+   mpc_mul_karatsuba and mpc_mul_gauss at n limbs */
+static void
+time_mul (double t[3], int n)
+{
+   static const mul_func_t f[3] =
+      {mpc_mul_naive, mpc_mul_karatsuba, mpc_mul_gauss};
+   mpc_t x, y, z;
+   mpfr_prec_t prec;
+   int i, j, k;
+
+   prec = (mpfr_prec_t) n * BITS_PER_MP_LIMB;
+   mpc_init2 (x, prec);
+   mpc_init2 (y, prec);
+   mpc_init2 (z, prec);
+   t[0] = t[1] = t[2] = 0;
+
+   for (i = 0; i <= 2; i++)
+      for (j = 0; j < SAMPLES; j++) {
+         random_spread (x, (i == 0 ? 0 : prec >> (4 - i)));
+         random_spread (y, (i == 0 ? 0 : prec >> (4 - i)));
+         for (k = 0; k < 3; k++)
+            t[k] += time_one (f[k], z, x, y);
+      }
+
+   mpc_clear (x);
+   mpc_clear (y);
+   mpc_clear (z);
+}
+
+
+/* returns the smallest number of limbs n = LOG_MIN_LIMBS * 2^k at most
+   LOG_MAX_LIMBS from which mpc_log_by_agm is faster than mpc_log without the
+   AGM, or 0 if there is none */
+static int
+time_log (void)
+{
+   mpc_t x, z;
+   mpfr_prec_t prec;
+   clock_t start;
+   double t[2];
+   int n, k, T, calls;
+
+   mpc_init2 (x, 2);
+   mpc_init2 (z, 2);
+   T = 0;
+   for (n = LOG_MIN_LIMBS; n <= LOG_MAX_LIMBS; n *= 2) {
+      prec = (mpfr_prec_t) n * BITS_PER_MP_LIMB;
+      mpc_set_prec (x, prec);
+      mpc_set_prec (z, prec);
+      random_spread (x, 0);
+      /* fill the cache of constants */
+      mpc_log_by_agm (z, x, MPC_RNDNN);
+      for (k = 0; k < 2; k++) {
+         mpc_set_log_agm_threshold (k == 0 ? MPFR_PREC_MAX : 0);
+         calls = 0;
+         start = clock ();
+         do {
+            mpc_log (z, x, MPC_RNDNN);
+            calls++;
+         } while ((double) (clock () - start) / CLOCKS_PER_SEC < MIN_TIME);
+         t[k] = (double) (clock () - start) / CLOCKS_PER_SEC / calls;
+      }
+      fprintf (stderr, "%5i limbs: log %.3e log_agm %.3e\n", n, t[0], t[1]);
+      if (t[1] >= t[0])
+         T = 0;
+      else if (T == 0)
+         T = n;
+   }
+   mpc_set_log_agm_threshold ((mpfr_prec_t) LOG_AGM_THRESHOLD
+                              * BITS_PER_MP_LIMB);
+
+   mpc_clear (x);
+   mpc_clear (z);
+   return T;
+}
+
+
+/* returns the threshold T in [0, max] for which the slow algorithm, with
+   timings slow[n], is used for n <= T and the fast one, with timings
+   fast[n], for n > T, with the minimal total time over n=1..max */
+static int
+threshold (const double *slow, const double *fast, int max)
+{
+   double total, best;
+   int n, T, best_T;
+
+   total = 0;
+   for (n = 1; n <= max; n++)
+      total += fast[n];
+   best = total;
+   best_T = 0;
+   for (T = 1; T <= max; T++) {
+      /* now the slow algorithm is also used for n = T */
+      total += slow[T] - fast[T];
+      if (total < best) {
+         best = total;
+         best_T = T;
+      }
+   }
+   return best_T;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+   double t[3], *naive, *karatsuba, *gauss, *best;
+   int max, n, karatsuba_threshold, gauss_threshold, log_threshold;
+
+   max = (argc > 1 ? atoi (argv[1]) : MAX_LIMBS);
+   if (max < 2) {
+      fprintf (stderr, "Usage: tuneup [max_limbs]\n");
+      return 1;
+   }
+
+   gmp_randinit_default (state);
+   naive = (double *) malloc ((max + 1) * sizeof (double));
+   karatsuba = (double *) malloc ((max + 1) * sizeof (double));
+   gauss = (double *) malloc ((max + 1) * sizeof (double));
+   best = (double *) malloc ((max + 1) * sizeof (double));
+   if (naive == NULL || karatsuba == NULL || gauss == NULL || best == NULL) {
+      fprintf (stderr, "tuneup: not enough memory\n");
+      return 1;
+   }
+
+   for (n = 1; n <= max; n++) {
+      time_mul (t, n);
+      naive [n] = t [0];
+      karatsuba [n] = t [1];
+      gauss [n] = t [2];
+      fprintf (stderr, "%4i limbs: naive %.3e karatsuba %.3e gauss %.3e\n",
+               n, t [0], t [1], t [2]);
+   }
+
+   karatsuba_threshold = threshold (naive, karatsuba, max);
+   for (n = 1; n <= max; n++)
+      best [n] = (n <= karatsuba_threshold ? naive [n] : karatsuba [n]);
+   gauss_threshold = threshold (best, gauss, max);
+   log_threshold = time_log ();
+
+   printf ("/* mpc-tuned.h -- generated by tuneup from GNU MPC %s\n",
+           mpc_get_version ());
+   printf ("   with GMP %s and MPFR %s */\n", gmp_version,
+           mpfr_get_version ());
+   printf ("#define MUL_KARATSUBA_THRESHOLD %i\n", karatsuba_threshold);
+   printf ("#define MUL_GAUSS_THRESHOLD %i\n", gauss_threshold);
+   if (log_threshold != 0)
+      printf ("#define LOG_AGM_THRESHOLD %i\n", log_threshold);
+   else
+      printf ("/* mpc_log without the AGM is faster up to %i limbs */\n",
+              LOG_MAX_LIMBS);
+
+   free (naive);
+   free (karatsuba);
+   free (gauss);
+   free (best);
+   gmp_randclear (state);
+   mpc_free_scratch ();
+   mpc_free_cache ();
+
+   return 0;
+}